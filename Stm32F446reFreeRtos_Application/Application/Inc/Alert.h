@@ -0,0 +1,112 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Alert.h
+  * @brief          : Header for Alert.c file.
+  *                   Store-and-forward SMS/GPRS alerts for the LM35 faults.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *
+  * History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  * 	17-10-2026	-	Send results wake the task, no poll while a batch waits
+  *
+  *
+  *
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+#ifndef INC_ALERT_H_
+#define INC_ALERT_H_
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "App.h"
+
+/******************************************************************************
+*							MACRO DEFINITION
+******************************************************************************/
+#define ALERT_TASK_STACK        384     // snprintf of the alert text
+#define ALERT_TASK_PRIORITY     1
+
+// Faults that raise an alert, both edges are reported
+#define ALERT_FAULTS            (HEALTH_OVER_TEMPERATURE | HEALTH_SENSOR_DISCONNECTED | HEALTH_ADC_TIMEOUT)
+
+// Coalescing window, opened by the first fault change of a batch
+#define ALERT_WINDOW_DEFAULT_S  60
+#define ALERT_WINDOW_MIN_S      5
+#define ALERT_WINDOW_MAX_S      3600
+
+// Failed deliveries are retried, the wait doubles up to the maximum
+#define ALERT_RETRY_MIN_MS      30000
+#define ALERT_RETRY_MAX_MS      (30UL * 60UL * 1000UL)
+#define ALERT_PEAK_MS           1000    // Peak temperature sampling while over temperature is active
+#define ALERT_POLL_MS           1000    // Fault poll, only when no health observer is left
+
+#define ALERT_TEXT_MAX          160     // One SMS in GSM 7-bit text mode
+
+// Destination, set per installation
+#define ALERT_SMS_NUMBER        "+10000000000"
+#define ALERT_GPRS_APN          "internet"
+#define ALERT_GPRS_HOST         "203.0.113.10"
+#define ALERT_GPRS_PORT         "5000"
+#define ALERT_CONNECT_TIMEOUT_MS 20000  // AT+CIPSTART OK to "CONNECT OK"
+
+/******************************************************************************
+*							DATA TYPE DECLARATION
+******************************************************************************/
+typedef enum
+{
+    ALERT_CHANNEL_SMS = 0,      // AT+CMGS to ALERT_SMS_NUMBER
+    ALERT_CHANNEL_GPRS,         // One TCP payload to ALERT_GPRS_HOST
+    ALERT_CHANNEL_COUNT
+} AlertChannel_t;
+
+/* Run time settings, the next batch uses them */
+typedef struct
+{
+    uint16_t window_s;
+    uint8_t channel;            // AlertChannel_t
+} AlertConfig_t;
+
+typedef struct
+{
+    uint32_t events;            // Fault changes seen
+    uint32_t batches;           // Alert texts built from them
+    uint32_t delivered;
+    uint32_t attempts;          // Delivery attempts, retries included
+    uint32_t failures;          // Attempts that failed (modem resets not counted)
+    uint32_t pending;           // Batches not delivered yet, 0..2
+    uint32_t max_delivery_ms;   // First event of a batch to its delivery
+} AlertStats_t;
+
+/******************************************************************************
+*							API DECLARATIONS
+******************************************************************************/
+
+// Alert task: watches the health bits, batches the changes, forwards them
+void Alert_Handler(void *params);
+
+// Run time settings, false (nothing changed) if a field is out of range
+bool Alert_SetConfig(const AlertConfig_t *config);
+void Alert_GetConfig(AlertConfig_t *config);
+
+// Copy of the counters
+void Alert_GetStats(AlertStats_t *stats);
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
+
+#endif /* INC_ALERT_H_ */
@@ -17,6 +17,8 @@
   *
   * History: v01
   * 	17-07-2025	-	v01	- Initial version
+  * 	17-10-2026	-	APP_STACK placement for statically allocated stacks
+  * 	17-10-2026	-	APP_TASK_COUNT, size of the App task table
   *
   *
   *
@@ -45,15 +47,40 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
+#include "timers.h"
 
 /* Application Headers */
 #include "Led.h"
+#include "I2cBus.h"
+#include "MemPool.h"
 #include "Lcd16x2.h"
 #include "Lm35.h"
+#include "SampleRing.h"
+#include "Health.h"
+#include "Log.h"
+#include "UartRx.h"
+#include "Cobs.h"
+#include "Crc16.h"
+#include "Telemetry.h"
+#include "Rpc.h"
+#include "Gsm.h"
+#include "Alert.h"
+#include "Trace.h"
+#include "SysMon.h"
+#include "Power.h"
+#include "Bench.h"
+#include "Board.h"
+#include "Heap.h"
 
 /******************************************************************************
 *							MACRO DEFINITION
 ******************************************************************************/
+// Task stacks live in the NOLOAD .app_stacks section (see the linker scripts),
+// they are filled by the kernel so startup does not need to zero them
+#define APP_STACK               __attribute__((section(".app_stacks"), aligned(8)))
+
+// Entries of app_tasks[] in App.c, checked there at build time
+#define APP_TASK_COUNT          7
 
 /******************************************************************************
 *							DATA TYPE DECLARATION
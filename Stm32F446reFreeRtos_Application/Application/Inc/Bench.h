@@ -0,0 +1,85 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Bench.h
+  * @brief          : Header for Bench.c file.
+  *                   Kernel primitive latency benchmark suite.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *
+  * History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  * 	17-10-2026	-	Benchmark target replacing App_Run, queue, semaphore,
+  * 					ISR wake and tick jitter tests, p99 and histogram
+  * 	17-10-2026	-	BENCH_ENABLED may be set from the build (-DBENCH_ENABLED=1)
+  *
+  *
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+#ifndef INC_BENCH_H_
+#define INC_BENCH_H_
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "App.h"
+
+/******************************************************************************
+*							MACRO DEFINITION
+******************************************************************************/
+#ifndef BENCH_ENABLED
+#define BENCH_ENABLED           0       // 1: main runs Bench_Run instead of App_Run
+#endif
+
+// Tests, BENCH_TESTS selects which ones run
+#define BENCH_TEST_QUEUE        (1U << 0)   // Queue send, echo task replies, round trip
+#define BENCH_TEST_NOTIFY       (1U << 1)   // Task notification round trip
+#define BENCH_TEST_SEMAPHORE    (1U << 2)   // Binary semaphore give/take round trip
+#define BENCH_TEST_SWITCH       (1U << 3)   // Notify to higher priority task, one way
+#define BENCH_TEST_ISR_WAKE     (1U << 4)   // Pended IRQ to woken task, one way
+#define BENCH_TEST_TICK_JITTER  (1U << 5)   // vTaskDelayUntil(1 tick) period error
+#define BENCH_TEST_FPU_SWITCH   (1U << 6)   // As SWITCH with both tasks using the FPU
+#define BENCH_TESTS             (0x7FU)
+
+#define BENCH_ITERATIONS        1000    // Samples per test
+#define BENCH_HIST_BUCKETS      16      // Bucket k: [2^(k+4), 2^(k+5)) cycles, ends open
+#define BENCH_PERIOD_MS         10000   // Suite repeats every period
+#define BENCH_SETTLE_MS         100     // Lets the log drain between tests
+#define BENCH_TASK_STACK        256
+#define BENCH_TASK_PRIORITY     4       // Runner, the echo task runs one above
+
+// Software triggered interrupt for the ISR wake test, unused on this board
+#define BENCH_SWI_IRQn          SPDIF_RX_IRQn
+#define BENCH_SWI_IRQ_PRIORITY  5
+
+/******************************************************************************
+*							DATA TYPE DECLARATION
+******************************************************************************/
+
+/******************************************************************************
+*							API DECLARATIONS
+******************************************************************************/
+
+// Benchmark firmware entry, used by main in place of App_Run. Starts the DWT
+// cycle counter, creates the runner and echo tasks and starts the scheduler.
+// Every selected test prints, in core clock cycles (180 per us),
+//   BENCH,<test>,<samples>,<min>,<avg>,<p99>,<max>
+//   BHIST,<test>,<bucket 0>,...,<bucket BENCH_HIST_BUCKETS-1>
+void Bench_Run(void);
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
+
+#endif /* INC_BENCH_H_ */
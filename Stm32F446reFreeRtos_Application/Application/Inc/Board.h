@@ -0,0 +1,74 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Board.h
+  * @brief          : Header for Board.c file.
+  *                   Hardware seam between the application modules and the
+  *                   STM32 HAL handles of this board.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *
+  * History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  * 	17-10-2026	-	Host implementation in trace_host_tool/app_sim/sim_board.c
+  *
+  *
+  *
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+#ifndef INC_BOARD_H_
+#define INC_BOARD_H_
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "App.h"
+
+/******************************************************************************
+*							MACRO DEFINITION
+******************************************************************************/
+
+/******************************************************************************
+*							DATA TYPE DECLARATION
+******************************************************************************/
+
+/******************************************************************************
+*							API DECLARATIONS
+******************************************************************************/
+
+// Led.c, Lm35.c and I2cBus.c reach the peripherals only through these calls,
+// and Board.c forwards the HAL completion callbacks to LM35_Adc_Event_FromISR
+// and I2cBus_Event_FromISR. An off-target build provides its own Board.c
+// (scripted ADC blocks, captured I2C/GPIO traffic, see trace_host_tool/app_sim)
+// and leaves them unchanged.
+
+// Status LED (LD2, PA5), active high
+void Board_Led_Set(bool on);
+
+// LM35 acquisition: timer triggered ADC into a circular buffer, the
+// half/full/error events are reported as LM35_NOTIFY_* bits
+bool Board_Adc_Start(uint16_t *buffer, uint32_t length);
+void Board_Adc_Stop(void);
+
+// I2C3 master, write/read complete through I2C_BUS_EVT_* bits, probe blocks
+HAL_StatusTypeDef Board_I2c_Write(uint16_t dev_addr, uint8_t *data, uint16_t length);
+HAL_StatusTypeDef Board_I2c_Read(uint16_t dev_addr, uint8_t *data, uint16_t length);
+HAL_StatusTypeDef Board_I2c_Probe(uint16_t dev_addr, uint32_t timeout_ms);
+void Board_I2c_Recover(void);
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
+
+#endif /* INC_BOARD_H_ */
@@ -0,0 +1,63 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Cobs.h
+  * @brief          : Header for Cobs.c file.
+  *                   Consistent Overhead Byte Stuffing, frames never contain
+  *                   0x00 so it can be used as the delimiter on a byte stream.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *
+  * History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  *
+  *
+  *
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+#ifndef INC_COBS_H_
+#define INC_COBS_H_
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "App.h"
+
+/******************************************************************************
+*							MACRO DEFINITION
+******************************************************************************/
+#define COBS_DELIMITER          0x00
+
+// Worst case encoded size, one code byte per 254 data bytes plus the first one
+#define COBS_ENCODED_MAX(len)   ((len) + ((len) / 254U) + 1U)
+
+/******************************************************************************
+*							DATA TYPE DECLARATION
+******************************************************************************/
+
+/******************************************************************************
+*							API DECLARATIONS
+******************************************************************************/
+
+// Encodes length bytes into out (no delimiter appended), returns encoded size
+uint32_t Cobs_Encode(const uint8_t *in, uint32_t length, uint8_t *out);
+
+// Decodes one frame (without delimiter), returns decoded size or 0 if malformed
+uint32_t Cobs_Decode(const uint8_t *in, uint32_t length, uint8_t *out, uint32_t out_size);
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
+
+#endif /* INC_COBS_H_ */
@@ -0,0 +1,57 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Crc16.h
+  * @brief          : Header for Crc16.c file.
+  *                   CRC-16/CCITT-FALSE used by the framed USART1 protocols.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *
+  * History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  *
+  *
+  *
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+#ifndef INC_CRC16_H_
+#define INC_CRC16_H_
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "App.h"
+
+/******************************************************************************
+*							MACRO DEFINITION
+******************************************************************************/
+// Polynomial 0x1021, MSB first, no reflection, no final XOR
+#define CRC16_INIT              0xFFFFU
+
+/******************************************************************************
+*							DATA TYPE DECLARATION
+******************************************************************************/
+
+/******************************************************************************
+*							API DECLARATIONS
+******************************************************************************/
+
+// Continues crc over length bytes, start with CRC16_INIT
+uint16_t Crc16_Update(uint16_t crc, const uint8_t *data, uint32_t length);
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
+
+#endif /* INC_CRC16_H_ */
@@ -0,0 +1,166 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Gsm.h
+  * @brief          : Header for Gsm.c file.
+  *                   AT command engine for the SIM800 on USART3.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *
+  * History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  * 	17-10-2026	-	Task woken by notification bits, no idle poll
+  *
+  *
+  *
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+#ifndef INC_GSM_H_
+#define INC_GSM_H_
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+// No App.h, the host modem simulation builds Gsm.c against stubs
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/******************************************************************************
+*							MACRO DEFINITION
+******************************************************************************/
+#define GSM_TASK_STACK          384
+#define GSM_TASK_PRIORITY       1       // Below the LM35 task, modem waits never delay a sample
+
+#define GSM_QUEUE_LEN           8       // Commands waiting for the modem
+#define GSM_CMD_TEXT_MAX        48      // Command after "AT", with terminator
+#define GSM_LINE_MAX            128     // Command line sent / response line received
+#define GSM_TOKENS_MAX          8       // Fields of one response line
+#define GSM_CHAIN_MAX           4       // Commands sharing one command line
+#define GSM_URC_MAX             4       // Gsm_Subscribe slots
+
+#define GSM_RESET_TIMEOUTS      3       // Timeouts in a row before the modem is re-initialised
+
+// GSM task notification bits, with nothing on the wire it sleeps on these only
+#define GSM_NOTIFY_RX           (1UL << 0)  // USART3 bytes delivered, see UartRx_SetNotify
+#define GSM_NOTIFY_SUBMIT       (1UL << 1)  // Gsm_Submit queued a command
+
+// GsmCommand_t.flags
+#define GSM_FLAG_CHAIN          (1U << 0)   // May share a command line ("AT+CSQ;+CREG?")
+#define GSM_FLAG_CTRL_Z         (1U << 1)   // Payload ends with Ctrl-Z (SMS text)
+
+/******************************************************************************
+*							DATA TYPE DECLARATION
+******************************************************************************/
+// Latency statistics are kept per type
+typedef enum
+{
+    GSM_TYPE_CONTROL = 0,       // Start-up and settings
+    GSM_TYPE_STATUS,            // Signal, registration, battery queries
+    GSM_TYPE_SMS,
+    GSM_TYPE_GPRS,
+    GSM_TYPE_COUNT
+} GsmType_t;
+
+typedef enum
+{
+    GSM_OK = 0,
+    GSM_ERROR,                  // ERROR / +CME ERROR / +CMS ERROR / SEND FAIL
+    GSM_TIMEOUT,
+    GSM_RESET,                  // Modem restarted while the command was on the line
+} GsmStatus_t;
+
+// Valid during the done callback only, argv points into the engine's buffers
+typedef struct
+{
+    GsmStatus_t status;
+    int16_t error;              // +CME/+CMS ERROR code, -1 if none
+    uint8_t argc;               // Fields of the last line matching prefix
+    const char *argv[GSM_TOKENS_MAX];
+    uint32_t latency_ms;        // Command line written to final result
+} GsmResult_t;
+
+typedef void (*GsmDone_t)(const GsmResult_t *result, void *context);
+typedef void (*GsmUrc_t)(uint8_t argc, const char *const *argv, void *context);
+
+typedef struct
+{
+    char text[GSM_CMD_TEXT_MAX];    // After "AT", e.g. "+CSQ" or "+CMGS=\"+4912345\""
+    const char *prefix;             // Info lines for this command ("+CSQ:"), NULL = none,
+                                    // "" = any line that is not a URC
+    const uint8_t *payload;         // Sent after the '>' prompt, NULL = no prompt.
+    uint16_t payload_len;           // Caller owned until done has run.
+    uint8_t type;                   // GsmType_t
+    uint8_t flags;                  // GSM_FLAG_*
+    uint32_t timeout_ms;
+    GsmDone_t done;                 // Runs in the GSM task, may be NULL
+    void *context;
+} GsmCommand_t;
+
+typedef struct
+{
+    uint32_t count;             // Completed, any status
+    uint32_t errors;            // GSM_ERROR and GSM_RESET
+    uint32_t timeouts;
+    uint32_t avg_ms;            // Latency of the answered (OK/ERROR) ones
+    uint32_t max_ms;
+    uint32_t answered;
+    uint32_t total_ms;
+} GsmLatency_t;
+
+typedef struct
+{
+    GsmLatency_t type[GSM_TYPE_COUNT];
+    uint32_t lines;             // Command lines written
+    uint32_t commands;          // Commands written, lines < commands when chained
+    uint32_t urcs;
+    uint32_t resets;            // Modem restarts seen or forced
+    uint32_t overflows;         // Response lines longer than GSM_LINE_MAX
+} GsmStats_t;
+
+/******************************************************************************
+*							API DECLARATIONS
+******************************************************************************/
+
+// Create the command queue, before any task submits
+bool Gsm_Init(void);
+
+// GSM task: initialises the modem, then runs the queued commands
+void Gsm_Handler(void *params);
+
+// Queue a command (copied), false if the queue stayed full for wait ticks
+bool Gsm_Submit(const GsmCommand_t *command, TickType_t wait);
+
+// Unsolicited lines starting with prefix ("+CMTI:") go to handler, GSM task
+bool Gsm_Subscribe(const char *prefix, GsmUrc_t handler, void *context);
+
+// Start-up sequence done and no reset seen since
+bool Gsm_IsReady(void);
+
+void Gsm_GetStats(GsmStats_t *stats);
+const char *Gsm_TypeName(GsmType_t type);
+
+// Splits a response line in place: "+CSQ: 17,0" -> "+CSQ", "17", "0".
+// Quotes are removed from quoted fields, commas inside them are kept.
+uint8_t Gsm_Tokenise(char *line, const char **argv, uint8_t max);
+
+// USART3 TX finished (or failed), interrupt context
+void Gsm_TxComplete_FromISR(void);
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
+
+#endif /* INC_GSM_H_ */
@@ -0,0 +1,87 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Health.h
+  * @brief          : Header for Health.c file.
+  *                   System health states published as event group bits.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *
+  * History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  * 	17-10-2026	-	Health_Wake for observers with other wake sources
+  *
+  *
+  *
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+#ifndef INC_HEALTH_H_
+#define INC_HEALTH_H_
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "App.h"
+#include "event_groups.h"
+
+/******************************************************************************
+*							MACRO DEFINITION
+******************************************************************************/
+// Fault bits, set while the fault is active
+#define HEALTH_SENSOR_DISCONNECTED  (1UL << 0)
+#define HEALTH_ADC_TIMEOUT          (1UL << 1)
+#define HEALTH_OVER_TEMPERATURE     (1UL << 2)
+#define HEALTH_COMMS_LOSS           (1UL << 3)
+#define HEALTH_FAULTS_ALL           (0xFFUL)
+
+// One change bit per observer, all set whenever a fault bit changes.
+// 24 usable event bits: 8 faults + up to HEALTH_MAX_OBSERVERS observers.
+#define HEALTH_MAX_OBSERVERS        8
+#define HEALTH_OBSERVER_SHIFT       8
+
+/******************************************************************************
+*							DATA TYPE DECLARATION
+******************************************************************************/
+typedef EventBits_t HealthObserver_t;   // The observer's change bit
+
+/******************************************************************************
+*							API DECLARATIONS
+******************************************************************************/
+
+// Creates the event group, before any task runs
+bool Health_Init(void);
+
+// Sets the faults in set and clears those in clear. Observers only wake
+// when this actually changes a fault bit.
+void Health_Update(EventBits_t set, EventBits_t clear);
+
+// Current fault bits
+EventBits_t Health_Get(void);
+
+// Reserves a change bit for the caller, 0 when all are taken
+HealthObserver_t Health_Observe(void);
+
+// Blocks until a fault bit changes or timeout expires, returns the fault
+// bits and reports through changed whether a change woke it
+EventBits_t Health_Wait(HealthObserver_t observer, TickType_t timeout, bool *changed);
+
+// Wakes the observer without a fault change, for an observer that also
+// waits for something else (Alert: GSM send results). Task context only.
+void Health_Wake(HealthObserver_t observer);
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
+
+#endif /* INC_HEALTH_H_ */
@@ -0,0 +1,75 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Heap.h
+  * @brief          : Header for Heap.c file.
+  *                   TLSF (two level segregated fit) heap for FreeRTOS.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *
+  * History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  * 	17-10-2026	-	v01	- Classes cache heap_4 blocks, stats follow
+  * 	17-10-2026	-	v01	- TLSF replaces the cache and heap_4
+  *
+  *
+  *
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+#ifndef INC_HEAP_H_
+#define INC_HEAP_H_
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+// Only kernel headers, Heap.c is also built by the host heap benchmark
+#include "FreeRTOS.h"
+#include <stdint.h>
+
+/******************************************************************************
+*							MACRO DEFINITION
+******************************************************************************/
+// Two level segregated fit. First level: power of two ranges, second level:
+// HEAP_SL_COUNT equal lists per range. Blocks below HEAP_SMALL_BLOCK bytes
+// are kept in exact 8 byte steps in first level 0.
+#define HEAP_ALIGN_LOG2         3       // portBYTE_ALIGNMENT 8
+#define HEAP_SL_LOG2            4       // 16 lists per range, <= 1/16 search waste
+#define HEAP_FL_MAX_LOG2        14      // Blocks below 16 KB, covers configTOTAL_HEAP_SIZE
+
+#define HEAP_SL_COUNT           (1U << HEAP_SL_LOG2)
+#define HEAP_FL_SHIFT           (HEAP_SL_LOG2 + HEAP_ALIGN_LOG2)
+#define HEAP_SMALL_BLOCK        (1U << HEAP_FL_SHIFT)
+#define HEAP_FL_COUNT           (HEAP_FL_MAX_LOG2 - HEAP_FL_SHIFT + 1)
+
+/******************************************************************************
+*							DATA TYPE DECLARATION
+******************************************************************************/
+
+/******************************************************************************
+*							API DECLARATIONS
+******************************************************************************/
+
+// pvPortMalloc/vPortFree and the xPortGet*/vPortGetHeapStats queries are
+// provided by Heap.c with their usual kernel meaning. vPortGetHeapStats
+// reads running counters, the largest/smallest free block sizes are those
+// of the highest/lowest non-empty list (exact to the list granularity).
+
+// Free blocks in each first level range, fl < HEAP_FL_COUNT
+uint32_t Heap_GetFreeBlocks(uint32_t fl);
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
+
+#endif /* INC_HEAP_H_ */
@@ -0,0 +1,121 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : I2cBus.h
+  * @brief          : Header for I2cBus.c file.
+  *                   I2C3 bus manager, transactions are queued by any task and
+  *                   run over DMA by a single bus task.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *
+  * History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  * 	17-10-2026	-	Peripheral access moved behind Board.h
+  *
+  *
+  *
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+#ifndef INC_I2CBUS_H_
+#define INC_I2CBUS_H_
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+// No App.h, Lcd16x2.h needs these types while App.h is still being read
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/******************************************************************************
+*							MACRO DEFINITION
+******************************************************************************/
+#define I2C_BUS_QUEUE_LEN       8           // Pending transaction descriptors
+#define I2C_BUS_TASK_STACK      256
+#define I2C_BUS_TASK_PRIORITY   3           // Above every client task
+
+// Notification bit set on the submitting task when a transaction finishes
+#define I2C_BUS_NOTIFY_DONE     (1UL << 31)
+
+// Bus task notification bits, reported by the board layer
+#define I2C_BUS_EVT_DONE        (1UL << 0)
+#define I2C_BUS_EVT_ERROR       (1UL << 1)
+#define I2C_BUS_EVT_ALL         (I2C_BUS_EVT_DONE | I2C_BUS_EVT_ERROR)
+
+/******************************************************************************
+*							DATA TYPE DECLARATION
+******************************************************************************/
+typedef enum
+{
+    I2C_BUS_OP_WRITE = 0,
+    I2C_BUS_OP_READ,
+    I2C_BUS_OP_PROBE                        // Address only, checks for an ACK
+} I2cBusOp_t;
+
+struct I2cBusXfer;
+typedef void (*I2cBusCallback_t)(struct I2cBusXfer *xfer);
+
+// Transaction descriptor, owned by the client until completion is reported
+typedef struct I2cBusXfer
+{
+    I2cBusOp_t op;
+    uint16_t dev_addr;                      // 8-bit (shifted) address, HAL style
+    uint8_t *data;                          // Must stay valid until completion
+    uint16_t length;
+    uint32_t timeout_ms;
+
+    TaskHandle_t notify_task;               // Gets I2C_BUS_NOTIFY_DONE, may be NULL
+    I2cBusCallback_t callback;              // Runs in the bus task, may be NULL
+    void *context;                          // Free for the client's callback
+
+    volatile HAL_StatusTypeDef status;      // Result, valid after completion
+} I2cBusXfer_t;
+
+typedef struct
+{
+    uint32_t completed;
+    uint32_t errors;                        // NACK, arbitration lost, bus error
+    uint32_t timeouts;                      // Bus reinitialised after each one
+} I2cBusStats_t;
+
+/******************************************************************************
+*							API DECLARATIONS
+******************************************************************************/
+
+// Creates the descriptor queue and the bus task
+bool I2cBus_Init(void);
+
+// Queues a transaction and returns, completion is reported by notify/callback
+bool I2cBus_Submit(I2cBusXfer_t *xfer, TickType_t wait);
+
+// Queues a transaction and sleeps until it has completed
+HAL_StatusTypeDef I2cBus_Transfer(I2cBusXfer_t *xfer);
+
+// Blocking helpers built on I2cBus_Transfer
+HAL_StatusTypeDef I2cBus_Write(uint16_t dev_addr, uint8_t *data, uint16_t length, uint32_t timeout_ms);
+HAL_StatusTypeDef I2cBus_Read(uint16_t dev_addr, uint8_t *data, uint16_t length, uint32_t timeout_ms);
+HAL_StatusTypeDef I2cBus_Probe(uint16_t dev_addr, uint32_t timeout_ms);
+
+void I2cBus_GetStats(I2cBusStats_t *stats);
+
+// Transfer completion from Board.c, interrupt context
+void I2cBus_Event_FromISR(uint32_t event);
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
+
+#endif /* INC_I2CBUS_H_ */
@@ -17,6 +17,14 @@
   *
   * History: v01
   * 	18-07-2025	-	v01	- Initial version
+  * 	17-10-2026	-	Shadow framebuffer renderer, only changed cells are sent
+  * 	17-10-2026	-	Nibble sequences batched into one I2C transaction per frame
+  * 	17-10-2026	-	I2C traffic goes through the DMA bus manager (I2cBus)
+  * 	17-10-2026	-	I2C write failures reported with TRACE instead of printf
+  * 	17-10-2026	-	Frames built in xLcdFramePool blocks and sent without waiting
+  * 	17-10-2026	-	Temperature read from the SampleRing instead of the mailbox
+  * 	17-10-2026	-	I2C write failures raise the HEALTH_COMMS_LOSS fault
+  * 	17-10-2026	-	A frame lost on the bus makes the next render redraw every cell
   *
   *
   *
@@ -32,10 +40,15 @@
 /******************************************************************************
 *							INCLUDES
 ******************************************************************************/
+#include "App.h"
 
 /******************************************************************************
 *							MACRO DEFINITION
 ******************************************************************************/
+#define LCD_ROWS        2
+#define LCD_COLS        16
+#define LCD_TX_BUF_LEN  128     // Expander bytes per I2C transaction, 4 per LCD byte
+#define LCD_FRAME_COUNT 2       // Frames in xLcdFramePool, one filling, one on the bus
 
 /******************************************************************************
 *							DATA TYPE DECLARATION
@@ -45,6 +58,13 @@ typedef struct {
     char line2[17];
 } LcdMessage_t;
 
+/* Expander byte stream of one I2C transaction, allocated from xLcdFramePool */
+typedef struct {
+    I2cBusXfer_t xfer;
+    uint16_t length;
+    uint8_t data[LCD_TX_BUF_LEN];
+} LcdFrame_t;
+
 
 /******************************************************************************
 *							API DECLARATIONS
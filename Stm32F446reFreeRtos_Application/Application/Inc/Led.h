@@ -17,6 +17,9 @@
   *
   * History: v01
   * 	17-07-2025	-	v01	- Initial version
+  * 	17-10-2026	-	Over temperature and comms loss modes
+  * 	17-10-2026	-	Table driven patterns on a software timer, LED task removed
+  * 	17-10-2026	-	Pattern speed adjustable at run time
   *
   *
   *
@@ -31,28 +34,64 @@
 /******************************************************************************
 *							INCLUDES
 ******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
 
 /******************************************************************************
 *							MACRO DEFINITION
 ******************************************************************************/
+// Morse timing: dot = 1 unit, dash = 3, letter gap = 3, word gap = 7
+#define LED_MORSE_UNIT_MS       150
+
+// Pattern step helpers
+#define LED_ON(ms)              { true,  (ms) }
+#define LED_OFF(ms)             { false, (ms) }
+#define LED_DOT                 LED_ON(LED_MORSE_UNIT_MS),     LED_OFF(LED_MORSE_UNIT_MS)
+#define LED_DASH                LED_ON(3 * LED_MORSE_UNIT_MS), LED_OFF(LED_MORSE_UNIT_MS)
+#define LED_WORD_GAP            LED_OFF(6 * LED_MORSE_UNIT_MS)
+
+// Pattern speed in percent of the table timing, 200 = twice as fast
+#define LED_SPEED_DEFAULT       100
+#define LED_SPEED_MIN           25
+#define LED_SPEED_MAX           400
+
 typedef enum
 {
-    LED_MODE_NORMAL = 0,        // Regular 100ms on/off
-    LED_MODE_SENSOR_FAIL,       // 300ms on/off
-    LED_MODE_ADC_ERROR          // 600ms on/off
+    LED_MODE_NORMAL = 0,        // Heartbeat
+    LED_MODE_SENSOR_FAIL,       // Morse "S"
+    LED_MODE_ADC_ERROR,         // Morse "A"
+    LED_MODE_OVER_TEMP,         // 100ms on/off
+    LED_MODE_COMMS_LOSS,        // Morse "C"
+    LED_MODE_COUNT
 } LedMode_t;
 
 /******************************************************************************
 *							DATA TYPE DECLARATION
 ******************************************************************************/
+// One LED level held for ms, a pattern repeats its steps forever
+typedef struct
+{
+    bool on;
+    uint16_t ms;
+} LedStep_t;
 
+typedef struct
+{
+    const LedStep_t *steps;
+    uint8_t count;
+} LedPattern_t;
 
 /******************************************************************************
 *							API DECLARATIONS
 ******************************************************************************/
 
-/* LedTask_Handler */
-void Led_Handler(void *params);
+// Start the LED pattern timer, the pattern follows the Health faults
+bool Led_Init(void);
+
+// Pattern speed, false if out of LED_SPEED_MIN..LED_SPEED_MAX. Applies from
+// the next step.
+bool Led_SetSpeed(uint16_t percent);
+uint16_t Led_GetSpeed(void);
 
 /******************************************************************************
 *							EOF
@@ -18,6 +18,14 @@
   * History: v01
   * 	17-07-2025	-	v01	- Initial version
   *		21-07-2025	- 	Over temperature update to >50*C
+  *		17-10-2026	- 	TIM2 triggered ADC with circular DMA double buffer
+  *		17-10-2026	- 	Median spike rejector + CIC decimator filter stage
+  *		17-10-2026	- 	Integer centi-degree conversion via compile-time LUT
+  *		17-10-2026	- 	Timestamped sample published through a mailbox
+  *		17-10-2026	- 	ADC/TIM2 access moved behind Board.h
+  *		17-10-2026	- 	LM35_GetData returns a tear-free copy from the SampleRing
+  *		17-10-2026	- 	Run time LM35_Config_t (period, thresholds, filter)
+  *		17-10-2026	- 	LM35_GetOverrunCount, halves dropped on a late wake-up
   *
   *
   *	| Temp (°C) | Voltage (V) | ADC Value (12-bit @ 3.3V) |
@@ -43,15 +51,51 @@
 /******************************************************************************
 *							INCLUDES
 ******************************************************************************/
-#include "App.h"
+// No App.h, SampleRing.h needs these types while App.h is still being read
+#include "FreeRTOS.h"
+#include <stdbool.h>
+#include <stdint.h>
 /******************************************************************************
 *							MACRO DEFINITION
 ******************************************************************************/
-#define LM35_ADC_TIMEOUT     100
+#define LM35_ADC_TIMEOUT     100    // Max wait for a DMA half buffer (ms)
+
+/* Boot defaults of LM35_Config_t, changed at run time with LM35_SetConfig() */
 #define LM35_DISCONNECT_ADC  30     // ADC value below this = sensor fault
 #define LM35_SAMPLING_DELAY  1000   // 1 second
 #define LM35_OVERTEMPERATURE_ADC 625
 
+#define LM35_SAMPLING_MIN_MS     100    // Publication period limits
+#define LM35_SAMPLING_MAX_MS     60000
+
+#define LM35_ADC_SAMPLE_RATE_HZ  1000   // TIM2 TRGO rate, see MX_TIM2_Init()
+#define LM35_DMA_BUFFER_LEN      128    // Circular buffer, 2 halves of 64 samples
+
+/* Filter stage: median-of-k -> CIC decimator -> published value
+ * Each 4x oversampling adds 1 bit of resolution (given enough noise), so
+ * 64x decimation gives up to 3 extra bits on top of the 12-bit ADC. */
+#define LM35_FILTER_MEDIAN_K     3      // Spike rejector window (odd, max 7), 0 = off
+#define LM35_FILTER_DECIM_LOG2   6      // Decimate by 2^6 = 64 samples per output
+#define LM35_FILTER_CIC_ORDER    2      // CIC stages, 1 = plain moving average
+#define LM35_FILTER_FRAC_BITS    4      // Filter output is ADC code in Q4
+
+/* Run time limits: 12-bit samples grow by ORDER * DECIM_LOG2 bits in the CIC
+ * and must fit the 32-bit integrators, and leave FRAC_BITS of growth */
+#define LM35_FILTER_MEDIAN_MAX   7
+#define LM35_FILTER_DECIM_MIN    ((LM35_FILTER_FRAC_BITS + LM35_FILTER_CIC_ORDER - 1) / LM35_FILTER_CIC_ORDER)
+#define LM35_FILTER_DECIM_MAX    ((32 - 12) / LM35_FILTER_CIC_ORDER)
+
+/* ADC code -> temperature conversion (10 mV/C, 12-bit ADC) */
+#define LM35_VREF_MV             3300   // ADC reference voltage
+#define LM35_ADC_MAX_CODE        4095
+#define LM35_TEMP_INVALID_CDEG   (-10000)   // -100.00 C, reported when disconnected
+#define LM35_CAL_GAIN_ONE        32768      // Calibration gain 1.0 in Q15
+
+/* Notification bits set by the ADC/DMA callbacks */
+#define LM35_NOTIFY_HALF_CPLT    (1UL << 0)
+#define LM35_NOTIFY_FULL_CPLT    (1UL << 1)
+#define LM35_NOTIFY_ADC_ERROR    (1UL << 2)
+
 
 
 /******************************************************************************
@@ -59,12 +103,39 @@
 ******************************************************************************/
 typedef struct
 {
-    uint32_t adc_raw;
-    float temperature_c;
+    uint32_t adc_raw;           // Filtered ADC code, 12-bit
+    uint32_t adc_q4;            // Filtered ADC code, Q4 (12.4 fixed point)
+    int32_t temperature_cdeg;   // Temperature in 0.01 C
     bool adc_timeout_error;
     bool sensor_disconnected;
 } LM35_Data_t;
 
+/* Record published to the consumers */
+typedef struct
+{
+    TickType_t timestamp;       // Tick count at publication
+    uint32_t sequence;          // Incremented on every publication
+    LM35_Data_t data;
+} LM35_Sample_t;
+
+/* Run time settings, validated and applied as a whole by LM35_SetConfig() */
+typedef struct
+{
+    uint16_t sample_period_ms;  // Publication period
+    uint16_t disconnect_adc;    // ADC code below this = sensor disconnected
+    uint16_t overtemp_adc;      // ADC code above this = over temperature
+    uint8_t median_k;           // Spike rejector window, 0 = off, else odd
+    uint8_t decim_log2;         // CIC decimation 2^n samples per output
+} LM35_Config_t;
+
+/* Per-device calibration, applied after the table lookup:
+ * cdeg = (cdeg * gain_q15 / 32768) + offset_cdeg */
+typedef struct
+{
+    int32_t gain_q15;
+    int32_t offset_cdeg;
+} LM35_Calibration_t;
+
 /******************************************************************************
 *							API DECLARATIONS
 ******************************************************************************/
@@ -72,8 +143,26 @@ typedef struct
 //LM35 handler
 void LM35_Handler(void *pvParameters);
 
-// Read-only access for the Sensor Data
-const LM35_Data_t* LM35_GetData(void);
+// Last published sensor data (copy), false before the first sample
+bool LM35_GetData(LM35_Data_t *data);
+
+// Q4 ADC code to calibrated centi-degrees (integer only)
+int32_t LM35_AdcToCentiCelsius(uint32_t adc_q4);
+
+// Calibration access
+void LM35_SetCalibration(const LM35_Calibration_t *cal);
+void LM35_GetCalibration(LM35_Calibration_t *cal);
+
+// Run time settings, false (nothing changed) if a field is out of range.
+// Filter changes restart the filter, the other fields apply to the next sample.
+bool LM35_SetConfig(const LM35_Config_t *config);
+void LM35_GetConfig(LM35_Config_t *config);
+
+// Halves dropped because the task woke too late to read them
+uint32_t LM35_GetOverrunCount(void);
+
+// ADC/DMA events from Board.c, interrupt context
+void LM35_Adc_Event_FromISR(uint32_t event);
 
 /******************************************************************************
 *							EOF
@@ -0,0 +1,77 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Log.h
+  * @brief          : Header for Log.c file.
+  *                   printf/log transport, RAM ring drained by USART2 TX DMA.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *
+  * History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  *
+  *
+  *
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+#ifndef INC_LOG_H_
+#define INC_LOG_H_
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "App.h"
+
+/******************************************************************************
+*							MACRO DEFINITION
+******************************************************************************/
+#define LOG_BUFFER_SIZE         2048        // Bytes, must be a power of two
+#define LOG_BLOCK_TIMEOUT_MS    100         // Longest wait for space in BLOCK mode
+#define LOG_OVERFLOW_DEFAULT    LOG_OVERFLOW_DROP
+
+/******************************************************************************
+*							DATA TYPE DECLARATION
+******************************************************************************/
+typedef enum
+{
+    LOG_OVERFLOW_DROP = 0,      // Discard the whole write, count the bytes
+    LOG_OVERFLOW_BLOCK          // Sleep until DMA frees space (tasks only)
+} LogOverflow_t;
+
+typedef struct
+{
+    uint32_t written;           // Bytes accepted into the ring
+    uint32_t dropped;           // Bytes discarded because the ring was full
+    uint32_t peak_used;         // Highest ring occupancy seen
+} LogStats_t;
+
+/******************************************************************************
+*							API DECLARATIONS
+******************************************************************************/
+
+// Copies data into the ring and starts DMA if idle, returns bytes accepted
+uint32_t Log_Write(const char *data, uint32_t length);
+
+void Log_SetOverflowPolicy(LogOverflow_t policy);
+
+void Log_GetStats(LogStats_t *stats);
+
+// Called from the USART2 TX complete/error callbacks
+void Log_TxComplete_FromISR(void);
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
+
+#endif /* INC_LOG_H_ */
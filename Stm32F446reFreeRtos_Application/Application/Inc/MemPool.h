@@ -0,0 +1,107 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : MemPool.h
+  * @brief          : Header for MemPool.c file.
+  *                   Fixed-block memory pools for message payloads.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *
+  * History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  *
+  *
+  *
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+#ifndef INC_MEMPOOL_H_
+#define INC_MEMPOOL_H_
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "App.h"
+
+/******************************************************************************
+*							MACRO DEFINITION
+******************************************************************************/
+// Block size rounded so every block is 8 byte aligned and can hold the link
+#define MEMPOOL_BLOCK_SIZE(size)    ((((size) < sizeof(void *) ? sizeof(void *) : (size)) + 7U) & ~7U)
+
+// Defines a pool of count blocks of size bytes with static storage,
+// MemPool_Init() must be called before the first allocation
+#define MEMPOOL_DEFINE(pool, pool_name, size, count)                                    \
+    static uint8_t pool##_storage[(count) * MEMPOOL_BLOCK_SIZE(size)]                   \
+        __attribute__((aligned(8)));                                                    \
+    MemPool_t pool = { .name = (pool_name), .storage = pool##_storage,                  \
+                       .block_size = MEMPOOL_BLOCK_SIZE(size), .block_count = (count) }
+
+/******************************************************************************
+*							DATA TYPE DECLARATION
+******************************************************************************/
+typedef struct MemPool MemPool_t;
+
+// Called, possibly from an interrupt, each time an allocation finds the pool empty
+typedef void (*MemPoolHook_t)(MemPool_t *pool);
+
+struct MemPool
+{
+    const char *name;
+    uint8_t *storage;
+    uint16_t block_size;
+    uint16_t block_count;
+    void *free_list;                // Freed blocks, LIFO
+    uint16_t fresh;                 // Blocks never handed out start here
+    uint16_t in_use;
+    uint16_t peak_in_use;
+    uint32_t allocs;
+    uint32_t exhausted;             // Allocations that returned NULL
+    MemPoolHook_t on_exhausted;
+    MemPool_t *next;                // Registry, see MemPool_Next()
+};
+
+typedef struct
+{
+    const char *name;
+    uint16_t block_size;
+    uint16_t block_count;
+    uint16_t in_use;
+    uint16_t peak_in_use;
+    uint32_t allocs;
+    uint32_t exhausted;
+} MemPoolStats_t;
+
+/******************************************************************************
+*							API DECLARATIONS
+******************************************************************************/
+
+// Adds the pool to the registry, call once at startup
+void MemPool_Init(MemPool_t *pool);
+
+// O(1), never blocks, callable from tasks and from interrupts at or below
+// configMAX_SYSCALL_INTERRUPT_PRIORITY. Returns NULL when the pool is empty.
+void *MemPool_Alloc(MemPool_t *pool);
+void MemPool_Free(MemPool_t *pool, void *block);
+
+void MemPool_SetExhaustedHook(MemPool_t *pool, MemPoolHook_t hook);
+void MemPool_GetStats(MemPool_t *pool, MemPoolStats_t *stats);
+
+// Walks the registry, pass NULL to get the first pool
+MemPool_t *MemPool_Next(MemPool_t *pool);
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
+
+#endif /* INC_MEMPOOL_H_ */
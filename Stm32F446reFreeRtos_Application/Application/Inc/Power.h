@@ -0,0 +1,63 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Power.h
+  * @brief          : Header for Power.c file.
+  *                   Tickless idle pre/post sleep hooks and sleep statistics.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *
+  * History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  *
+  *
+  *
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+#ifndef INC_POWER_H_
+#define INC_POWER_H_
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "App.h"
+
+/******************************************************************************
+*							MACRO DEFINITION
+******************************************************************************/
+
+/******************************************************************************
+*							DATA TYPE DECLARATION
+******************************************************************************/
+typedef struct
+{
+    uint32_t sleeps;            // Tickless sleeps entered (= wakeups taken)
+    uint32_t slept_ms;          // Time spent asleep, measured on TIM5
+} PowerStats_t;
+
+/******************************************************************************
+*							API DECLARATIONS
+******************************************************************************/
+
+// configPRE_SLEEP_PROCESSING / configPOST_SLEEP_PROCESSING, interrupts disabled
+void PreSleepProcessing(uint32_t ulExpectedIdleTime);
+void PostSleepProcessing(uint32_t ulExpectedIdleTime);
+
+void Power_GetStats(PowerStats_t *stats);
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
+
+#endif /* INC_POWER_H_ */
@@ -0,0 +1,126 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Rpc.h
+  * @brief          : Header for Rpc.c file.
+  *                   Runtime command channel on USART1 (HC-05).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *
+  * History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  * 	17-10-2026	-	SET_ALERT command, alert settings in GET_CONFIG
+  *
+  *
+  *
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+#ifndef INC_RPC_H_
+#define INC_RPC_H_
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "App.h"
+
+/******************************************************************************
+*							MACRO DEFINITION
+******************************************************************************/
+#define RPC_TASK_STACK          256
+#define RPC_TASK_PRIORITY       2       // Above Telemetry, a reply never waits for a batch
+
+/*
+ * Framed like the telemetry (0x00, COBS(payload), 0x00, CRC-16 at the end,
+ * see Telemetry.h), little endian.
+ *
+ * Request, frame type TELEMETRY_TYPE_RPC_REQUEST:
+ *     0     1  schema version (TELEMETRY_SCHEMA_VERSION)
+ *     1     1  frame type
+ *     2     1  tag, echoed in the response to match it to the request
+ *     3     1  command (RpcCommand_t)
+ *     4     n  arguments, length fixed per command
+ *   end     2  CRC
+ *
+ * Response, frame type TELEMETRY_TYPE_RPC_RESPONSE:
+ *     0     1  schema version
+ *     1     1  frame type
+ *     2     1  tag of the request
+ *     3     1  command of the request
+ *     4     1  status (RpcStatus_t)
+ *     5     2  dispatch time (us), frame delimiter to handler return
+ *     7     n  result, only with RPC_STATUS_OK
+ *   end     2  CRC
+ *
+ * Frames with a bad CRC or the wrong version/type get no response, they are
+ * counted as corrupt. trace_host_tool/rpc_client.py is the host side.
+ */
+#define RPC_REQUEST_HEADER_LEN  4
+#define RPC_RESPONSE_HEADER_LEN 7
+#define RPC_ARGS_MAX            16
+#define RPC_RESULT_MAX          24
+
+/******************************************************************************
+*							DATA TYPE DECLARATION
+******************************************************************************/
+// Command ids and their arguments -> result, all little endian
+typedef enum
+{
+    RPC_CMD_PING            = 0x01,     // -> u32 uptime ms
+    RPC_CMD_GET_CONFIG      = 0x02,     // -> u16 period ms, u16 disconnect adc,
+                                        //    u16 overtemp adc, u8 median k,
+                                        //    u8 decim log2, i32 gain q15,
+                                        //    i32 offset cdeg, u16 led speed %,
+                                        //    u16 alert window s, u8 alert channel
+    RPC_CMD_SET_PERIOD      = 0x10,     // u16 period ms
+    RPC_CMD_SET_THRESHOLDS  = 0x11,     // u16 disconnect adc, u16 overtemp adc
+    RPC_CMD_SET_FILTER      = 0x12,     // u8 median k, u8 decim log2
+    RPC_CMD_SET_CALIBRATION = 0x13,     // i32 gain q15, i32 offset cdeg
+    RPC_CMD_SET_LED_SPEED   = 0x14,     // u16 percent
+    RPC_CMD_SET_ALERT       = 0x15,     // u16 window s, u8 channel (AlertChannel_t)
+    RPC_CMD_GET_STATS       = 0x20,     // -> RpcStats_t fields in order
+} RpcCommand_t;
+
+typedef enum
+{
+    RPC_STATUS_OK = 0,
+    RPC_STATUS_UNKNOWN_CMD,
+    RPC_STATUS_BAD_LENGTH,              // Argument length does not match the command
+    RPC_STATUS_BAD_VALUE,               // Rejected by the module, nothing changed
+} RpcStatus_t;
+
+typedef struct
+{
+    uint32_t requests;                  // Valid frames dispatched
+    uint32_t errors;                    // Of those, answered with status != OK
+    uint32_t corrupt;                   // Frames dropped without a response
+    uint32_t dropped;                   // Responses the link could not take
+    uint16_t avg_us;                    // Dispatch time, running average
+    uint16_t max_us;
+} RpcStats_t;
+
+/******************************************************************************
+*							API DECLARATIONS
+******************************************************************************/
+
+// RPC task: decodes requests from the USART1 receive stream and answers them
+void Rpc_Handler(void *params);
+
+// Copy of the counters
+void Rpc_GetStats(RpcStats_t *stats);
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
+
+#endif /* INC_RPC_H_ */
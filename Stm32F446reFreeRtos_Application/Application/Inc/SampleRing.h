@@ -0,0 +1,80 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : SampleRing.h
+  * @brief          : Header for SampleRing.c file.
+  *                   Single producer, multi consumer ring of LM35 samples.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *
+  * History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  *
+  *
+  *
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+#ifndef INC_SAMPLERING_H_
+#define INC_SAMPLERING_H_
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "App.h"
+
+/******************************************************************************
+*							MACRO DEFINITION
+******************************************************************************/
+#define SAMPLE_RING_LEN         8           // Power of two, history a reader can lag
+#define SAMPLE_RING_MAX_READERS 4
+
+// Notification bit set on attached reader tasks for every new sample
+#define SAMPLE_RING_NOTIFY      (1UL << 30)
+
+/******************************************************************************
+*							DATA TYPE DECLARATION
+******************************************************************************/
+// One per consumer, owned and only used by that consumer
+typedef struct
+{
+    uint32_t next;              // Sequence number to read next
+    uint32_t lost;              // Samples overwritten before this reader got them
+    TaskHandle_t task;          // Notified on publish, NULL if not waiting
+} SampleReader_t;
+
+/******************************************************************************
+*							API DECLARATIONS
+******************************************************************************/
+
+// Producer only (LM35 task): stamps time and sequence and publishes
+void SampleRing_Publish(const LM35_Data_t *data);
+
+// Starts a reader at the next sample. With notify set the calling task
+// gets SAMPLE_RING_NOTIFY on every publish, see SampleRing_Wait().
+bool SampleRing_Attach(SampleReader_t *reader, bool notify);
+
+// Oldest unread sample, skipping (and counting in lost) what was overwritten
+bool SampleRing_Read(SampleReader_t *reader, LM35_Sample_t *sample);
+
+// Newest sample, the reader (may be NULL) moves past it
+bool SampleRing_Latest(SampleReader_t *reader, LM35_Sample_t *sample);
+
+// Waits for SAMPLE_RING_NOTIFY, false on timeout
+bool SampleRing_Wait(TickType_t timeout);
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
+
+#endif /* INC_SAMPLERING_H_ */
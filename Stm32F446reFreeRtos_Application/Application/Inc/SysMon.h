@@ -0,0 +1,84 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : SysMon.h
+  * @brief          : Header for SysMon.c file.
+  *                   Periodic per-task CPU load, stack and heap report.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *
+  * History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  * 	17-10-2026	-	PWR line with tickless idle statistics
+  * 	17-10-2026	-	POOL line per registered memory pool
+  * 	17-10-2026	-	URX line per UART receive port
+  * 	17-10-2026	-	RPC line with command channel statistics
+  * 	17-10-2026	-	GSM/MDM lines with modem command statistics
+  * 	17-10-2026	-	ALR line with alert batching statistics
+  * 	17-10-2026	-	SYSMON_MAX_TASKS sized from the App task table, TOVF line
+  *
+  *
+  *
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+#ifndef INC_SYSMON_H_
+#define INC_SYSMON_H_
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "App.h"
+
+/******************************************************************************
+*							MACRO DEFINITION
+******************************************************************************/
+#define SYSMON_PERIOD_MS        5000    // Report interval, must stay below the
+                                        // 71 min wrap of the 1 MHz counter
+// uxTaskGetSystemState() reports nothing at all when the array is too small,
+// so it holds every task: the App table plus the I2C bus, idle and timer tasks
+#define SYSMON_OTHER_TASKS      3
+#define SYSMON_MAX_TASKS        (APP_TASK_COUNT + SYSMON_OTHER_TASKS)
+#define SYSMON_TASK_STACK       256
+#define SYSMON_TASK_PRIORITY    1
+
+/******************************************************************************
+*							DATA TYPE DECLARATION
+******************************************************************************/
+
+/******************************************************************************
+*							API DECLARATIONS
+******************************************************************************/
+
+// Report task: prints the SYS/TSK lines below every SYSMON_PERIOD_MS
+//   SYS,<t_ms>,<window_us>,<heap_free>,<heap_min_free>,<log_dropped>
+//   TSK,<t_ms>,<name>,<cpu_permille>,<stack_hwm_words>,<priority>
+//   TOVF,<t_ms>,<tasks>,<max_tasks>   (instead of TSK lines, more tasks than SYSMON_MAX_TASKS)
+//   PWR,<t_ms>,<sleeps_per_s>,<ticks_avoided_per_s>,<asleep_permille>
+//   POOL,<t_ms>,<name>,<in_use>,<peak_in_use>,<blocks>,<exhausted>
+//   URX,<t_ms>,<port>,<bytes>,<dropped>,<events>,<errors>,<peak_fill>
+//   RPC,<t_ms>,<requests>,<errors>,<corrupt>,<avg_us>,<max_us>
+//   GSM,<t_ms>,<type>,<count>,<errors>,<timeouts>,<avg_ms>,<max_ms>
+//   MDM,<t_ms>,<ready>,<lines>,<commands>,<urcs>,<resets>,<overflows>
+//   ALR,<t_ms>,<events>,<batches>,<delivered>,<attempts>,<failures>,<pending>,<max_delivery_ms>
+void SysMon_Handler(void *params);
+
+// FreeRTOS run-time stats clock (portCONFIGURE_TIMER_FOR_RUN_TIME_STATS)
+void configureTimerForRunTimeStats(void);
+unsigned long getRunTimeCounterValue(void);
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
+
+#endif /* INC_SYSMON_H_ */
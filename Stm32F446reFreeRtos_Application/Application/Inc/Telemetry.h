@@ -0,0 +1,117 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Telemetry.h
+  * @brief          : Header for Telemetry.c file.
+  *                   Batched binary LM35 telemetry on USART1 (HC-05).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *
+  * History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  * 	17-10-2026	-	RPC frame types, Telemetry_Send shared with Rpc.c
+  * 	17-10-2026	-	Frames taken from xTelemetryFramePool
+  *
+  *
+  *
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+#ifndef INC_TELEMETRY_H_
+#define INC_TELEMETRY_H_
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "App.h"
+
+/******************************************************************************
+*							MACRO DEFINITION
+******************************************************************************/
+#define TELEMETRY_TASK_STACK        256
+#define TELEMETRY_TASK_PRIORITY     1
+
+#define TELEMETRY_BATCH_MAX         16      // Samples per frame
+#define TELEMETRY_FLUSH_MS          4000    // Max age of the oldest unsent sample
+#define TELEMETRY_FRAME_COUNT       3       // Frames in xTelemetryFramePool, one on the wire, one encoding per sender
+
+/*
+ * Frame on the wire: 0x00, COBS(payload), 0x00. Payload, little endian:
+ *
+ *   off  size  field
+ *     0     1  schema version (TELEMETRY_SCHEMA_VERSION)
+ *     1     1  frame type (TELEMETRY_TYPE_*)
+ *     2     2  frame sequence, +1 per frame sent, gaps = lost frames
+ *     4     4  sequence of the first sample (LM35_Sample_t.sequence)
+ *     8     4  tick of the first sample (ms)
+ *    12     2  samples the firmware skipped right before this frame
+ *    14     1  record count n, records hold consecutive samples
+ *    15   7*n  records
+ *   end     2  CRC-16/CCITT-FALSE over all bytes before it
+ *
+ * Sample record, version 1:
+ *     0     2  tick offset from the first sample (ms)
+ *     2     2  filtered ADC code, Q4
+ *     4     2  temperature, 0.01 C, signed
+ *     6     1  flags (TELEMETRY_FLAG_*)
+ *
+ * Any change to these layouts bumps TELEMETRY_SCHEMA_VERSION, and
+ * trace_host_tool/telemetry_decoder.py has to follow.
+ */
+#define TELEMETRY_SCHEMA_VERSION    1
+#define TELEMETRY_TYPE_SAMPLES      1
+#define TELEMETRY_TYPE_RPC_REQUEST  2       // Host to board, see Rpc.h
+#define TELEMETRY_TYPE_RPC_RESPONSE 3       // Board to host, see Rpc.h
+
+#define TELEMETRY_HEADER_LEN        15
+#define TELEMETRY_RECORD_LEN        7
+#define TELEMETRY_CRC_LEN           2
+#define TELEMETRY_PAYLOAD_MAX       (TELEMETRY_HEADER_LEN + (TELEMETRY_RECORD_LEN * TELEMETRY_BATCH_MAX) + TELEMETRY_CRC_LEN)
+#define TELEMETRY_FRAME_MAX         (COBS_ENCODED_MAX(TELEMETRY_PAYLOAD_MAX) + 2U)
+
+#define TELEMETRY_FLAG_ADC_TIMEOUT  (1U << 0)
+#define TELEMETRY_FLAG_DISCONNECTED (1U << 1)
+
+/******************************************************************************
+*							DATA TYPE DECLARATION
+******************************************************************************/
+
+/******************************************************************************
+*							API DECLARATIONS
+******************************************************************************/
+
+// Creates the USART1 TX lock, before any task sends
+bool Telemetry_Init(void);
+
+// Telemetry task: batches SampleRing samples and streams them on USART1
+void Telemetry_Handler(void *params);
+
+// Appends the CRC to payload[0..length) and sends it as one frame. payload
+// needs TELEMETRY_CRC_LEN spare bytes, length + CRC at most
+// TELEMETRY_PAYLOAD_MAX. The frame is encoded into an xTelemetryFramePool
+// block, so encoding overlaps the previous frame still on the wire. False if
+// the frame was dropped (no free block or link busy).
+bool Telemetry_Send(uint8_t *payload, uint32_t length);
+
+// Little endian field writers, return the bytes written
+uint32_t Telemetry_Put_U16(uint8_t *dst, uint16_t value);
+uint32_t Telemetry_Put_U32(uint8_t *dst, uint32_t value);
+
+// USART1 TX DMA finished (or failed), frees its frame, interrupt context
+void Telemetry_TxComplete_FromISR(void);
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
+
+#endif /* INC_TELEMETRY_H_ */
@@ -0,0 +1,82 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Trace.h
+  * @brief          : Header for Trace.c file.
+  *                   Binary trace records, the format string stays in the ELF
+  *                   and only its ID plus the raw arguments are sent.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *
+  * History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  *
+  *
+  *
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+#ifndef INC_TRACE_H_
+#define INC_TRACE_H_
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "App.h"
+
+/******************************************************************************
+*							MACRO DEFINITION
+******************************************************************************/
+#define TRACE_ENABLED       1
+#define TRACE_MAX_ARGS      8
+
+/*
+ * TRACE("LM35 adc=%u cdeg=%d", adc, cdeg);
+ *
+ * The format string is placed in the non-loaded .trace_fmt section (see the
+ * linker script), its offset in that section is the record ID. Arguments are
+ * sent as 32-bit words: integer conversions only (%d %i %u %x %X %c %p), no
+ * %s and no floating point. A pointer for %p must be cast to (uint32_t), the
+ * argument array does not convert pointers implicitly.
+ */
+#if TRACE_ENABLED
+#define TRACE(fmt, ...)                                                             \
+    do                                                                              \
+    {                                                                               \
+        static const char trace_fmt_str[] __attribute__((section(".trace_fmt"), used)) = fmt; \
+        const uint32_t trace_args[] = { 0, ##__VA_ARGS__ };                         \
+        _Static_assert((sizeof(trace_args) / sizeof(trace_args[0])) <= (TRACE_MAX_ARGS + 1U), \
+                       "TRACE: too many arguments");                                \
+        Trace_Record((uint16_t)(uintptr_t)trace_fmt_str, &trace_args[1],            \
+                     (sizeof(trace_args) / sizeof(trace_args[0])) - 1U);            \
+    } while (0)
+#else
+#define TRACE(fmt, ...)     do { } while (0)
+#endif
+
+/******************************************************************************
+*							DATA TYPE DECLARATION
+******************************************************************************/
+
+/******************************************************************************
+*							API DECLARATIONS
+******************************************************************************/
+
+// Encodes one record and queues it on the log transport, use TRACE() instead
+void Trace_Record(uint16_t id, const uint32_t *args, uint32_t nargs);
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
+
+#endif /* INC_TRACE_H_ */
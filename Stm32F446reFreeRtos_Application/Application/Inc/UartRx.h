@@ -0,0 +1,105 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : UartRx.h
+  * @brief          : Header for UartRx.c file.
+  *                   Circular DMA + IDLE line receive path for USART1/USART3.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *
+  * History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  * 	17-10-2026	-	UartRx_SetNotify for readers waiting on more than the port
+  *
+  *
+  *
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+#ifndef INC_UARTRX_H_
+#define INC_UARTRX_H_
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+// No App.h, the host loopback simulation builds UartRx.c against stubs
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/******************************************************************************
+*							MACRO DEFINITION
+******************************************************************************/
+// DMA ring per port. The half/full transfer interrupts hand over at most
+// UART_RX_DMA_LEN / 2 bytes at a time, 128 bytes = 11 ms at 115200 baud.
+#define UART_RX_DMA_LEN         256
+
+// Stream buffer per port, what a reader may fall behind before bytes drop
+#define UART_RX_STREAM_LEN      1024
+
+/******************************************************************************
+*							DATA TYPE DECLARATION
+******************************************************************************/
+typedef enum
+{
+    UART_RX_BT = 0,             // USART1, HC-05 Bluetooth
+    UART_RX_GSM,                // USART3, SIM800 GSM
+    UART_RX_PORT_COUNT
+} UartRxPort_t;
+
+typedef struct
+{
+    uint32_t bytes;             // Delivered into the stream buffer
+    uint32_t dropped;           // Stream buffer full, the reader fell behind
+    uint32_t events;            // Half/full transfer and IDLE interrupts
+    uint32_t errors;            // Overrun/noise/framing, reception restarted
+    uint32_t peak_fill;         // Most bytes ever waiting in the stream buffer
+} UartRxStats_t;
+
+/******************************************************************************
+*							API DECLARATIONS
+******************************************************************************/
+
+// Create the stream buffers and start reception on both ports
+bool UartRx_Init(void);
+
+// Blocks up to timeout for the first byte, returns what was available.
+// One reader task per port, stream buffers have a single reader.
+size_t UartRx_Read(UartRxPort_t port, uint8_t *data, size_t length, TickType_t timeout);
+
+// Drops everything waiting in the stream buffer of the port
+void UartRx_Flush(UartRxPort_t port);
+
+// Every delivery also sets bits in the notification value of task, for a
+// reader that blocks on its own notification (more than one wake source)
+// and reads with timeout 0. A blocking UartRx_Read would clear the pending
+// notification, so such a reader must never block in it.
+void UartRx_SetNotify(UartRxPort_t port, TaskHandle_t task, uint32_t bits);
+
+void UartRx_GetStats(UartRxPort_t port, UartRxStats_t *stats);
+const char *UartRx_Name(UartRxPort_t port);
+
+// Called from HAL_UARTEx_RxEventCallback / HAL_UART_ErrorCallback, other
+// UART handles are ignored
+void UartRx_Event_FromISR(UART_HandleTypeDef *huart, uint16_t position);
+void UartRx_Error_FromISR(UART_HandleTypeDef *huart);
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
+
+#endif /* INC_UARTRX_H_ */
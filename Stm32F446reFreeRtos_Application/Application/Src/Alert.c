@@ -0,0 +1,613 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Alert.c
+  * @brief          : Store-and-forward alerts for the LM35 faults.
+  *
+  * The alert task is a health observer. Every change of an ALERT_FAULTS bit
+  * goes into the open batch, which only counts the changes per fault (and
+  * the peak temperature while over temperature), so a flapping fault costs
+  * no memory. The first change opens the coalescing window; when it closes
+  * the batch becomes one alert text, sent as a single SMS or as one TCP
+  * payload over GPRS through the GSM command queue.
+  *
+  * The text is kept until the modem confirms it. A failed attempt is
+  * retried with a doubling wait, a modem restart (GSM_RESET) retries as
+  * soon as the modem is ready again. Changes arriving meanwhile collect in
+  * the next batch, at most one batch waits and one is open.
+  *
+  * Send results come from the GSM task (done callbacks, "CONNECT" URC)
+  * through alert_send, and wake the alert task with Health_Wake. Otherwise
+  * it only wakes for fault changes and its own deadlines (window, retry,
+  * connect timeout), plus the peak sampling while over temperature.
+  * A send is not held back while the modem restarts, the GSM queue keeps
+  * the command until the modem is ready.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  * 	17-10-2026	-	Woken by send results, waits on deadlines instead of polling
+  *
+  *
+  *
+  ******************************************************************************
+  */
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "Alert.h"
+#include "App.h"
+/******************************************************************************
+*							GLOBAL VARIABLES
+******************************************************************************/
+#define ALERT_FAULT_COUNT       3
+#define ALERT_SMS_TIMEOUT_MS    60000   // SIM800: up to 60 s for +CMGS
+#define ALERT_CIPSTART          "+CIPSTART=\"TCP\",\"" ALERT_GPRS_HOST "\"," ALERT_GPRS_PORT
+
+typedef enum
+{
+    ALERT_SEND_IDLE = 0,        // Nothing of ours on the modem
+    ALERT_SEND_BUSY,            // A command is queued, its done callback follows
+    ALERT_SEND_CONNECTING,      // GPRS, waiting for "CONNECT OK"
+    ALERT_SEND_DELIVERED,
+    ALERT_SEND_FAILED,
+    ALERT_SEND_RESET,           // The modem restarted under the command
+} AlertSend_t;
+
+typedef struct
+{
+    bool open;
+    TickType_t opened;          // First change of the batch
+    uint16_t raised[ALERT_FAULT_COUNT];
+    uint16_t cleared[ALERT_FAULT_COUNT];
+    int32_t peak_cdeg;          // While over temperature
+    bool peak_valid;
+} AlertBatch_t;
+
+typedef struct
+{
+    EventBits_t fault;
+    const char *name;
+} AlertFault_t;
+
+typedef struct
+{
+    const char *text;
+    const char *prefix;
+    uint32_t timeout_ms;
+} AlertStep_t;
+
+static AlertConfig_t alert_config = {
+    .window_s = ALERT_WINDOW_DEFAULT_S,
+    .channel = ALERT_CHANNEL_SMS
+};
+static AlertStats_t alert_stats;
+
+// Batch collecting changes
+static AlertBatch_t alert_batch;
+
+// Batch waiting for delivery, the GSM task reads the text while a send runs
+static char alert_text[ALERT_TEXT_MAX + 1];
+static uint16_t alert_text_len;
+static bool alert_waiting;
+static TickType_t alert_waiting_since;      // First change of that batch
+static TickType_t alert_retry_at;
+static uint32_t alert_backoff_ms = ALERT_RETRY_MIN_MS;
+static uint32_t alert_sequence;
+
+// Written by both tasks, see Alert_Finish
+static volatile AlertSend_t alert_send;
+static volatile TickType_t alert_connect_at;
+static HealthObserver_t alert_observer;
+
+/******************************************************************************
+*							LOCAL FUNCTION DECLARATIONS
+******************************************************************************/
+static TickType_t Alert_Wait(EventBits_t faults, TickType_t now);
+static void Alert_Record(EventBits_t before, EventBits_t after, TickType_t now);
+static void Alert_Peak(void);
+static void Alert_Collect(TickType_t now);
+static void Alert_Forward(EventBits_t faults, TickType_t now);
+static void Alert_Format(EventBits_t faults, TickType_t now);
+static void Alert_Start(void);
+static void Alert_Finish(AlertSend_t outcome);
+static void Alert_Wake(void);
+static bool Alert_Submit_Step(uint32_t step, GsmDone_t done);
+static void Alert_Sms_Done(const GsmResult_t *result, void *context);
+static void Alert_Gprs_Done(const GsmResult_t *result, void *context);
+static void Alert_Connect_Urc(uint8_t argc, const char *const *argv, void *context);
+
+/******************************************************************************
+*							CONST DECLARATIONS
+******************************************************************************/
+static const AlertFault_t alert_faults[ALERT_FAULT_COUNT] =
+{
+    { HEALTH_OVER_TEMPERATURE,    "OVERTEMP" },
+    { HEALTH_SENSOR_DISCONNECTED, "SENSOR"   },
+    { HEALTH_ADC_TIMEOUT,         "ADC"      },
+};
+
+// SIM800 single connection TCP: bearer up, connect, one payload.
+// Every attempt starts from AT+CIPSHUT, so a half-open session never matters.
+#define ALERT_STEP_CONNECT      4
+#define ALERT_STEP_SEND         5
+
+static const AlertStep_t alert_gprs_steps[] =
+{
+    { "+CIPSHUT",                        NULL,        65000 },  // "SHUT OK"
+    { "+CSTT=\"" ALERT_GPRS_APN "\"",    NULL,        1000  },
+    { "+CIICR",                          NULL,        85000 },
+    { "+CIFSREX",                        "+CIFSREX:", 1000  },
+    { ALERT_CIPSTART,                    NULL,        5000  },  // OK, then "CONNECT OK"
+    { "+CIPSEND=",                       NULL,        10000 },  // Length appended, "SEND OK"
+};
+
+_Static_assert(sizeof(ALERT_CIPSTART) <= GSM_CMD_TEXT_MAX, "Alert: GPRS host does not fit a command");
+_Static_assert(sizeof("+CMGS=\"" ALERT_SMS_NUMBER "\"") <= GSM_CMD_TEXT_MAX, "Alert: SMS number does not fit a command");
+_Static_assert((HEALTH_OVER_TEMPERATURE | HEALTH_SENSOR_DISCONNECTED | HEALTH_ADC_TIMEOUT) == ALERT_FAULTS,
+               "Alert: alert_faults does not match ALERT_FAULTS");
+
+/******************************************************************************
+*							API IMPLEMENTATION
+******************************************************************************/
+void Alert_Handler(void *params)
+{
+    HealthObserver_t observer = Health_Observe();
+    EventBits_t faults = 0;
+
+    alert_observer = observer;
+    if (observer == 0)
+    {
+        printf("Alert: no health observer left, polling\r\n");
+    }
+    if (!Gsm_Subscribe("CONNECT", Alert_Connect_Urc, NULL))
+    {
+        printf("Alert: no GSM URC slot left, GPRS alerts will fail\r\n");
+    }
+
+    while (1)
+    {
+        TickType_t wait = Alert_Wait(faults, xTaskGetTickCount());
+        EventBits_t current;
+
+        if (observer != 0)
+        {
+            current = Health_Wait(observer, wait, NULL);
+        }
+        else
+        {
+            vTaskDelay((wait < pdMS_TO_TICKS(ALERT_POLL_MS)) ? wait : pdMS_TO_TICKS(ALERT_POLL_MS));
+            current = Health_Get();
+        }
+
+        TickType_t now = xTaskGetTickCount();
+        current &= ALERT_FAULTS;
+        if (current != faults)
+        {
+            Alert_Record(faults, current, now);
+            faults = current;
+        }
+        if (faults & HEALTH_OVER_TEMPERATURE)
+        {
+            Alert_Peak();
+        }
+
+        Alert_Collect(now);
+        Alert_Forward(faults, now);
+    }
+}
+
+bool Alert_SetConfig(const AlertConfig_t *config)
+{
+    if ((config->window_s < ALERT_WINDOW_MIN_S) || (config->window_s > ALERT_WINDOW_MAX_S) ||
+        (config->channel >= ALERT_CHANNEL_COUNT))
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    alert_config = *config;
+    taskEXIT_CRITICAL();
+    return true;
+}
+
+void Alert_GetConfig(AlertConfig_t *config)
+{
+    taskENTER_CRITICAL();
+    *config = alert_config;
+    taskEXIT_CRITICAL();
+}
+
+void Alert_GetStats(AlertStats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = alert_stats;
+    taskEXIT_CRITICAL();
+}
+
+
+/******************************************************************************
+*							LOCAL FUNCTION DEFINITIONS
+******************************************************************************/
+// Until the next deadline: the window closing, the retry time or the
+// "CONNECT OK" timeout. A result already in is collected at once, one still
+// to come wakes the task. Nothing pending waits for the next fault change.
+static TickType_t Alert_Wait(EventBits_t faults, TickType_t now)
+{
+    TickType_t wait = portMAX_DELAY;
+    AlertSend_t send = alert_send;
+
+    if (alert_batch.open && !alert_waiting)
+    {
+        AlertConfig_t config;
+        Alert_GetConfig(&config);
+
+        TickType_t window = pdMS_TO_TICKS((uint32_t)config.window_s * 1000U);
+        TickType_t elapsed = now - alert_batch.opened;
+        wait = (elapsed < window) ? (window - elapsed) : 0;
+    }
+
+    if (alert_waiting && ((send == ALERT_SEND_IDLE) || (send == ALERT_SEND_CONNECTING)))
+    {
+        TickType_t deadline = (send == ALERT_SEND_IDLE) ? alert_retry_at
+                                                        : (alert_connect_at + pdMS_TO_TICKS(ALERT_CONNECT_TIMEOUT_MS));
+        TickType_t left = ((int32_t)(deadline - now) > 0) ? (deadline - now) : 0;
+
+        wait = (left < wait) ? left : wait;
+    }
+    else if ((send != ALERT_SEND_IDLE) && (send != ALERT_SEND_BUSY))
+    {
+        wait = 0;
+    }
+
+    if ((faults & HEALTH_OVER_TEMPERATURE) && (wait > pdMS_TO_TICKS(ALERT_PEAK_MS)))
+    {
+        wait = pdMS_TO_TICKS(ALERT_PEAK_MS);
+    }
+    return wait;
+}
+
+static void Alert_Record(EventBits_t before, EventBits_t after, TickType_t now)
+{
+    EventBits_t changed = before ^ after;
+    uint32_t events = 0;
+
+    if (!alert_batch.open)
+    {
+        memset(&alert_batch, 0, sizeof(alert_batch));
+        alert_batch.open = true;
+        alert_batch.opened = now;
+    }
+
+    for (uint32_t i = 0; i < ALERT_FAULT_COUNT; i++)
+    {
+        if ((changed & alert_faults[i].fault) == 0)
+        {
+            continue;
+        }
+        if (after & alert_faults[i].fault)
+        {
+            alert_batch.raised[i] += (alert_batch.raised[i] < UINT16_MAX) ? 1U : 0U;
+        }
+        else
+        {
+            alert_batch.cleared[i] += (alert_batch.cleared[i] < UINT16_MAX) ? 1U : 0U;
+        }
+        events++;
+    }
+
+    taskENTER_CRITICAL();
+    alert_stats.events += events;
+    taskEXIT_CRITICAL();
+}
+
+static void Alert_Peak(void)
+{
+    LM35_Data_t data;
+
+    if (alert_batch.open && LM35_GetData(&data) && !data.adc_timeout_error &&
+        (!alert_batch.peak_valid || (data.temperature_cdeg > alert_batch.peak_cdeg)))
+    {
+        alert_batch.peak_cdeg = data.temperature_cdeg;
+        alert_batch.peak_valid = true;
+    }
+}
+
+// Result of the running send, if there is one
+static void Alert_Collect(TickType_t now)
+{
+    AlertSend_t send = alert_send;
+
+    if (send == ALERT_SEND_CONNECTING)
+    {
+        // The modem restarted and will never connect, or no "CONNECT OK" in time
+        if (!Gsm_IsReady())
+        {
+            Alert_Finish(ALERT_SEND_RESET);
+        }
+        else if ((now - alert_connect_at) >= pdMS_TO_TICKS(ALERT_CONNECT_TIMEOUT_MS))
+        {
+            Alert_Finish(ALERT_SEND_FAILED);
+        }
+        send = alert_send;
+    }
+
+    switch (send)
+    {
+    case ALERT_SEND_DELIVERED:
+    {
+        uint32_t delivery_ms = (uint32_t)((now - alert_waiting_since) * portTICK_PERIOD_MS);
+
+        alert_waiting = false;
+        alert_backoff_ms = ALERT_RETRY_MIN_MS;
+
+        taskENTER_CRITICAL();
+        alert_stats.delivered++;
+        if (delivery_ms > alert_stats.max_delivery_ms)
+        {
+            alert_stats.max_delivery_ms = delivery_ms;
+        }
+        taskEXIT_CRITICAL();
+        break;
+    }
+
+    case ALERT_SEND_FAILED:
+        alert_retry_at = now + pdMS_TO_TICKS(alert_backoff_ms);
+        alert_backoff_ms = ((alert_backoff_ms * 2U) < ALERT_RETRY_MAX_MS) ? (alert_backoff_ms * 2U)
+                                                                          : ALERT_RETRY_MAX_MS;
+        taskENTER_CRITICAL();
+        alert_stats.failures++;
+        taskEXIT_CRITICAL();
+        break;
+
+    case ALERT_SEND_RESET:
+        // Not the destination's fault, again once the modem is back
+        alert_retry_at = now;
+        break;
+
+    default:
+        return;
+    }
+
+    alert_send = ALERT_SEND_IDLE;
+}
+
+static void Alert_Forward(EventBits_t faults, TickType_t now)
+{
+    AlertConfig_t config;
+
+    Alert_GetConfig(&config);
+
+    // Window over: the batch becomes the alert text, unless the previous
+    // one is still waiting, then it goes right after that one
+    if (alert_batch.open && !alert_waiting &&
+        ((now - alert_batch.opened) >= pdMS_TO_TICKS((uint32_t)config.window_s * 1000U)))
+    {
+        Alert_Format(faults, now);
+        alert_waiting = true;
+        alert_waiting_since = alert_batch.opened;
+        alert_retry_at = now;
+        alert_batch.open = false;
+
+        taskENTER_CRITICAL();
+        alert_stats.batches++;
+        taskEXIT_CRITICAL();
+    }
+
+    if (alert_waiting && (alert_send == ALERT_SEND_IDLE) &&
+        ((int32_t)(now - alert_retry_at) >= 0))
+    {
+        Alert_Start();
+    }
+
+    taskENTER_CRITICAL();
+    alert_stats.pending = (uint32_t)alert_waiting + (uint32_t)alert_batch.open;
+    taskEXIT_CRITICAL();
+}
+
+// "LM35 alert 3, up 5123 s; OVERTEMP 2x, now ACTIVE, peak 61.5 C; SENSOR now OK"
+static void Alert_Format(EventBits_t faults, TickType_t now)
+{
+    int len = snprintf(alert_text, sizeof(alert_text), "LM35 alert %lu, up %lu s",
+                       (unsigned long)++alert_sequence,
+                       (unsigned long)((now * portTICK_PERIOD_MS) / 1000U));
+
+    for (uint32_t i = 0; (i < ALERT_FAULT_COUNT) && (len < (int)sizeof(alert_text)); i++)
+    {
+        if ((alert_batch.raised[i] == 0) && (alert_batch.cleared[i] == 0))
+        {
+            continue;
+        }
+
+        len += snprintf(&alert_text[len], sizeof(alert_text) - len, "; %s", alert_faults[i].name);
+        if ((alert_batch.raised[i] > 0) && (len < (int)sizeof(alert_text)))
+        {
+            len += snprintf(&alert_text[len], sizeof(alert_text) - len, " %ux,", alert_batch.raised[i]);
+        }
+        if (len < (int)sizeof(alert_text))
+        {
+            len += snprintf(&alert_text[len], sizeof(alert_text) - len, " now %s",
+                            (faults & alert_faults[i].fault) ? "ACTIVE" : "OK");
+        }
+        if ((alert_faults[i].fault == HEALTH_OVER_TEMPERATURE) && alert_batch.peak_valid &&
+            (len < (int)sizeof(alert_text)))
+        {
+            // Round centi-degrees to one decimal, integer formatting only
+            int32_t ddeg = (alert_batch.peak_cdeg >= 0) ? ((alert_batch.peak_cdeg + 5) / 10)
+                                                        : ((alert_batch.peak_cdeg - 5) / 10);
+
+            len += snprintf(&alert_text[len], sizeof(alert_text) - len, ", peak %s%ld.%ld C",
+                            (ddeg < 0) ? "-" : "", (long)(labs(ddeg) / 10), (long)(labs(ddeg) % 10));
+        }
+    }
+
+    // Truncated rather than split, one SMS per batch
+    alert_text_len = (len < (int)sizeof(alert_text)) ? (uint16_t)len : ALERT_TEXT_MAX;
+}
+
+static void Alert_Start(void)
+{
+    AlertConfig_t config;
+    bool queued;
+
+    Alert_GetConfig(&config);
+
+    // Before the submit, the GSM task may answer before it returns
+    alert_send = ALERT_SEND_BUSY;
+
+    if (config.channel == ALERT_CHANNEL_GPRS)
+    {
+        queued = Alert_Submit_Step(0, Alert_Gprs_Done);
+    }
+    else
+    {
+        GsmCommand_t command = {
+            .text = "+CMGS=\"" ALERT_SMS_NUMBER "\"",
+            .prefix = "+CMGS:",
+            .payload = (const uint8_t *)alert_text,
+            .payload_len = alert_text_len,
+            .type = GSM_TYPE_SMS,
+            .flags = GSM_FLAG_CTRL_Z,
+            .timeout_ms = ALERT_SMS_TIMEOUT_MS,
+            .done = Alert_Sms_Done,
+        };
+        queued = Gsm_Submit(&command, 0);
+    }
+
+    taskENTER_CRITICAL();
+    alert_stats.attempts++;
+    taskEXIT_CRITICAL();
+
+    if (!queued)
+    {
+        // Command queue full, back off like any other failure
+        alert_send = ALERT_SEND_FAILED;
+    }
+}
+
+// Ends the running send, GSM task or alert task
+static void Alert_Finish(AlertSend_t outcome)
+{
+    taskENTER_CRITICAL();
+    if ((alert_send == ALERT_SEND_BUSY) || (alert_send == ALERT_SEND_CONNECTING))
+    {
+        alert_send = outcome;
+    }
+    taskEXIT_CRITICAL();
+
+    Alert_Wake();
+}
+
+// The alert task re-reads alert_send and works out its wait again
+static void Alert_Wake(void)
+{
+    Health_Wake(alert_observer);
+}
+
+static bool Alert_Submit_Step(uint32_t step, GsmDone_t done)
+{
+    const AlertStep_t *entry = &alert_gprs_steps[step];
+    GsmCommand_t command = {
+        .prefix = entry->prefix,
+        .type = GSM_TYPE_GPRS,
+        .timeout_ms = entry->timeout_ms,
+        .done = done,
+        .context = (void *)(uintptr_t)step,
+    };
+
+    if (step == ALERT_STEP_SEND)
+    {
+        snprintf(command.text, sizeof(command.text), "%s%u", entry->text, alert_text_len);
+        command.payload = (const uint8_t *)alert_text;
+        command.payload_len = alert_text_len;
+    }
+    else
+    {
+        strcpy(command.text, entry->text);
+    }
+
+    return Gsm_Submit(&command, 0);
+}
+
+static void Alert_Sms_Done(const GsmResult_t *result, void *context)
+{
+    Alert_Finish((result->status == GSM_OK)    ? ALERT_SEND_DELIVERED :
+                 (result->status == GSM_RESET) ? ALERT_SEND_RESET : ALERT_SEND_FAILED);
+}
+
+// GSM task: next step of the GPRS sequence
+static void Alert_Gprs_Done(const GsmResult_t *result, void *context)
+{
+    uint32_t step = (uint32_t)(uintptr_t)context;
+
+    if (result->status != GSM_OK)
+    {
+        Alert_Finish((result->status == GSM_RESET) ? ALERT_SEND_RESET : ALERT_SEND_FAILED);
+        return;
+    }
+
+    if (step == ALERT_STEP_SEND)
+    {
+        Alert_Finish(ALERT_SEND_DELIVERED);
+
+        // Bearer down again, nobody waits for the result
+        Alert_Submit_Step(0, NULL);
+        return;
+    }
+
+    if (step == ALERT_STEP_CONNECT)
+    {
+        taskENTER_CRITICAL();
+        if (alert_send == ALERT_SEND_BUSY)
+        {
+            alert_connect_at = xTaskGetTickCount();
+            alert_send = ALERT_SEND_CONNECTING;
+        }
+        taskEXIT_CRITICAL();
+
+        // Now waiting on the connect timeout
+        Alert_Wake();
+        return;
+    }
+
+    if (!Alert_Submit_Step(step + 1, Alert_Gprs_Done))
+    {
+        Alert_Finish(ALERT_SEND_FAILED);
+    }
+}
+
+// GSM task: "CONNECT OK" / "CONNECT FAIL" after AT+CIPSTART
+static void Alert_Connect_Urc(uint8_t argc, const char *const *argv, void *context)
+{
+    bool connected = (strcmp(argv[0], "CONNECT OK") == 0);
+    bool send = false;
+
+    taskENTER_CRITICAL();
+    if (alert_send == ALERT_SEND_CONNECTING)
+    {
+        alert_send = connected ? ALERT_SEND_BUSY : ALERT_SEND_FAILED;
+        send = connected;
+    }
+    taskEXIT_CRITICAL();
+
+    Alert_Wake();
+
+    if (send && !Alert_Submit_Step(ALERT_STEP_SEND, Alert_Gprs_Done))
+    {
+        Alert_Finish(ALERT_SEND_FAILED);
+    }
+}
+
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
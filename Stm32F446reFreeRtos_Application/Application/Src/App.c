@@ -15,6 +15,23 @@
   *
   *History: v01
   * 	17-07-2025	-	v01	- Initial version
+  * 	17-10-2026	-	I2C3 bus manager task created before its clients
+  * 	17-10-2026	-	Console output goes through the USART2 DMA log ring
+  * 	17-10-2026	-	SysMon task reports per-task CPU load, stack and heap
+  * 	17-10-2026	-	Static idle/timer task memory for the native FreeRTOS API
+  * 	17-10-2026	-	Tasks and queues created from static tables, no heap use
+  * 	17-10-2026	-	Fixed-block pools for sensor records and LCD frames
+  * 	17-10-2026	-	LED queue and temperature mailbox replaced by the SampleRing
+  * 	17-10-2026	-	Health event group created before the tasks
+  * 	17-10-2026	-	LED task replaced by the Led_Init pattern timer
+  * 	17-10-2026	-	USART1/USART3 DMA receive started, RX event callbacks
+  * 	17-10-2026	-	Telemetry task streaming samples on USART1
+  * 	17-10-2026	-	RPC task answering runtime commands on USART1
+  * 	17-10-2026	-	GSM task running the SIM800 AT command engine on USART3
+  * 	17-10-2026	-	Alert task forwarding LM35 faults by SMS/GPRS
+  * 	17-10-2026	-	Malloc failed hook, lost with cmsis_os2.c
+  * 	17-10-2026	-	Telemetry frame pool
+  * 	17-10-2026	-	UART receive restarted on receive errors only
   *
   *
   *
@@ -30,10 +47,39 @@
 /******************************************************************************
 *							GLOBAL VARIABLES
 ******************************************************************************/
-extern UART_HandleTypeDef huart2;
+// Message payload pools
+MEMPOOL_DEFINE(xLcdFramePool, "LcdFrame", sizeof(LcdFrame_t), LCD_FRAME_COUNT);
+MEMPOOL_DEFINE(xTelemetryFramePool, "TlmFrame", TELEMETRY_FRAME_MAX, TELEMETRY_FRAME_COUNT);
+
+typedef struct
+{
+    TaskFunction_t entry;
+    const char *name;
+    uint32_t stack_depth;           // Words
+    UBaseType_t priority;
+    StackType_t *stack;
+    StaticTask_t *tcb;
+} AppTask_t;
+
+#define APP_LM35_STACK          128
+#define APP_LCD_STACK           512
+
+static StackType_t app_lm35_stack[APP_LM35_STACK] APP_STACK;
+static StackType_t app_lcd_stack[APP_LCD_STACK] APP_STACK;
+static StackType_t app_sysmon_stack[SYSMON_TASK_STACK] APP_STACK;
+static StackType_t app_telemetry_stack[TELEMETRY_TASK_STACK] APP_STACK;
+static StackType_t app_rpc_stack[RPC_TASK_STACK] APP_STACK;
+static StackType_t app_gsm_stack[GSM_TASK_STACK] APP_STACK;
+static StackType_t app_alert_stack[ALERT_TASK_STACK] APP_STACK;
+static StaticTask_t app_lm35_tcb;
+static StaticTask_t app_lcd_tcb;
+static StaticTask_t app_sysmon_tcb;
+static StaticTask_t app_telemetry_tcb;
+static StaticTask_t app_rpc_tcb;
+static StaticTask_t app_gsm_tcb;
+static StaticTask_t app_alert_tcb;
+
 
-QueueHandle_t xLedModeQueue = NULL;
-QueueHandle_t xTempQueue    = NULL;
 /******************************************************************************
 *							LOCAL FUNCTION DECLARATIONS
 ******************************************************************************/
@@ -43,6 +89,21 @@ static void App_Init(void);
 /******************************************************************************
 *							CONST DECLARATIONS
 ******************************************************************************/
+// Created in order, every entry gets its stack and control block from above
+static const AppTask_t app_tasks[] =
+{
+    { LM35_Handler,      "LM35",   APP_LM35_STACK,       2,                       app_lm35_stack,      &app_lm35_tcb      },
+    { Lcd16x2_Handler,   "LCD",    APP_LCD_STACK,        1,                       app_lcd_stack,       &app_lcd_tcb       },
+    { SysMon_Handler,    "SysMon", SYSMON_TASK_STACK,    SYSMON_TASK_PRIORITY,    app_sysmon_stack,    &app_sysmon_tcb    },
+    { Telemetry_Handler, "Telem",  TELEMETRY_TASK_STACK, TELEMETRY_TASK_PRIORITY, app_telemetry_stack, &app_telemetry_tcb },
+    { Rpc_Handler,       "RPC",    RPC_TASK_STACK,       RPC_TASK_PRIORITY,       app_rpc_stack,       &app_rpc_tcb       },
+    { Gsm_Handler,       "GSM",    GSM_TASK_STACK,       GSM_TASK_PRIORITY,       app_gsm_stack,       &app_gsm_tcb       },
+    { Alert_Handler,     "Alert",  ALERT_TASK_STACK,     ALERT_TASK_PRIORITY,     app_alert_stack,     &app_alert_tcb     },
+};
+
+// SysMon sizes its task status array from this count
+_Static_assert((sizeof(app_tasks) / sizeof(app_tasks[0])) == APP_TASK_COUNT,
+               "APP_TASK_COUNT does not match app_tasks[]");
 
 /******************************************************************************
 *							API IMPLEMENTATION
@@ -65,40 +126,113 @@ void App_Run(void)
 // Create tasks
 void App_Init(void)
 {
-    // Create Queues
-    xLedModeQueue = xQueueCreate(5, sizeof(LedMode_t));
-    if (xLedModeQueue == NULL)
+    MemPool_Init(&xLcdFramePool);
+    MemPool_Init(&xTelemetryFramePool);
+
+    if (!Health_Init())
+    {
+        printf("Failed to create health event group!\r\n");
+    }
+
+    // Status LED runs from a software timer, no task of its own
+    if (!Led_Init())
+    {
+        printf("Failed to start LED pattern timer!\r\n");
+    }
+
+    // Shared I2C3 bus, must exist before any of its clients run
+    if (!I2cBus_Init())
     {
-        printf("Failed to create LED queue!\r\n");
+        printf("Failed to create I2C bus manager!\r\n");
     }
 
-    xTempQueue = xQueueCreate(5, sizeof(float));
-    if (xTempQueue == NULL)
+    // USART1/USART3 receive into their stream buffers from here on
+    if (!UartRx_Init())
     {
-        printf("Failed to create temperature queue!\r\n");
+        printf("Failed to start UART receive DMA!\r\n");
     }
 
-    // Create Tasks with adjusted priorities and stack
-    BaseType_t status;
+    // USART1 TX is shared by the telemetry frames and the RPC responses
+    if (!Telemetry_Init())
+    {
+        printf("Failed to create telemetry TX lock!\r\n");
+    }
 
-    status = xTaskCreate(Led_Handler, "LED", 128, NULL, 1, NULL);
-    if (status != pdPASS) printf("LED Task creation failed!\r\n");
+    // SIM800 command queue, tasks may submit before the GSM task runs
+    if (!Gsm_Init())
+    {
+        printf("Failed to create GSM command queue!\r\n");
+    }
 
-    status = xTaskCreate(LM35_Handler, "LM35", 128, NULL, 2, NULL);  // Highest priority
-    if (status != pdPASS) printf("LM35 Task creation failed!\r\n");
+    // Create Tasks, LM35 has the highest priority
+    for (uint32_t i = 0; i < sizeof(app_tasks) / sizeof(app_tasks[0]); i++)
+    {
+        const AppTask_t *task = &app_tasks[i];
 
-    status = xTaskCreate(Lcd16x2_Handler, "LCD", 512, NULL, 1, NULL);  // Increased stack
-    if (status != pdPASS) printf("LCD Task creation failed!\r\n");
+        if (xTaskCreateStatic(task->entry, task->name, task->stack_depth, NULL,
+                              task->priority, task->stack, task->tcb) == NULL)
+        {
+            printf("%s Task creation failed!\r\n", task->name);
+        }
+    }
 }
 
 
 
 int __io_putchar(int ch) {
-    HAL_UART_Transmit(&huart2, (uint8_t *)&ch, 1, HAL_MAX_DELAY);
+    char c = (char)ch;
+    Log_Write(&c, 1);
     return ch;
 }
 
 
+/* HAL UART callbacks, shared by every UART user */
+
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+    if (huart->Instance == USART2)
+    {
+        Log_TxComplete_FromISR();
+    }
+    else if (huart->Instance == USART1)
+    {
+        Telemetry_TxComplete_FromISR();
+    }
+    else if (huart->Instance == USART3)
+    {
+        Gsm_TxComplete_FromISR();
+    }
+}
+
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+    if ((huart->Instance == USART2) && (huart->ErrorCode & HAL_UART_ERROR_DMA))
+    {
+        // TX DMA aborted, the run is lost, restart from the next one
+        Log_TxComplete_FromISR();
+    }
+    else if ((huart->Instance == USART1) && (huart->ErrorCode & HAL_UART_ERROR_DMA))
+    {
+        // TX DMA aborted, that telemetry frame is lost
+        Telemetry_TxComplete_FromISR();
+    }
+
+    // USART1/USART3 receive errors abort the RX DMA, UartRx restarts it. A
+    // TX DMA error leaves the reception running and must not restart it.
+    if ((huart->ErrorCode & (HAL_UART_ERROR_ORE | HAL_UART_ERROR_FE | HAL_UART_ERROR_NE | HAL_UART_ERROR_PE)) ||
+        ((huart->ErrorCode & HAL_UART_ERROR_DMA) && (huart->hdmarx != NULL) &&
+         (huart->hdmarx->ErrorCode != HAL_DMA_ERROR_NONE)))
+    {
+        UartRx_Error_FromISR(huart);
+    }
+}
+
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+    UartRx_Event_FromISR(huart, Size);
+}
+
+
 /* RTOS - Hooks */
 
 void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
@@ -114,6 +248,40 @@ void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
     }
 }
 
+// configUSE_MALLOC_FAILED_HOOK defaults to 1 in this FreeRTOS.h, the weak
+// default came from cmsis_os2.c before it was dropped from the build
+void vApplicationMallocFailedHook(void)
+{
+    // The caller gets NULL and handles it, only report it
+    printf("Heap allocation failed!\r\n");
+}
+
+// configSUPPORT_STATIC_ALLOCATION, was provided by cmsis_os2.c before it was
+// dropped from the build
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer,
+                                   StackType_t **ppxIdleTaskStackBuffer,
+                                   uint32_t *pulIdleTaskStackSize)
+{
+    static StaticTask_t idle_tcb;
+    static StackType_t idle_stack[configMINIMAL_STACK_SIZE] APP_STACK;
+
+    *ppxIdleTaskTCBBuffer = &idle_tcb;
+    *ppxIdleTaskStackBuffer = idle_stack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer,
+                                    StackType_t **ppxTimerTaskStackBuffer,
+                                    uint32_t *pulTimerTaskStackSize)
+{
+    static StaticTask_t timer_tcb;
+    static StackType_t timer_stack[configTIMER_TASK_STACK_DEPTH] APP_STACK;
+
+    *ppxTimerTaskTCBBuffer = &timer_tcb;
+    *ppxTimerTaskStackBuffer = timer_stack;
+    *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+
 
 
 
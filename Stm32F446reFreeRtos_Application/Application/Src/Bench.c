@@ -0,0 +1,326 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Bench.c
+  * @brief          : Kernel primitive latency benchmark, measured with the DWT
+  *                   cycle counter (180 MHz, one count per core clock).
+  *
+  * A runner task drives each test against an echo task one priority above it,
+  * so every wake of the echo task is an immediate preemption. Round trip tests
+  * are timed by the runner, one way tests stamp DWT->CYCCNT before the wake
+  * and the echo task takes the difference once it runs. With lazy FPU
+  * stacking a task only pays for saving s16-s31 once it has used the FPU, the
+  * FPU switch test runs last because after it both tasks carry the extended
+  * frame for good.
+  * trace_host_tool/kernel_bench builds this file on the FreeRTOS POSIX port.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  * 	17-10-2026	-	Runner/echo test suite with p99 and histograms
+  * 	17-10-2026	-	Host build on the POSIX port (trace_host_tool/kernel_bench)
+  * 	17-10-2026	-	Static tasks and queues, compiled out unless BENCH_ENABLED
+  *
+  *
+  ******************************************************************************
+  */
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "Bench.h"
+#include "App.h"
+#include "semphr.h"
+
+#if BENCH_ENABLED
+/******************************************************************************
+*							GLOBAL VARIABLES
+******************************************************************************/
+typedef struct
+{
+    uint32_t test;
+    const char *name;
+} BenchTest_t;
+
+static TaskHandle_t bench_runner;
+static TaskHandle_t bench_echo;
+static QueueHandle_t bench_queue_req;
+static QueueHandle_t bench_queue_resp;
+static SemaphoreHandle_t bench_sem_req;
+static SemaphoreHandle_t bench_sem_resp;
+static StaticQueue_t bench_queue_req_control;
+static StaticQueue_t bench_queue_resp_control;
+static uint8_t bench_queue_req_storage[sizeof(uint32_t)];
+static uint8_t bench_queue_resp_storage[sizeof(uint32_t)];
+static StaticSemaphore_t bench_sem_req_control;
+static StaticSemaphore_t bench_sem_resp_control;
+static StackType_t bench_runner_stack[BENCH_TASK_STACK] APP_STACK;
+static StackType_t bench_echo_stack[BENCH_TASK_STACK] APP_STACK;
+static StaticTask_t bench_runner_tcb;
+static StaticTask_t bench_echo_tcb;
+
+static volatile uint32_t bench_current;     // Test the echo task serves
+static volatile uint32_t bench_stamp;       // CYCCNT before a one way wake
+static volatile float bench_acc;            // FPU work for BENCH_TEST_FPU_SWITCH
+static uint32_t bench_samples[BENCH_ITERATIONS];
+static uint32_t bench_hist[BENCH_HIST_BUCKETS];
+
+/******************************************************************************
+*							LOCAL FUNCTION DECLARATIONS
+******************************************************************************/
+static void Bench_Runner_Handler(void *params);
+static void Bench_Echo_Handler(void *params);
+static void Bench_Run_Test(uint32_t test);
+static void Bench_Report(const char *name);
+static int Bench_Compare(const void *a, const void *b);
+
+/******************************************************************************
+*							CONST DECLARATIONS
+******************************************************************************/
+// Run order, the FPU test must stay last
+static const BenchTest_t bench_tests[] =
+{
+    { BENCH_TEST_QUEUE,       "queue"  },
+    { BENCH_TEST_NOTIFY,      "notify" },
+    { BENCH_TEST_SEMAPHORE,   "sem"    },
+    { BENCH_TEST_SWITCH,      "switch" },
+    { BENCH_TEST_ISR_WAKE,    "isr"    },
+    { BENCH_TEST_TICK_JITTER, "jitter" },
+    { BENCH_TEST_FPU_SWITCH,  "fpu"    },
+};
+
+/******************************************************************************
+*							API IMPLEMENTATION
+******************************************************************************/
+void Bench_Run(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    bench_queue_req = xQueueCreateStatic(1, sizeof(uint32_t), bench_queue_req_storage,
+                                         &bench_queue_req_control);
+    bench_queue_resp = xQueueCreateStatic(1, sizeof(uint32_t), bench_queue_resp_storage,
+                                          &bench_queue_resp_control);
+    bench_sem_req = xSemaphoreCreateBinaryStatic(&bench_sem_req_control);
+    bench_sem_resp = xSemaphoreCreateBinaryStatic(&bench_sem_resp_control);
+    if ((bench_queue_req == NULL) || (bench_queue_resp == NULL) ||
+        (bench_sem_req == NULL) || (bench_sem_resp == NULL))
+    {
+        printf("Bench queue creation failed!\r\n");
+    }
+
+    HAL_NVIC_SetPriority(BENCH_SWI_IRQn, BENCH_SWI_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(BENCH_SWI_IRQn);
+
+    bench_echo = xTaskCreateStatic(Bench_Echo_Handler, "BenchEcho", BENCH_TASK_STACK, NULL,
+                                   BENCH_TASK_PRIORITY + 1, bench_echo_stack, &bench_echo_tcb);
+    if (bench_echo == NULL) printf("Bench Echo Task creation failed!\r\n");
+
+    bench_runner = xTaskCreateStatic(Bench_Runner_Handler, "Bench", BENCH_TASK_STACK, NULL,
+                                     BENCH_TASK_PRIORITY, bench_runner_stack, &bench_runner_tcb);
+    if (bench_runner == NULL) printf("Bench Task creation failed!\r\n");
+
+    vTaskStartScheduler();
+}
+
+// Software interrupt of the ISR wake test, pended by the runner
+void SPDIF_RX_IRQHandler(void)
+{
+    BaseType_t woken = pdFALSE;
+
+    vTaskNotifyGiveFromISR(bench_echo, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/******************************************************************************
+*							LOCAL FUNCTION DEFINITIONS
+******************************************************************************/
+static void Bench_Runner_Handler(void *params)
+{
+    TickType_t xLastWakeTime = xTaskGetTickCount();
+
+    while (1)
+    {
+        for (uint32_t i = 0; i < sizeof(bench_tests) / sizeof(bench_tests[0]); i++)
+        {
+            if ((BENCH_TESTS & bench_tests[i].test) == 0)
+            {
+                continue;
+            }
+
+            Bench_Run_Test(bench_tests[i].test);
+            Bench_Report(bench_tests[i].name);
+            vTaskDelay(pdMS_TO_TICKS(BENCH_SETTLE_MS));
+        }
+
+        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(BENCH_PERIOD_MS));
+    }
+}
+
+static void Bench_Run_Test(uint32_t test)
+{
+    uint32_t token = 0;
+
+    if (test == BENCH_TEST_TICK_JITTER)
+    {
+        // Period error against an ideal tick, the echo task is not involved
+        const uint32_t period = SystemCoreClock / configTICK_RATE_HZ;
+        TickType_t xLastWakeTime = xTaskGetTickCount();
+
+        vTaskDelayUntil(&xLastWakeTime, 1);
+        uint32_t last = DWT->CYCCNT;
+        for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+        {
+            vTaskDelayUntil(&xLastWakeTime, 1);
+            uint32_t now = DWT->CYCCNT;
+            uint32_t elapsed = now - last;
+            bench_samples[i] = (elapsed > period) ? (elapsed - period) : (period - elapsed);
+            last = now;
+        }
+        return;
+    }
+
+    // Arm the echo task, it preempts and blocks on this test's primitive
+    bench_current = test;
+    xTaskNotifyGive(bench_echo);
+
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        uint32_t start = DWT->CYCCNT;
+
+        switch (test)
+        {
+        case BENCH_TEST_QUEUE:
+            xQueueSend(bench_queue_req, &token, portMAX_DELAY);
+            xQueueReceive(bench_queue_resp, &token, portMAX_DELAY);
+            bench_samples[i] = DWT->CYCCNT - start;
+            break;
+
+        case BENCH_TEST_NOTIFY:
+            xTaskNotifyGive(bench_echo);
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            bench_samples[i] = DWT->CYCCNT - start;
+            break;
+
+        case BENCH_TEST_SEMAPHORE:
+            xSemaphoreGive(bench_sem_req);
+            xSemaphoreTake(bench_sem_resp, portMAX_DELAY);
+            bench_samples[i] = DWT->CYCCNT - start;
+            break;
+
+        case BENCH_TEST_ISR_WAKE:
+            bench_stamp = DWT->CYCCNT;
+            NVIC_SetPendingIRQ(BENCH_SWI_IRQn);
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            break;
+
+        case BENCH_TEST_FPU_SWITCH:
+            bench_acc = bench_acc * 0.5f + 1.0f;
+            /* fall through */
+        case BENCH_TEST_SWITCH:
+        default:
+            bench_stamp = DWT->CYCCNT;
+            xTaskNotifyGive(bench_echo);
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            break;
+        }
+    }
+}
+
+static void Bench_Echo_Handler(void *params)
+{
+    uint32_t token;
+
+    while (1)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        uint32_t test = bench_current;
+
+        for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+        {
+            switch (test)
+            {
+            case BENCH_TEST_QUEUE:
+                xQueueReceive(bench_queue_req, &token, portMAX_DELAY);
+                xQueueSend(bench_queue_resp, &token, portMAX_DELAY);
+                break;
+
+            case BENCH_TEST_NOTIFY:
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+                xTaskNotifyGive(bench_runner);
+                break;
+
+            case BENCH_TEST_SEMAPHORE:
+                xSemaphoreTake(bench_sem_req, portMAX_DELAY);
+                xSemaphoreGive(bench_sem_resp);
+                break;
+
+            default:
+                // One way tests, the stamp was taken before the wake
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+                bench_samples[i] = DWT->CYCCNT - bench_stamp;
+                if (test == BENCH_TEST_FPU_SWITCH)
+                {
+                    bench_acc = bench_acc * 0.5f + 1.0f;
+                }
+                xTaskNotifyGive(bench_runner);
+                break;
+            }
+        }
+    }
+}
+
+static void Bench_Report(const char *name)
+{
+    uint64_t sum = 0;
+
+    qsort(bench_samples, BENCH_ITERATIONS, sizeof(bench_samples[0]), Bench_Compare);
+    memset(bench_hist, 0, sizeof(bench_hist));
+
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        uint32_t value = bench_samples[i];
+        int32_t bucket = (31 - __builtin_clz(value | 1U)) - 4;
+
+        if (bucket < 0) bucket = 0;
+        if (bucket >= BENCH_HIST_BUCKETS) bucket = BENCH_HIST_BUCKETS - 1;
+        bench_hist[bucket]++;
+        sum += value;
+    }
+
+    printf("BENCH,%s,%u,%lu,%lu,%lu,%lu\r\n", name, (unsigned)BENCH_ITERATIONS,
+           (unsigned long)bench_samples[0],
+           (unsigned long)(sum / BENCH_ITERATIONS),
+           (unsigned long)bench_samples[(BENCH_ITERATIONS * 99U) / 100U],
+           (unsigned long)bench_samples[BENCH_ITERATIONS - 1]);
+
+    printf("BHIST,%s", name);
+    for (uint32_t i = 0; i < BENCH_HIST_BUCKETS; i++)
+    {
+        printf(",%lu", (unsigned long)bench_hist[i]);
+    }
+    printf("\r\n");
+}
+
+static int Bench_Compare(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+#endif /* BENCH_ENABLED */
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
@@ -0,0 +1,144 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Board.c
+  * @brief          : STM32F446RE Nucleo implementation of Board.h, the only
+  *                   application file holding CubeMX handles and HAL
+  *                   peripheral callbacks for the LED, LM35 and I2C3 paths.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  * 	17-10-2026	-	Board_Led_Toggle replaced by Board_Led_Set
+  *
+  *
+  *
+  ******************************************************************************
+  */
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "Board.h"
+#include "App.h"
+/******************************************************************************
+*							GLOBAL VARIABLES
+******************************************************************************/
+extern ADC_HandleTypeDef hadc1;
+extern TIM_HandleTypeDef htim2;
+extern I2C_HandleTypeDef hi2c3;
+
+/******************************************************************************
+*							LOCAL FUNCTION DECLARATIONS
+******************************************************************************/
+
+/******************************************************************************
+*							CONST DECLARATIONS
+******************************************************************************/
+
+
+/******************************************************************************
+*							API IMPLEMENTATION
+******************************************************************************/
+void Board_Led_Set(bool on)
+{
+    HAL_GPIO_WritePin(GPIOA, GPIO_PIN_5, on ? GPIO_PIN_SET : GPIO_PIN_RESET);
+}
+
+bool Board_Adc_Start(uint16_t *buffer, uint32_t length)
+{
+    // DMA first, the timer trigger starts the conversions
+    if (HAL_ADC_Start_DMA(&hadc1, (uint32_t *)buffer, length) != HAL_OK)
+    {
+        return false;
+    }
+    HAL_TIM_Base_Start(&htim2);
+
+    return true;
+}
+
+void Board_Adc_Stop(void)
+{
+    HAL_TIM_Base_Stop(&htim2);
+    HAL_ADC_Stop_DMA(&hadc1);
+}
+
+HAL_StatusTypeDef Board_I2c_Write(uint16_t dev_addr, uint8_t *data, uint16_t length)
+{
+    return HAL_I2C_Master_Transmit_DMA(&hi2c3, dev_addr, data, length);
+}
+
+HAL_StatusTypeDef Board_I2c_Read(uint16_t dev_addr, uint8_t *data, uint16_t length)
+{
+    return HAL_I2C_Master_Receive_DMA(&hi2c3, dev_addr, data, length);
+}
+
+HAL_StatusTypeDef Board_I2c_Probe(uint16_t dev_addr, uint32_t timeout_ms)
+{
+    // Probe has no interrupt variant in the HAL, it is only used for scans
+    return HAL_I2C_IsDeviceReady(&hi2c3, dev_addr, 1, timeout_ms);
+}
+
+void Board_I2c_Recover(void)
+{
+    HAL_I2C_DeInit(&hi2c3);
+    if (HAL_I2C_Init(&hi2c3) != HAL_OK)
+    {
+        printf("I2C3 re-init failed!\r\n");
+    }
+}
+
+
+/* ADC DMA callbacks (interrupt context) */
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    if (hadc->Instance == ADC1) LM35_Adc_Event_FromISR(LM35_NOTIFY_HALF_CPLT);
+}
+
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    if (hadc->Instance == ADC1) LM35_Adc_Event_FromISR(LM35_NOTIFY_FULL_CPLT);
+}
+
+void HAL_ADC_ErrorCallback(ADC_HandleTypeDef *hadc)
+{
+    if (hadc->Instance == ADC1) LM35_Adc_Event_FromISR(LM35_NOTIFY_ADC_ERROR);
+}
+
+/* I2C callbacks, may run in the I2C3 event/error or DMA1 stream interrupts */
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c->Instance == I2C3) I2cBus_Event_FromISR(I2C_BUS_EVT_DONE);
+}
+
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c->Instance == I2C3) I2cBus_Event_FromISR(I2C_BUS_EVT_DONE);
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c->Instance == I2C3) I2cBus_Event_FromISR(I2C_BUS_EVT_ERROR);
+}
+
+void HAL_I2C_AbortCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c->Instance == I2C3) I2cBus_Event_FromISR(I2C_BUS_EVT_ERROR);
+}
+
+/******************************************************************************
+*							LOCAL FUNCTION DEFINITIONS
+******************************************************************************/
+
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
@@ -0,0 +1,121 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Cobs.c
+  * @brief          : Consistent Overhead Byte Stuffing encoder/decoder
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  *
+  *
+  *
+  ******************************************************************************
+  */
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "Cobs.h"
+#include "App.h"
+/******************************************************************************
+*							GLOBAL VARIABLES
+******************************************************************************/
+
+/******************************************************************************
+*							LOCAL FUNCTION DECLARATIONS
+******************************************************************************/
+
+/******************************************************************************
+*							CONST DECLARATIONS
+******************************************************************************/
+
+
+/******************************************************************************
+*							API IMPLEMENTATION
+******************************************************************************/
+uint32_t Cobs_Encode(const uint8_t *in, uint32_t length, uint8_t *out)
+{
+    uint32_t code_index = 0;    // Where the current block's code byte goes
+    uint32_t out_index = 1;
+    uint8_t code = 1;
+
+    for (uint32_t i = 0; i < length; i++)
+    {
+        if (in[i] == 0)
+        {
+            out[code_index] = code;
+            code_index = out_index++;
+            code = 1;
+        }
+        else
+        {
+            out[out_index++] = in[i];
+            code++;
+
+            // Full block of 254 non-zero bytes, no implicit zero follows
+            if (code == 0xFF)
+            {
+                out[code_index] = code;
+                code_index = out_index++;
+                code = 1;
+            }
+        }
+    }
+
+    out[code_index] = code;
+    return out_index;
+}
+
+uint32_t Cobs_Decode(const uint8_t *in, uint32_t length, uint8_t *out, uint32_t out_size)
+{
+    uint32_t in_index = 0;
+    uint32_t out_index = 0;
+
+    while (in_index < length)
+    {
+        uint8_t code = in[in_index++];
+
+        if ((code == 0) || ((in_index + code - 1U) > length))
+        {
+            return 0;
+        }
+
+        for (uint8_t i = 1; i < code; i++)
+        {
+            if (out_index >= out_size)
+            {
+                return 0;
+            }
+            out[out_index++] = in[in_index++];
+        }
+
+        // Every block except a full one or the last one ends with a zero
+        if ((code != 0xFF) && (in_index < length))
+        {
+            if (out_index >= out_size)
+            {
+                return 0;
+            }
+            out[out_index++] = 0;
+        }
+    }
+
+    return out_index;
+}
+
+/******************************************************************************
+*							LOCAL FUNCTION DEFINITIONS
+******************************************************************************/
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
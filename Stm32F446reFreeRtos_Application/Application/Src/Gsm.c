@@ -0,0 +1,706 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Gsm.c
+  * @brief          : AT command engine for the SIM800 on USART3.
+  *
+  * Other tasks queue GsmCommand_t entries with Gsm_Submit and get the result
+  * through their done callback, nobody blocks on the modem. The GSM task
+  * owns the modem: it writes one command line, assembles the response lines
+  * from the USART3 receive stream and ends the line on OK/ERROR or on the
+  * largest timeout of its commands.
+  *
+  * Consecutive queued commands flagged GSM_FLAG_CHAIN are pipelined into
+  * one command line ("AT+CSQ;+CREG?;+CBC"), the modem runs them back to back
+  * and answers with one final result, so N status queries cost one round
+  * trip instead of N. Each response line is routed to the command whose
+  * prefix it starts with, anything else is a URC.
+  *
+  * The task sleeps on its notification: UartRx sets GSM_NOTIFY_RX for modem
+  * output, Gsm_Submit sets GSM_NOTIFY_SUBMIT, and the only timeout is the
+  * deadline of the line on the wire. An idle modem costs no wake-ups.
+  *
+  * Lines are kept in fixed buffers and split in place by Gsm_Tokenise.
+  * "RDY" / "NORMAL POWER DOWN" or GSM_RESET_TIMEOUTS timeouts in a row
+  * restart the start-up sequence, queued commands wait for it to finish.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  * 	17-10-2026	-	SHUT OK (AT+CIPSHUT) ends a command like OK
+  * 	17-10-2026	-	Woken by UartRx and Gsm_Submit notifications, no idle poll
+  *
+  *
+  *
+  ******************************************************************************
+  */
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "UartRx.h"
+#include "Gsm.h"
+#include <stdlib.h>
+#include <string.h>
+/******************************************************************************
+*							GLOBAL VARIABLES
+******************************************************************************/
+#define GSM_TX_WAIT_MS          50      // A full command line takes ~11 ms at 115200
+#define GSM_BOOT_TIMEOUT_MS     1000
+#define GSM_CTRL_Z              0x1A
+#define GSM_ESC                 0x1B
+
+extern UART_HandleTypeDef huart3;
+
+typedef struct
+{
+    GsmCommand_t command;
+    bool info;                      // A line matching the prefix arrived
+    char line[GSM_LINE_MAX];        // Last such line
+} GsmSlot_t;
+
+typedef struct
+{
+    const char *prefix;
+    GsmUrc_t handler;
+    void *context;
+} GsmUrcSlot_t;
+
+static StaticQueue_t gsm_queue_buffer;
+static uint8_t gsm_queue_storage[GSM_QUEUE_LEN * sizeof(GsmCommand_t)];
+static QueueHandle_t gsm_queue;
+static TaskHandle_t gsm_task;               // Set once the GSM task runs
+
+// Command line on the wire
+static GsmSlot_t gsm_chain[GSM_CHAIN_MAX];
+static uint8_t gsm_chain_len;
+static TickType_t gsm_sent_at;
+static uint32_t gsm_timeout_ms;
+static bool gsm_prompt;                     // Payload goes out at the next '>'
+static char gsm_tx[GSM_LINE_MAX];
+static volatile bool gsm_tx_busy;
+
+// Response line being assembled
+static char gsm_rx[GSM_LINE_MAX];
+static uint32_t gsm_rx_len;
+static bool gsm_rx_overflow;
+
+// Start-up sequence, gsm_boot_done == GSM_BOOT_COUNT once the modem is usable
+static uint8_t gsm_boot_next;
+static uint8_t gsm_boot_done;
+static volatile bool gsm_ready;
+static uint8_t gsm_timeouts;                // In a row
+
+static GsmUrcSlot_t gsm_urcs[GSM_URC_MAX];
+static GsmStats_t gsm_stats;
+
+/******************************************************************************
+*							LOCAL FUNCTION DECLARATIONS
+******************************************************************************/
+static void Gsm_Feed(const uint8_t *data, size_t length);
+static void Gsm_Service(void);
+static TickType_t Gsm_Wait(void);
+static void Gsm_Line(char *line);
+static void Gsm_Send(void);
+static void Gsm_Finish(GsmStatus_t status, int16_t error);
+static void Gsm_Restart(void);
+static bool Gsm_Take(GsmCommand_t *command);
+static bool Gsm_Peek(GsmCommand_t *command);
+static bool Gsm_Write(const void *data, uint16_t length);
+static void Gsm_Account(uint8_t type, const GsmResult_t *result);
+static void Gsm_Boot_Done(const GsmResult_t *result, void *context);
+
+/******************************************************************************
+*							CONST DECLARATIONS
+******************************************************************************/
+// "AT" until the modem answers (also locks its autobaud), then the settings
+// the engine relies on: no echo, numeric +CME errors, SMS text mode
+static const GsmCommand_t gsm_boot[] =
+{
+    { .text = "",        .type = GSM_TYPE_CONTROL, .timeout_ms = GSM_BOOT_TIMEOUT_MS,
+      .done = Gsm_Boot_Done, .context = (void *)0 },
+    { .text = "E0",      .type = GSM_TYPE_CONTROL, .timeout_ms = GSM_BOOT_TIMEOUT_MS, .flags = GSM_FLAG_CHAIN,
+      .done = Gsm_Boot_Done, .context = (void *)1 },
+    { .text = "+CMEE=1", .type = GSM_TYPE_CONTROL, .timeout_ms = GSM_BOOT_TIMEOUT_MS, .flags = GSM_FLAG_CHAIN,
+      .done = Gsm_Boot_Done, .context = (void *)2 },
+    { .text = "+CMGF=1", .type = GSM_TYPE_CONTROL, .timeout_ms = GSM_BOOT_TIMEOUT_MS, .flags = GSM_FLAG_CHAIN,
+      .done = Gsm_Boot_Done, .context = (void *)3 },
+};
+
+#define GSM_BOOT_COUNT          (sizeof(gsm_boot) / sizeof(gsm_boot[0]))
+
+static const char *const gsm_type_names[GSM_TYPE_COUNT] =
+{
+    [GSM_TYPE_CONTROL] = "CTRL",
+    [GSM_TYPE_STATUS]  = "STAT",
+    [GSM_TYPE_SMS]     = "SMS",
+    [GSM_TYPE_GPRS]    = "GPRS",
+};
+
+static const uint8_t gsm_ctrl_z = GSM_CTRL_Z;
+static const uint8_t gsm_esc = GSM_ESC;
+
+/******************************************************************************
+*							API IMPLEMENTATION
+******************************************************************************/
+bool Gsm_Init(void)
+{
+    gsm_queue = xQueueCreateStatic(GSM_QUEUE_LEN, sizeof(GsmCommand_t), gsm_queue_storage,
+                                   &gsm_queue_buffer);
+    return (gsm_queue != NULL);
+}
+
+void Gsm_Handler(void *params)
+{
+    uint8_t chunk[64];
+    size_t n;
+
+    gsm_task = xTaskGetCurrentTaskHandle();
+    UartRx_SetNotify(UART_RX_GSM, gsm_task, GSM_NOTIFY_RX);
+
+    // Whatever the modem said before anyone listened
+    UartRx_Flush(UART_RX_GSM);
+
+    while (1)
+    {
+        // A bit set while the task was busy stays pending, nothing is missed
+        xTaskNotifyWait(0, GSM_NOTIFY_RX | GSM_NOTIFY_SUBMIT, NULL, Gsm_Wait());
+
+        while ((n = UartRx_Read(UART_RX_GSM, chunk, sizeof(chunk), 0)) > 0)
+        {
+            Gsm_Feed(chunk, n);
+        }
+        Gsm_Service();
+    }
+}
+
+bool Gsm_Submit(const GsmCommand_t *command, TickType_t wait)
+{
+    if ((memchr(command->text, '\0', GSM_CMD_TEXT_MAX) == NULL) ||
+        (command->type >= GSM_TYPE_COUNT))
+    {
+        return false;
+    }
+
+    if (xQueueSend(gsm_queue, command, wait) != pdTRUE)
+    {
+        return false;
+    }
+
+    // Before the task first runs it finds the command on its own
+    TaskHandle_t task = gsm_task;
+    if (task != NULL)
+    {
+        xTaskNotify(task, GSM_NOTIFY_SUBMIT, eSetBits);
+    }
+    return true;
+}
+
+bool Gsm_Subscribe(const char *prefix, GsmUrc_t handler, void *context)
+{
+    bool added = false;
+
+    taskENTER_CRITICAL();
+    for (uint32_t i = 0; i < GSM_URC_MAX; i++)
+    {
+        if (gsm_urcs[i].prefix == NULL)
+        {
+            // Prefix last, the GSM task treats the slot as used from then on
+            gsm_urcs[i].handler = handler;
+            gsm_urcs[i].context = context;
+            gsm_urcs[i].prefix = prefix;
+            added = true;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return added;
+}
+
+bool Gsm_IsReady(void)
+{
+    return gsm_ready;
+}
+
+void Gsm_GetStats(GsmStats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = gsm_stats;
+    taskEXIT_CRITICAL();
+}
+
+const char *Gsm_TypeName(GsmType_t type)
+{
+    return (type < GSM_TYPE_COUNT) ? gsm_type_names[type] : "?";
+}
+
+uint8_t Gsm_Tokenise(char *line, const char **argv, uint8_t max)
+{
+    uint8_t argc = 0;
+    char *p = line;
+    char *colon = strchr(line, ':');
+
+    if (max == 0)
+    {
+        return 0;
+    }
+
+    // "+XXX:" is the first field
+    if ((line[0] == '+') && (colon != NULL))
+    {
+        *colon = '\0';
+        argv[argc++] = line;
+        p = colon + 1;
+    }
+
+    while (argc < max)
+    {
+        while (*p == ' ')
+        {
+            p++;
+        }
+
+        if (*p == '"')
+        {
+            argv[argc++] = ++p;
+            p = strchr(p, '"');
+            if (p == NULL)
+            {
+                break;
+            }
+            *p++ = '\0';
+            p = strchr(p, ',');
+        }
+        else
+        {
+            argv[argc++] = p;
+            p = strchr(p, ',');
+            if (p != NULL)
+            {
+                *p = '\0';
+            }
+        }
+
+        if (p == NULL)
+        {
+            break;
+        }
+        p++;
+    }
+
+    return argc;
+}
+
+void Gsm_TxComplete_FromISR(void)
+{
+    gsm_tx_busy = false;
+}
+
+
+/******************************************************************************
+*							LOCAL FUNCTION DEFINITIONS
+******************************************************************************/
+static void Gsm_Feed(const uint8_t *data, size_t length)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        char c = (char)data[i];
+
+        // "> " has no line end, the modem waits for the payload
+        if (gsm_prompt && (gsm_rx_len == 0) && (c == '>'))
+        {
+            const GsmCommand_t *command = &gsm_chain[0].command;
+
+            gsm_prompt = false;
+            Gsm_Write(command->payload, command->payload_len);
+            if (command->flags & GSM_FLAG_CTRL_Z)
+            {
+                Gsm_Write(&gsm_ctrl_z, 1);
+            }
+            continue;
+        }
+
+        if ((c == '\r') || (c == '\n'))
+        {
+            if (gsm_rx_overflow)
+            {
+                gsm_stats.overflows++;
+            }
+            else if (gsm_rx_len > 0)
+            {
+                gsm_rx[gsm_rx_len] = '\0';
+                Gsm_Line(gsm_rx);
+            }
+            gsm_rx_len = 0;
+            gsm_rx_overflow = false;
+        }
+        else if ((gsm_rx_len == 0) && (c == ' '))
+        {
+            // Left over from the "> " prompt
+        }
+        else if (gsm_rx_len < (GSM_LINE_MAX - 1))
+        {
+            gsm_rx[gsm_rx_len++] = c;
+        }
+        else
+        {
+            gsm_rx_overflow = true;
+        }
+    }
+}
+
+static void Gsm_Service(void)
+{
+    if ((gsm_chain_len > 0) &&
+        ((xTaskGetTickCount() - gsm_sent_at) >= pdMS_TO_TICKS(gsm_timeout_ms)))
+    {
+        // A modem still waiting for the payload would take the next line as text
+        if (gsm_prompt)
+        {
+            Gsm_Write(&gsm_esc, 1);
+        }
+        Gsm_Finish(GSM_TIMEOUT, -1);
+
+        if (gsm_ready && (++gsm_timeouts >= GSM_RESET_TIMEOUTS))
+        {
+            Gsm_Restart();
+        }
+    }
+
+    if (gsm_chain_len == 0)
+    {
+        Gsm_Send();
+    }
+}
+
+// Until the deadline of the line on the wire. Idle, until notified, unless
+// a command could not be written and is still waiting.
+static TickType_t Gsm_Wait(void)
+{
+    GsmCommand_t next;
+
+    if (gsm_chain_len == 0)
+    {
+        return Gsm_Peek(&next) ? 0 : portMAX_DELAY;
+    }
+
+    TickType_t elapsed = xTaskGetTickCount() - gsm_sent_at;
+    TickType_t limit = pdMS_TO_TICKS(gsm_timeout_ms);
+    return (elapsed < limit) ? (limit - elapsed) : 0;
+}
+
+static void Gsm_Line(char *line)
+{
+    if (gsm_chain_len > 0)
+    {
+        size_t len = strlen(line);
+
+        if ((strcmp(line, "OK") == 0) || (strcmp(line, "SEND OK") == 0) ||
+            (strcmp(line, "SHUT OK") == 0))
+        {
+            Gsm_Finish(GSM_OK, -1);
+            return;
+        }
+        if ((strcmp(line, "ERROR") == 0) || (strcmp(line, "SEND FAIL") == 0))
+        {
+            Gsm_Finish(GSM_ERROR, -1);
+            return;
+        }
+        if ((strncmp(line, "+CME ERROR:", 11) == 0) || (strncmp(line, "+CMS ERROR:", 11) == 0))
+        {
+            Gsm_Finish(GSM_ERROR, (int16_t)atoi(&line[11]));
+            return;
+        }
+        // Echo of our own line, until ATE0 has been applied
+        if ((strncmp(line, gsm_tx, len) == 0) && (gsm_tx[len] == '\r'))
+        {
+            return;
+        }
+    }
+
+    if ((strcmp(line, "RDY") == 0) || (strcmp(line, "NORMAL POWER DOWN") == 0))
+    {
+        gsm_stats.urcs++;
+        Gsm_Restart();
+        return;
+    }
+
+    // Information line of a command on the wire. The modem answers in
+    // order, so the first matching command still without one gets it, a
+    // multi-line answer ("+CMGL:") keeps the last line.
+    GsmSlot_t *slot = NULL;
+    for (uint32_t i = 0; i < gsm_chain_len; i++)
+    {
+        const char *prefix = gsm_chain[i].command.prefix;
+
+        if ((prefix != NULL) && (prefix[0] != '\0') && (strncmp(line, prefix, strlen(prefix)) == 0))
+        {
+            slot = &gsm_chain[i];
+            if (!slot->info)
+            {
+                break;
+            }
+        }
+    }
+    if (slot != NULL)
+    {
+        strcpy(slot->line, line);
+        slot->info = true;
+        return;
+    }
+
+    for (uint32_t i = 0; i < GSM_URC_MAX; i++)
+    {
+        const char *prefix = gsm_urcs[i].prefix;
+
+        if ((prefix != NULL) && (strncmp(line, prefix, strlen(prefix)) == 0))
+        {
+            const char *argv[GSM_TOKENS_MAX];
+            uint8_t argc = Gsm_Tokenise(line, argv, GSM_TOKENS_MAX);
+
+            gsm_stats.urcs++;
+            gsm_urcs[i].handler(argc, argv, gsm_urcs[i].context);
+            return;
+        }
+    }
+
+    // Bare information line ("+CGSN", "+CIFSR" answer without a prefix)
+    for (uint32_t i = 0; i < gsm_chain_len; i++)
+    {
+        const char *prefix = gsm_chain[i].command.prefix;
+
+        if ((prefix != NULL) && (prefix[0] == '\0'))
+        {
+            strcpy(gsm_chain[i].line, line);
+            gsm_chain[i].info = true;
+            return;
+        }
+    }
+
+    // "Call Ready", "SMS Ready", ... nobody asked for
+    gsm_stats.urcs++;
+}
+
+// Writes the next command line, pipelining chainable commands into it
+static void Gsm_Send(void)
+{
+    GsmCommand_t next;
+    uint32_t len;
+
+    if (!Gsm_Take(&gsm_chain[0].command))
+    {
+        return;
+    }
+    gsm_chain_len = 1;
+
+    len = 2 + strlen(gsm_chain[0].command.text);
+    memcpy(gsm_tx, "AT", 2);
+    memcpy(&gsm_tx[2], gsm_chain[0].command.text, len - 2);
+    gsm_timeout_ms = gsm_chain[0].command.timeout_ms;
+
+    while ((gsm_chain_len < GSM_CHAIN_MAX) &&
+           (gsm_chain[0].command.flags & GSM_FLAG_CHAIN) && (gsm_chain[0].command.payload == NULL) &&
+           Gsm_Peek(&next) &&
+           (next.flags & GSM_FLAG_CHAIN) && (next.payload == NULL) &&
+           ((len + 1 + strlen(next.text) + 1) < GSM_LINE_MAX))
+    {
+        GsmCommand_t *command = &gsm_chain[gsm_chain_len++].command;
+
+        Gsm_Take(command);
+        gsm_tx[len++] = ';';
+        memcpy(&gsm_tx[len], command->text, strlen(command->text));
+        len += strlen(command->text);
+        if (command->timeout_ms > gsm_timeout_ms)
+        {
+            gsm_timeout_ms = command->timeout_ms;
+        }
+    }
+    gsm_tx[len++] = '\r';
+    gsm_tx[len] = '\0';
+
+    for (uint32_t i = 0; i < gsm_chain_len; i++)
+    {
+        gsm_chain[i].info = false;
+    }
+    gsm_prompt = (gsm_chain[0].command.payload != NULL);
+    gsm_sent_at = xTaskGetTickCount();
+
+    taskENTER_CRITICAL();
+    gsm_stats.lines++;
+    gsm_stats.commands += gsm_chain_len;
+    taskEXIT_CRITICAL();
+
+    if (!Gsm_Write(gsm_tx, (uint16_t)len))
+    {
+        Gsm_Finish(GSM_ERROR, -1);
+    }
+}
+
+static void Gsm_Finish(GsmStatus_t status, int16_t error)
+{
+    uint32_t latency_ms = (uint32_t)((xTaskGetTickCount() - gsm_sent_at) * portTICK_PERIOD_MS);
+    uint8_t count = gsm_chain_len;
+
+    gsm_chain_len = 0;
+    gsm_prompt = false;
+    if (status != GSM_TIMEOUT)
+    {
+        gsm_timeouts = 0;
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        GsmSlot_t *slot = &gsm_chain[i];
+        GsmResult_t result = { .status = status, .error = error, .latency_ms = latency_ms };
+
+        // The modem stops a chained line at the failing command, the ones
+        // that already sent their information line did run
+        if ((status == GSM_ERROR) && slot->info)
+        {
+            result.status = GSM_OK;
+            result.error = -1;
+        }
+        if (slot->info)
+        {
+            result.argc = Gsm_Tokenise(slot->line, result.argv, GSM_TOKENS_MAX);
+        }
+
+        Gsm_Account(slot->command.type, &result);
+        if (slot->command.done != NULL)
+        {
+            slot->command.done(&result, slot->command.context);
+        }
+    }
+}
+
+// Modem restarted (or presumed hung): start-up sequence again, the queue is kept
+static void Gsm_Restart(void)
+{
+    Gsm_Finish(GSM_RESET, -1);
+
+    gsm_ready = false;
+    gsm_boot_next = 0;
+    gsm_boot_done = 0;
+    gsm_timeouts = 0;
+
+    taskENTER_CRITICAL();
+    gsm_stats.resets++;
+    taskEXIT_CRITICAL();
+}
+
+// Next command: the start-up sequence first, then the queue
+static bool Gsm_Take(GsmCommand_t *command)
+{
+    if (gsm_boot_done < GSM_BOOT_COUNT)
+    {
+        if (gsm_boot_next >= GSM_BOOT_COUNT)
+        {
+            return false;
+        }
+        *command = gsm_boot[gsm_boot_next++];
+        return true;
+    }
+
+    return (xQueueReceive(gsm_queue, command, 0) == pdTRUE);
+}
+
+static bool Gsm_Peek(GsmCommand_t *command)
+{
+    if (gsm_boot_done < GSM_BOOT_COUNT)
+    {
+        if (gsm_boot_next >= GSM_BOOT_COUNT)
+        {
+            return false;
+        }
+        *command = gsm_boot[gsm_boot_next];
+        return true;
+    }
+
+    return (xQueuePeek(gsm_queue, command, 0) == pdTRUE);
+}
+
+static bool Gsm_Write(const void *data, uint16_t length)
+{
+    // Previous write still going, it normally is long gone by now
+    for (uint32_t waited = 0; gsm_tx_busy && (waited < GSM_TX_WAIT_MS); waited++)
+    {
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+    if (gsm_tx_busy)
+    {
+        return false;
+    }
+
+    gsm_tx_busy = true;
+    if (HAL_UART_Transmit_IT(&huart3, (uint8_t *)data, length) != HAL_OK)
+    {
+        gsm_tx_busy = false;
+        return false;
+    }
+    return true;
+}
+
+static void Gsm_Account(uint8_t type, const GsmResult_t *result)
+{
+    GsmLatency_t *latency = &gsm_stats.type[(type < GSM_TYPE_COUNT) ? type : GSM_TYPE_CONTROL];
+
+    taskENTER_CRITICAL();
+    latency->count++;
+    if (result->status == GSM_TIMEOUT)
+    {
+        latency->timeouts++;
+    }
+    else if (result->status == GSM_RESET)
+    {
+        latency->errors++;
+    }
+    else
+    {
+        latency->errors += (result->status != GSM_OK) ? 1U : 0U;
+        latency->answered++;
+        latency->total_ms += result->latency_ms;
+        latency->avg_ms = latency->total_ms / latency->answered;
+        if (result->latency_ms > latency->max_ms)
+        {
+            latency->max_ms = result->latency_ms;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+static void Gsm_Boot_Done(const GsmResult_t *result, void *context)
+{
+    uint32_t step = (uint32_t)(uintptr_t)context;
+
+    if (result->status != GSM_OK)
+    {
+        // Start over with "AT", the modem may be booting or re-syncing its baud rate
+        gsm_boot_next = 0;
+        gsm_boot_done = 0;
+        return;
+    }
+
+    gsm_boot_done = (uint8_t)(step + 1);
+    if (gsm_boot_done == GSM_BOOT_COUNT)
+    {
+        gsm_ready = true;
+    }
+}
+
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
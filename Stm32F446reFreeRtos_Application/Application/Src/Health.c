@@ -0,0 +1,127 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Health.c
+  * @brief          : System health fan-out. Producers report faults with
+  *                   Health_Update(), observers block on their own change bit
+  *                   of the same event group, so nobody polls and nobody wakes
+  *                   while the state stays the same.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  * 	17-10-2026	-	Health_Wake
+  *
+  *
+  *
+  ******************************************************************************
+  */
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "Health.h"
+#include "App.h"
+/******************************************************************************
+*							GLOBAL VARIABLES
+******************************************************************************/
+static StaticEventGroup_t health_group_control;
+static EventGroupHandle_t health_group = NULL;
+static EventBits_t health_observers;           // Change bits handed out
+
+/******************************************************************************
+*							LOCAL FUNCTION DECLARATIONS
+******************************************************************************/
+
+/******************************************************************************
+*							CONST DECLARATIONS
+******************************************************************************/
+#if ((HEALTH_OBSERVER_SHIFT + HEALTH_MAX_OBSERVERS) > 24)
+#error "Health: event groups have 24 usable bits"
+#endif
+
+/******************************************************************************
+*							API IMPLEMENTATION
+******************************************************************************/
+bool Health_Init(void)
+{
+    health_group = xEventGroupCreateStatic(&health_group_control);
+    return (health_group != NULL);
+}
+
+void Health_Update(EventBits_t set, EventBits_t clear)
+{
+    set &= HEALTH_FAULTS_ALL;
+    clear &= HEALTH_FAULTS_ALL & ~set;
+
+    // Single read-modify-write so two producers cannot both miss the change
+    vTaskSuspendAll();
+    EventBits_t before = xEventGroupGetBits(health_group) & HEALTH_FAULTS_ALL;
+    EventBits_t after = (before | set) & ~clear;
+
+    if (after != before)
+    {
+        xEventGroupClearBits(health_group, before & ~after);
+        xEventGroupSetBits(health_group, (after & ~before) | health_observers);
+    }
+    xTaskResumeAll();
+}
+
+EventBits_t Health_Get(void)
+{
+    return xEventGroupGetBits(health_group) & HEALTH_FAULTS_ALL;
+}
+
+HealthObserver_t Health_Observe(void)
+{
+    HealthObserver_t observer = 0;
+
+    taskENTER_CRITICAL();
+    for (uint32_t i = 0; i < HEALTH_MAX_OBSERVERS; i++)
+    {
+        EventBits_t bit = 1UL << (HEALTH_OBSERVER_SHIFT + i);
+
+        if ((health_observers & bit) == 0)
+        {
+            health_observers |= bit;
+            observer = bit;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return observer;
+}
+
+EventBits_t Health_Wait(HealthObserver_t observer, TickType_t timeout, bool *changed)
+{
+    EventBits_t bits = xEventGroupWaitBits(health_group, observer, pdTRUE, pdFALSE, timeout);
+
+    if (changed != NULL)
+    {
+        *changed = ((bits & observer) != 0);
+    }
+    return bits & HEALTH_FAULTS_ALL;
+}
+
+void Health_Wake(HealthObserver_t observer)
+{
+    xEventGroupSetBits(health_group, observer & health_observers);
+}
+
+/******************************************************************************
+*							LOCAL FUNCTION DEFINITIONS
+******************************************************************************/
+
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
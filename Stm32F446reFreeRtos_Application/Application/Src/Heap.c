@@ -0,0 +1,430 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Heap.c
+  * @brief          : TLSF (two level segregated fit) heap, provides
+  *                   pvPortMalloc and vPortFree in place of heap_4.
+  *
+  * Free blocks are kept on HEAP_FL_COUNT x HEAP_SL_COUNT lists. The first
+  * level splits sizes into power of two ranges, the second level splits each
+  * range into HEAP_SL_COUNT equal parts; blocks below HEAP_SMALL_BLOCK sit in
+  * first level 0 in exact 8 byte steps. One bit per non-empty list in two
+  * bitmaps lets a request find a list whose every block fits with one CLZ/CTZ
+  * per level, so allocation, split, free and merge are O(1), where heap_4
+  * walks its address ordered free list.
+  *
+  * Every block has an 8 byte header (previous physical block, payload size
+  * and a free flag), the same overhead as heap_4. The free list links live
+  * in the payload. A freed block is merged at once with its free physical
+  * neighbours. The request is rounded up to the next list boundary before
+  * the search, at most 1/16 of its size; only when no such list has a block
+  * is the list of the exact size scanned, so a request fails no sooner than
+  * with a plain good fit.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  * 	17-10-2026	-	v01	- Size classes became a cache in front of heap_4
+  * 	17-10-2026	-	v01	- TLSF with FL/SL bitmaps replaces the cache and
+  * 					heap_4, stats from running counters
+  *
+  *
+  *
+  ******************************************************************************
+  */
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "FreeRTOS.h"
+#include "task.h"
+#include "Heap.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 0)
+#error "Heap.c must not be built when configSUPPORT_DYNAMIC_ALLOCATION is 0"
+#endif
+
+#if (portBYTE_ALIGNMENT != (1 << HEAP_ALIGN_LOG2))
+#error "HEAP_ALIGN_LOG2 must match portBYTE_ALIGNMENT"
+#endif
+
+_Static_assert(configTOTAL_HEAP_SIZE < (1UL << HEAP_FL_MAX_LOG2),
+               "configTOTAL_HEAP_SIZE needs a bigger HEAP_FL_MAX_LOG2");
+
+/******************************************************************************
+*							GLOBAL VARIABLES
+******************************************************************************/
+// Header of every block. next_free/prev_free are only valid while the block
+// is free, they overlay the first payload bytes.
+typedef struct HeapBlock
+{
+    struct HeapBlock *prev_phys;    // Block just below in memory, NULL for the first
+    size_t size;                    // Payload bytes | HEAP_BLOCK_FREE
+    struct HeapBlock *next_free;
+    struct HeapBlock *prev_free;
+} HeapBlock_t;
+
+#define HEAP_BLOCK_FREE         ((size_t)1)
+#define HEAP_BLOCK_HEADER       (offsetof(HeapBlock_t, next_free))
+#define HEAP_BLOCK_MIN          (sizeof(HeapBlock_t) - HEAP_BLOCK_HEADER)
+#define HEAP_BLOCK_MAX          ((size_t)1 << HEAP_FL_MAX_LOG2)
+
+#if (configAPPLICATION_ALLOCATED_HEAP == 1)
+extern uint8_t ucHeap[configTOTAL_HEAP_SIZE];
+#else
+static uint8_t ucHeap[configTOTAL_HEAP_SIZE];
+#endif
+
+static HeapBlock_t *heap_lists[HEAP_FL_COUNT][HEAP_SL_COUNT];
+static uint32_t heap_fl_bitmap;
+static uint32_t heap_sl_bitmap[HEAP_FL_COUNT];
+static bool heap_ready = false;
+
+// Running counters, vPortGetHeapStats only copies them
+static size_t heap_free_bytes;          // Free blocks, headers included, as heap_4
+static size_t heap_min_free_bytes;
+static size_t heap_free_blocks;
+static size_t heap_alloc_count;
+static size_t heap_free_count;
+static uint32_t heap_fl_blocks[HEAP_FL_COUNT];
+
+/******************************************************************************
+*							LOCAL FUNCTION DECLARATIONS
+******************************************************************************/
+static void Heap_Init(void);
+static void Heap_Mapping(size_t size, uint32_t *fl, uint32_t *sl);
+static HeapBlock_t *Heap_Find(size_t size);
+static void Heap_Insert(HeapBlock_t *block);
+static void Heap_Remove(HeapBlock_t *block);
+static HeapBlock_t *Heap_Next(const HeapBlock_t *block);
+static size_t Heap_Size(const HeapBlock_t *block);
+
+/******************************************************************************
+*							CONST DECLARATIONS
+******************************************************************************/
+
+
+/******************************************************************************
+*							API IMPLEMENTATION
+******************************************************************************/
+void *pvPortMalloc(size_t xWantedSize)
+{
+    void *pv = NULL;
+
+    // Payload rounded to the alignment, big enough for the free list links
+    size_t size = (xWantedSize + (portBYTE_ALIGNMENT - 1)) & ~(size_t)portBYTE_ALIGNMENT_MASK;
+    if (size < HEAP_BLOCK_MIN)
+    {
+        size = HEAP_BLOCK_MIN;
+    }
+
+    if ((xWantedSize != 0) && (xWantedSize < HEAP_BLOCK_MAX) && (size < HEAP_BLOCK_MAX))
+    {
+        vTaskSuspendAll();
+        {
+            if (!heap_ready)
+            {
+                Heap_Init();
+            }
+
+            HeapBlock_t *block = Heap_Find(size);
+            if (block != NULL)
+            {
+                size_t rest = Heap_Size(block) - size;
+
+                Heap_Remove(block);
+
+                // Split off the tail if it can hold a block of its own
+                if (rest >= (HEAP_BLOCK_HEADER + HEAP_BLOCK_MIN))
+                {
+                    HeapBlock_t *tail = (HeapBlock_t *)((uint8_t *)block + HEAP_BLOCK_HEADER + size);
+
+                    tail->prev_phys = block;
+                    tail->size = (rest - HEAP_BLOCK_HEADER) | HEAP_BLOCK_FREE;
+                    Heap_Next(tail)->prev_phys = tail;
+                    block->size = size;
+                    Heap_Insert(tail);
+                }
+                else
+                {
+                    block->size = Heap_Size(block);
+                }
+
+                heap_free_bytes -= HEAP_BLOCK_HEADER + block->size;
+                if (heap_free_bytes < heap_min_free_bytes)
+                {
+                    heap_min_free_bytes = heap_free_bytes;
+                }
+                heap_alloc_count++;
+                pv = (uint8_t *)block + HEAP_BLOCK_HEADER;
+            }
+            traceMALLOC(pv, xWantedSize);
+        }
+        (void)xTaskResumeAll();
+    }
+
+#if (configUSE_MALLOC_FAILED_HOOK == 1)
+    if (pv == NULL)
+    {
+        extern void vApplicationMallocFailedHook(void);
+        vApplicationMallocFailedHook();
+    }
+#endif
+
+    return pv;
+}
+
+void vPortFree(void *pv)
+{
+    if (pv == NULL)
+    {
+        return;
+    }
+
+    HeapBlock_t *block = (HeapBlock_t *)((uint8_t *)pv - HEAP_BLOCK_HEADER);
+
+    // Double free or a pointer that did not come from pvPortMalloc
+    configASSERT((block->size & HEAP_BLOCK_FREE) == 0);
+    configASSERT(Heap_Next(block)->prev_phys == block);
+
+    vTaskSuspendAll();
+    {
+        traceFREE(pv, block->size);
+        heap_free_bytes += HEAP_BLOCK_HEADER + block->size;
+        heap_free_count++;
+
+        // Merge with the free neighbours, the result goes on one list
+        HeapBlock_t *next = Heap_Next(block);
+        if (next->size & HEAP_BLOCK_FREE)
+        {
+            Heap_Remove(next);
+            block->size += HEAP_BLOCK_HEADER + Heap_Size(next);
+            Heap_Next(block)->prev_phys = block;
+        }
+
+        HeapBlock_t *prev = block->prev_phys;
+        if ((prev != NULL) && (prev->size & HEAP_BLOCK_FREE))
+        {
+            Heap_Remove(prev);
+            prev->size = Heap_Size(prev) + HEAP_BLOCK_HEADER + block->size;
+            block = prev;
+            Heap_Next(block)->prev_phys = block;
+        }
+
+        block->size |= HEAP_BLOCK_FREE;
+        Heap_Insert(block);
+    }
+    (void)xTaskResumeAll();
+}
+
+size_t xPortGetFreeHeapSize(void)
+{
+    return heap_ready ? heap_free_bytes : configTOTAL_HEAP_SIZE;
+}
+
+size_t xPortGetMinimumEverFreeHeapSize(void)
+{
+    return heap_ready ? heap_min_free_bytes : configTOTAL_HEAP_SIZE;
+}
+
+void vPortInitialiseBlocks(void)
+{
+    // Nothing to do, the heap initialises itself on the first allocation
+}
+
+void vPortGetHeapStats(HeapStats_t *pxHeapStats)
+{
+    memset(pxHeapStats, 0, sizeof(*pxHeapStats));
+
+    vTaskSuspendAll();
+    {
+        if (heap_fl_bitmap != 0)
+        {
+            uint32_t fl = 31U - (uint32_t)__builtin_clz(heap_fl_bitmap);
+            uint32_t sl = 31U - (uint32_t)__builtin_clz(heap_sl_bitmap[fl]);
+            pxHeapStats->xSizeOfLargestFreeBlockInBytes = HEAP_BLOCK_HEADER + Heap_Size(heap_lists[fl][sl]);
+
+            fl = (uint32_t)__builtin_ctz(heap_fl_bitmap);
+            sl = (uint32_t)__builtin_ctz(heap_sl_bitmap[fl]);
+            pxHeapStats->xSizeOfSmallestFreeBlockInBytes = HEAP_BLOCK_HEADER + Heap_Size(heap_lists[fl][sl]);
+        }
+
+        pxHeapStats->xAvailableHeapSpaceInBytes = heap_free_bytes;
+        pxHeapStats->xNumberOfFreeBlocks = heap_free_blocks;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = heap_min_free_bytes;
+        pxHeapStats->xNumberOfSuccessfulAllocations = heap_alloc_count;
+        pxHeapStats->xNumberOfSuccessfulFrees = heap_free_count;
+    }
+    (void)xTaskResumeAll();
+}
+
+uint32_t Heap_GetFreeBlocks(uint32_t fl)
+{
+    return (fl < HEAP_FL_COUNT) ? heap_fl_blocks[fl] : 0;
+}
+
+/******************************************************************************
+*							LOCAL FUNCTION DEFINITIONS
+******************************************************************************/
+// One free block over the whole array, a zero sized used block ends it so
+// every block has a physical successor
+static void Heap_Init(void)
+{
+    uintptr_t start = ((uintptr_t)ucHeap + (portBYTE_ALIGNMENT - 1)) & ~(uintptr_t)portBYTE_ALIGNMENT_MASK;
+    uintptr_t end = ((uintptr_t)ucHeap + configTOTAL_HEAP_SIZE - HEAP_BLOCK_HEADER) & ~(uintptr_t)portBYTE_ALIGNMENT_MASK;
+    HeapBlock_t *block = (HeapBlock_t *)start;
+    HeapBlock_t *last = (HeapBlock_t *)end;
+
+    block->prev_phys = NULL;
+    block->size = ((size_t)(end - start) - HEAP_BLOCK_HEADER) | HEAP_BLOCK_FREE;
+    last->prev_phys = block;
+    last->size = 0;
+
+    heap_free_bytes = HEAP_BLOCK_HEADER + Heap_Size(block);
+    heap_min_free_bytes = heap_free_bytes;
+    Heap_Insert(block);
+    heap_ready = true;
+}
+
+// List of a payload size: fl from the top bit, sl from the HEAP_SL_LOG2 bits below it
+static void Heap_Mapping(size_t size, uint32_t *fl, uint32_t *sl)
+{
+    if (size < HEAP_SMALL_BLOCK)
+    {
+        *fl = 0;
+        *sl = (uint32_t)size >> HEAP_ALIGN_LOG2;
+    }
+    else
+    {
+        uint32_t top = 31U - (uint32_t)__builtin_clz((uint32_t)size);
+
+        *sl = ((uint32_t)size >> (top - HEAP_SL_LOG2)) ^ HEAP_SL_COUNT;
+        *fl = top - (HEAP_FL_SHIFT - 1U);
+    }
+}
+
+// First block of the lowest list whose blocks all hold size, else the
+// first block of the exact size list that does
+static HeapBlock_t *Heap_Find(size_t size)
+{
+    size_t rounded = size;
+    uint32_t fl;
+    uint32_t sl;
+
+    if (size >= HEAP_SMALL_BLOCK)
+    {
+        rounded += ((size_t)1 << ((31U - (uint32_t)__builtin_clz((uint32_t)size)) - HEAP_SL_LOG2)) - 1U;
+    }
+    Heap_Mapping(rounded, &fl, &sl);
+
+    if (fl < HEAP_FL_COUNT)
+    {
+        uint32_t sl_map = heap_sl_bitmap[fl] & (~0UL << sl);
+
+        if (sl_map == 0)
+        {
+            uint32_t fl_map = heap_fl_bitmap & (~0UL << (fl + 1U));
+
+            fl = (fl_map != 0) ? (uint32_t)__builtin_ctz(fl_map) : HEAP_FL_COUNT;
+            sl_map = (fl < HEAP_FL_COUNT) ? heap_sl_bitmap[fl] : 0;
+        }
+        if (sl_map != 0)
+        {
+            return heap_lists[fl][__builtin_ctz(sl_map)];
+        }
+    }
+
+    // Out of lists that are sure to fit, the size's own list may still
+    // hold a big enough block
+    if (rounded != size)
+    {
+        Heap_Mapping(size, &fl, &sl);
+        for (HeapBlock_t *block = heap_lists[fl][sl]; block != NULL; block = block->next_free)
+        {
+            if (Heap_Size(block) >= size)
+            {
+                return block;
+            }
+        }
+    }
+    return NULL;
+}
+
+static void Heap_Insert(HeapBlock_t *block)
+{
+    uint32_t fl;
+    uint32_t sl;
+
+    Heap_Mapping(Heap_Size(block), &fl, &sl);
+
+    block->prev_free = NULL;
+    block->next_free = heap_lists[fl][sl];
+    if (block->next_free != NULL)
+    {
+        block->next_free->prev_free = block;
+    }
+    heap_lists[fl][sl] = block;
+    heap_fl_bitmap |= 1UL << fl;
+    heap_sl_bitmap[fl] |= 1UL << sl;
+
+    heap_free_blocks++;
+    heap_fl_blocks[fl]++;
+}
+
+static void Heap_Remove(HeapBlock_t *block)
+{
+    uint32_t fl;
+    uint32_t sl;
+
+    Heap_Mapping(Heap_Size(block), &fl, &sl);
+
+    if (block->next_free != NULL)
+    {
+        block->next_free->prev_free = block->prev_free;
+    }
+    if (block->prev_free != NULL)
+    {
+        block->prev_free->next_free = block->next_free;
+    }
+    else
+    {
+        heap_lists[fl][sl] = block->next_free;
+        if (block->next_free == NULL)
+        {
+            heap_sl_bitmap[fl] &= ~(1UL << sl);
+            if (heap_sl_bitmap[fl] == 0)
+            {
+                heap_fl_bitmap &= ~(1UL << fl);
+            }
+        }
+    }
+
+    block->size &= ~HEAP_BLOCK_FREE;
+    heap_free_blocks--;
+    heap_fl_blocks[fl]--;
+}
+
+static HeapBlock_t *Heap_Next(const HeapBlock_t *block)
+{
+    return (HeapBlock_t *)((uint8_t *)block + HEAP_BLOCK_HEADER + Heap_Size(block));
+}
+
+static size_t Heap_Size(const HeapBlock_t *block)
+{
+    return block->size & ~HEAP_BLOCK_FREE;
+}
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
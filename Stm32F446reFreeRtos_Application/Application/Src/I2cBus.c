@@ -0,0 +1,248 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : I2cBus.c
+  * @brief          : I2C3 bus manager
+  *
+  * Clients fill an I2cBusXfer_t and queue a pointer to it. The bus task takes
+  * one descriptor at a time, starts it with the HAL DMA API and sleeps on its
+  * own task notification, which the HAL completion/error callbacks set from
+  * interrupt context. The result is then handed back to the client through
+  * its callback and/or a notification bit, so no task spins on the bus.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  * 	17-10-2026	-	HAL calls and callbacks moved to Board.c
+  * 	17-10-2026	-	Queue and task statically allocated
+  * 	17-10-2026	-	I2cBus_Transfer re-posts the caller's other notify bits
+  *
+  *
+  *
+  ******************************************************************************
+  */
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "I2cBus.h"
+#include "App.h"
+/******************************************************************************
+*							GLOBAL VARIABLES
+******************************************************************************/
+static QueueHandle_t i2c_bus_queue = NULL;
+static StaticQueue_t i2c_bus_queue_control;
+static uint8_t i2c_bus_queue_storage[I2C_BUS_QUEUE_LEN * sizeof(I2cBusXfer_t *)];
+static StackType_t i2c_bus_stack[I2C_BUS_TASK_STACK] APP_STACK;
+static StaticTask_t i2c_bus_tcb;
+static TaskHandle_t i2c_bus_task_handle = NULL;
+static I2cBusStats_t i2c_bus_stats;
+
+/******************************************************************************
+*							LOCAL FUNCTION DECLARATIONS
+******************************************************************************/
+static void I2cBus_Task(void *params);
+static HAL_StatusTypeDef I2cBus_Execute(I2cBusXfer_t *xfer);
+
+/******************************************************************************
+*							CONST DECLARATIONS
+******************************************************************************/
+
+
+/******************************************************************************
+*							API IMPLEMENTATION
+******************************************************************************/
+bool I2cBus_Init(void)
+{
+    i2c_bus_queue = xQueueCreateStatic(I2C_BUS_QUEUE_LEN, sizeof(I2cBusXfer_t *),
+                                       i2c_bus_queue_storage, &i2c_bus_queue_control);
+    if (i2c_bus_queue == NULL)
+    {
+        return false;
+    }
+
+    i2c_bus_task_handle = xTaskCreateStatic(I2cBus_Task, "I2C", I2C_BUS_TASK_STACK, NULL,
+                                            I2C_BUS_TASK_PRIORITY, i2c_bus_stack, &i2c_bus_tcb);
+    return (i2c_bus_task_handle != NULL);
+}
+
+bool I2cBus_Submit(I2cBusXfer_t *xfer, TickType_t wait)
+{
+    if ((xfer == NULL) || (i2c_bus_queue == NULL))
+    {
+        return false;
+    }
+    if ((xfer->op != I2C_BUS_OP_PROBE) && ((xfer->data == NULL) || (xfer->length == 0)))
+    {
+        return false;
+    }
+
+    xfer->status = HAL_BUSY;
+    return (xQueueSend(i2c_bus_queue, &xfer, wait) == pdPASS);
+}
+
+HAL_StatusTypeDef I2cBus_Transfer(I2cBusXfer_t *xfer)
+{
+    uint32_t notified = 0;
+    uint32_t others = 0;
+
+    xfer->notify_task = xTaskGetCurrentTaskHandle();
+    if (!I2cBus_Submit(xfer, portMAX_DELAY))
+    {
+        return HAL_ERROR;
+    }
+
+    // The bus task always completes a descriptor within its own timeout,
+    // so waiting forever cannot leave the descriptor in use after return
+    do
+    {
+        xTaskNotifyWait(0, I2C_BUS_NOTIFY_DONE, &notified, portMAX_DELAY);
+        others |= (notified & ~I2C_BUS_NOTIFY_DONE);
+    } while ((notified & I2C_BUS_NOTIFY_DONE) == 0);
+
+    // Only DONE is cleared, but waking here consumed the pending state of any
+    // other bit (SAMPLE_RING_NOTIFY, ...), post them again for their own wait
+    if (others != 0)
+    {
+        xTaskNotify(xfer->notify_task, others, eSetBits);
+    }
+
+    return xfer->status;
+}
+
+HAL_StatusTypeDef I2cBus_Write(uint16_t dev_addr, uint8_t *data, uint16_t length, uint32_t timeout_ms)
+{
+    I2cBusXfer_t xfer = { .op = I2C_BUS_OP_WRITE, .dev_addr = dev_addr, .data = data,
+                          .length = length, .timeout_ms = timeout_ms };
+    return I2cBus_Transfer(&xfer);
+}
+
+HAL_StatusTypeDef I2cBus_Read(uint16_t dev_addr, uint8_t *data, uint16_t length, uint32_t timeout_ms)
+{
+    I2cBusXfer_t xfer = { .op = I2C_BUS_OP_READ, .dev_addr = dev_addr, .data = data,
+                          .length = length, .timeout_ms = timeout_ms };
+    return I2cBus_Transfer(&xfer);
+}
+
+HAL_StatusTypeDef I2cBus_Probe(uint16_t dev_addr, uint32_t timeout_ms)
+{
+    I2cBusXfer_t xfer = { .op = I2C_BUS_OP_PROBE, .dev_addr = dev_addr, .timeout_ms = timeout_ms };
+    return I2cBus_Transfer(&xfer);
+}
+
+void I2cBus_GetStats(I2cBusStats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = i2c_bus_stats;
+    taskEXIT_CRITICAL();
+}
+
+void I2cBus_Event_FromISR(uint32_t event)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    if (i2c_bus_task_handle == NULL)
+    {
+        return;
+    }
+
+    xTaskNotifyFromISR(i2c_bus_task_handle, event, eSetBits, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/******************************************************************************
+*							LOCAL FUNCTION DEFINITIONS
+******************************************************************************/
+static void I2cBus_Task(void *params)
+{
+    I2cBusXfer_t *xfer;
+
+    while (1)
+    {
+        if (xQueueReceive(i2c_bus_queue, &xfer, portMAX_DELAY) != pdPASS)
+        {
+            continue;
+        }
+
+        HAL_StatusTypeDef status = I2cBus_Execute(xfer);
+
+        taskENTER_CRITICAL();
+        if (status == HAL_OK)
+        {
+            i2c_bus_stats.completed++;
+        }
+        else if (status == HAL_TIMEOUT)
+        {
+            i2c_bus_stats.timeouts++;
+        }
+        else
+        {
+            i2c_bus_stats.errors++;
+        }
+        taskEXIT_CRITICAL();
+
+        // The client may reuse the descriptor as soon as it is told, so
+        // read everything needed before reporting
+        TaskHandle_t notify_task = xfer->notify_task;
+        I2cBusCallback_t callback = xfer->callback;
+
+        xfer->status = status;
+        if (callback != NULL)
+        {
+            callback(xfer);
+        }
+        if (notify_task != NULL)
+        {
+            xTaskNotify(notify_task, I2C_BUS_NOTIFY_DONE, eSetBits);
+        }
+    }
+}
+
+static HAL_StatusTypeDef I2cBus_Execute(I2cBusXfer_t *xfer)
+{
+    HAL_StatusTypeDef status;
+    uint32_t events = 0;
+
+    if (xfer->op == I2C_BUS_OP_PROBE)
+    {
+        return Board_I2c_Probe(xfer->dev_addr, xfer->timeout_ms);
+    }
+
+    // Drop anything left over from an aborted transfer
+    xTaskNotifyWait(I2C_BUS_EVT_ALL, I2C_BUS_EVT_ALL, NULL, 0);
+
+    if (xfer->op == I2C_BUS_OP_WRITE)
+    {
+        status = Board_I2c_Write(xfer->dev_addr, xfer->data, xfer->length);
+    }
+    else
+    {
+        status = Board_I2c_Read(xfer->dev_addr, xfer->data, xfer->length);
+    }
+
+    if (status != HAL_OK)
+    {
+        return status;
+    }
+
+    if (xTaskNotifyWait(0, I2C_BUS_EVT_ALL, &events, pdMS_TO_TICKS(xfer->timeout_ms)) != pdTRUE)
+    {
+        // Stuck slave or lost interrupt, start again from a clean peripheral
+        Board_I2c_Recover();
+        return HAL_TIMEOUT;
+    }
+
+    return (events & I2C_BUS_EVT_ERROR) ? HAL_ERROR : HAL_OK;
+}
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
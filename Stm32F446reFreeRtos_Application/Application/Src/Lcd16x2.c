@@ -4,6 +4,22 @@
   * @file           : Lcd16x2.c
   * @brief          : Lcd16x2 Handler
   * @author         : Saturation Godi
+  *
+  * The display is driven from a 2x16 shadow framebuffer. Each new frame is
+  * diffed against what is already on the glass and only the changed cells
+  * are sent, with a cursor move only where the changed run is not contiguous.
+  * When a frame does not reach the glass its content is unknown, the next
+  * render then redraws every cell.
+  *
+  * Expander writes are not sent one by one. Every nibble is queued as an
+  * E-high/E-low byte pair and the whole sequence goes out as one I2C
+  * transaction on LCD_Flush(). The bytes are written straight into a frame
+  * from xLcdFramePool whose pointer is queued to the I2C bus manager, the bus
+  * task frees it once sent. Frames are not waited for except around the
+  * init/clear delays, which must start after the bytes reached the glass.
+  * At 100 kHz each expander byte takes ~90 us,
+  * which already covers the E pulse width and the 37 us execution time of
+  * ordinary commands, so no delays are needed between bytes.
   ******************************************************************************
   */
 
@@ -26,11 +42,29 @@
 #define READ_WRITE     0x02
 #define REGISTER_SEL   0x01
 
+#define LCD_CELL_INVALID  '\0'   // Never rendered, '\0' ends the text
+
+// Display limits so each formatted line fits its 16 cells
+#define LCD_TEMP_MAX_DDEG   9999        // "Temp: -999.9 C"
+#define LCD_SAMPLE_WRAP     100000000UL // "Sample: 99999999", then wraps to 0
+
 /******************************************************************************
 *                            GLOBAL VARIABLES
 ******************************************************************************/
-extern QueueHandle_t xTempQueue;
-extern I2C_HandleTypeDef hi2c3;
+extern MemPool_t xLcdFramePool;
+
+// Content currently shown on the glass
+static char lcd_shadow[LCD_ROWS][LCD_COLS];
+
+// DDRAM position the controller will write next, col == LCD_COLS when unknown
+static uint8_t lcd_cursor_row;
+static uint8_t lcd_cursor_col;
+
+// Frame being filled, NULL until the next byte is queued
+static LcdFrame_t *lcd_frame;
+
+// Set when a frame did not reach the glass, the next render redraws every cell
+static volatile bool lcd_redraw;
 
 /******************************************************************************
 *                            LOCAL FUNCTION DECLARATIONS
@@ -39,11 +73,14 @@ static void LCD_Send_Cmd(uint8_t cmd);
 static void LCD_Send_Data(uint8_t data);
 static void LCD_Send_4Bits(uint8_t data);
 static void LCD_Enable_Pulse(uint8_t data);
+static void LCD_Queue_Byte(uint8_t data);
+static void LCD_Flush(bool wait);
+static void LCD_Frame_Done(I2cBusXfer_t *xfer);
 
 static void LCD_Init(void);
 static void LCD_Clear(void);
 static void LCD_Set_Cursor(uint8_t row, uint8_t col);
-static void LCD_Send_String(char *str);
+static void LCD_Render(const LcdMessage_t *msg);
 
 /******************************************************************************
 *                            API IMPLEMENTATION
@@ -51,42 +88,59 @@ static void LCD_Send_String(char *str);
 void Lcd16x2_Handler(void *params)
 {
     LcdMessage_t lcdMsg;
-    float temperature_c;
-
-    TickType_t xLastWakeTime = xTaskGetTickCount();
+    SampleReader_t reader;
+    LM35_Sample_t sample;
+    int32_t temperature_ddeg;
+    uint32_t temperature_abs;
 
 #ifdef DEBUG_I2C_SCAN
     // Optional I2C scan for debugging only
     HAL_StatusTypeDef res;
     for (uint8_t i = 1; i < 128; i++) {
-        res = HAL_I2C_IsDeviceReady(&hi2c3, (i << 1), 1, 10);
+        res = I2cBus_Probe((i << 1), 10);
         if (res == HAL_OK) {
             printf("I2C device found at 0x%X\r\n", i << 1);
         }
     }
 #endif
 
+    SampleRing_Attach(&reader, true);
+
     LCD_Init();
     LCD_Clear();
-    LCD_Set_Cursor(0, 0);
-    LCD_Send_String(" LCD Ready ");
+
+    snprintf(lcdMsg.line1, sizeof(lcdMsg.line1), " LCD Ready ");
+    lcdMsg.line2[0] = '\0';
+    LCD_Render(&lcdMsg);
 
     while (1)
     {
-        if (xQueueReceive(xTempQueue, &temperature_c, portMAX_DELAY) == pdPASS)
+        // Sleep until a sample is published, then show the newest one
+        if (SampleRing_Wait(portMAX_DELAY) && SampleRing_Latest(&reader, &sample))
         {
+            // Round centi-degrees to one decimal, integer formatting only
+            temperature_ddeg = (sample.data.temperature_cdeg >= 0) ? ((sample.data.temperature_cdeg + 5) / 10)
+                                                                   : ((sample.data.temperature_cdeg - 5) / 10);
+
+            if (temperature_ddeg > LCD_TEMP_MAX_DDEG)
+            {
+                temperature_ddeg = LCD_TEMP_MAX_DDEG;
+            }
+            else if (temperature_ddeg < -LCD_TEMP_MAX_DDEG)
+            {
+                temperature_ddeg = -LCD_TEMP_MAX_DDEG;
+            }
+            temperature_abs = (uint32_t)((temperature_ddeg < 0) ? -temperature_ddeg : temperature_ddeg);
 
             // Prepare LCD message
-            snprintf(lcdMsg.line1, 16, "Temp: %.1f C", temperature_c);
-            snprintf(lcdMsg.line2, 16, "TempQueue: OK");
-
-            LCD_Clear();
-            LCD_Set_Cursor(0, 0);
-            LCD_Send_String(lcdMsg.line1);
-            LCD_Set_Cursor(1, 0);
-            LCD_Send_String(lcdMsg.line2);
+            snprintf(lcdMsg.line1, sizeof(lcdMsg.line1), "Temp: %.1s%lu.%lu C", (temperature_ddeg < 0) ? "-" : "",
+                     (unsigned long)(temperature_abs / 10), (unsigned long)(temperature_abs % 10));
+            snprintf(lcdMsg.line2, sizeof(lcdMsg.line2), "Sample: %lu",
+                     (unsigned long)(sample.sequence % LCD_SAMPLE_WRAP));
+
+            // No clear, only the changed cells are rewritten
+            LCD_Render(&lcdMsg);
         }
-        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(1000));
     }
 }
 
@@ -98,12 +152,14 @@ static void LCD_Init(void)
     vTaskDelay(pdMS_TO_TICKS(50));  // Wait for LCD power-up
 
     // Force back light ON
-    uint8_t backlight = BACKLIGHT;
-    HAL_I2C_Master_Transmit(&hi2c3, LCD_ADDR, &backlight, 1, LCD_I2C_TIMEOUT);
+    LCD_Queue_Byte(BACKLIGHT);
 
+    // Reset sequence needs long gaps, flush before each wait
     LCD_Send_4Bits(0x30);
+    LCD_Flush(true);
     vTaskDelay(pdMS_TO_TICKS(5));
     LCD_Send_4Bits(0x30);
+    LCD_Flush(true);
     vTaskDelay(pdMS_TO_TICKS(1));
     LCD_Send_4Bits(0x30);
     LCD_Send_4Bits(0x20);  // Set to 4-bit mode
@@ -111,28 +167,83 @@ static void LCD_Init(void)
     LCD_Send_Cmd(0x28);    // 4-bit, 2 lines, 5x8 font
     LCD_Send_Cmd(0x0C);    // Display ON, Cursor OFF
     LCD_Send_Cmd(0x01);    // Clear Display
+    LCD_Flush(true);
     vTaskDelay(pdMS_TO_TICKS(2));
     LCD_Send_Cmd(0x06);    // Entry mode
+    LCD_Flush(true);
 }
 
 static void LCD_Clear(void)
 {
     LCD_Send_Cmd(0x01);
+    LCD_Flush(true);
     vTaskDelay(pdMS_TO_TICKS(2));
+
+    // Clear also homes the cursor
+    memset(lcd_shadow, ' ', sizeof(lcd_shadow));
+    lcd_cursor_row = 0;
+    lcd_cursor_col = 0;
 }
 
 static void LCD_Set_Cursor(uint8_t row, uint8_t col)
 {
     uint8_t address = (row == 0) ? (0x80 + col) : (0xC0 + col);
     LCD_Send_Cmd(address);
+
+    lcd_cursor_row = row;
+    lcd_cursor_col = col;
 }
 
-static void LCD_Send_String(char *str)
+static void LCD_Render(const LcdMessage_t *msg)
 {
-    while (*str)
+    const char *lines[LCD_ROWS] = { msg->line1, msg->line2 };
+    bool redraw;
+
+    taskENTER_CRITICAL();
+    redraw = lcd_redraw;
+    lcd_redraw = false;
+    taskEXIT_CRITICAL();
+
+    // The glass content is unknown, no cell can match the shadow
+    if (redraw)
     {
-        LCD_Send_Data((uint8_t)(*str++));
+        memset(lcd_shadow, LCD_CELL_INVALID, sizeof(lcd_shadow));
+        lcd_cursor_col = LCD_COLS;
     }
+
+    for (uint8_t row = 0; row < LCD_ROWS; row++)
+    {
+        const char *text = lines[row];
+        bool end_of_text = false;
+
+        for (uint8_t col = 0; col < LCD_COLS; col++)
+        {
+            // Pad short lines with blanks so stale characters get erased
+            if (text[col] == '\0')
+            {
+                end_of_text = true;
+            }
+            char cell = end_of_text ? ' ' : text[col];
+
+            if (cell == lcd_shadow[row][col])
+            {
+                continue;
+            }
+
+            // Address counter auto-increments, only move when not already there
+            if ((lcd_cursor_row != row) || (lcd_cursor_col != col))
+            {
+                LCD_Set_Cursor(row, col);
+            }
+
+            LCD_Send_Data((uint8_t)cell);
+            lcd_shadow[row][col] = cell;
+            lcd_cursor_col++;   // Past the last column counts as unknown
+        }
+    }
+
+    // Whole frame in one transaction, nothing waits for it
+    LCD_Flush(false);
 }
 
 static void LCD_Send_Cmd(uint8_t cmd)
@@ -153,20 +264,86 @@ static void LCD_Send_Data(uint8_t data)
 
 static void LCD_Send_4Bits(uint8_t data)
 {
-    uint8_t data_t[1];
-
-    data_t[0] = data | LCD_ENABLE;
-    HAL_I2C_Master_Transmit(&hi2c3, LCD_ADDR, data_t, 1, LCD_I2C_TIMEOUT);
-    vTaskDelay(pdMS_TO_TICKS(1));  // Small delay
-
+    LCD_Queue_Byte(data | LCD_ENABLE);
     LCD_Enable_Pulse(data);
 }
 
 static void LCD_Enable_Pulse(uint8_t data)
 {
-    uint8_t data_t[1];
-    data_t[0] = data & ~LCD_ENABLE;
-    HAL_I2C_Master_Transmit(&hi2c3, LCD_ADDR, data_t, 1, LCD_I2C_TIMEOUT);
+    // Falling edge of E latches the nibble
+    LCD_Queue_Byte(data & ~LCD_ENABLE);
+}
+
+static void LCD_Queue_Byte(uint8_t data)
+{
+    if ((lcd_frame != NULL) && (lcd_frame->length >= LCD_TX_BUF_LEN))
+    {
+        LCD_Flush(false);
+    }
+
+    // Both frames on the bus, the oldest is back within one transfer
+    while (lcd_frame == NULL)
+    {
+        lcd_frame = MemPool_Alloc(&xLcdFramePool);
+        if (lcd_frame == NULL)
+        {
+            vTaskDelay(1);
+        }
+        else
+        {
+            lcd_frame->length = 0;
+        }
+    }
+
+    lcd_frame->data[lcd_frame->length++] = data;
+}
+
+static void LCD_Flush(bool wait)
+{
+    LcdFrame_t *frame = lcd_frame;
+
+    if (frame == NULL)
+    {
+        return;
+    }
+    lcd_frame = NULL;
+
+    // ~90 us per byte at 100 kHz, scale the timeout with the length
+    frame->xfer = (I2cBusXfer_t){ .op = I2C_BUS_OP_WRITE, .dev_addr = LCD_ADDR,
+                                  .data = frame->data, .length = frame->length,
+                                  .timeout_ms = LCD_I2C_TIMEOUT + (frame->length / 8U),
+                                  .context = frame };
+    if (wait)
+    {
+        I2cBus_Transfer(&frame->xfer);
+        LCD_Frame_Done(&frame->xfer);
+        return;
+    }
+
+    frame->xfer.callback = LCD_Frame_Done;
+    if (!I2cBus_Submit(&frame->xfer, portMAX_DELAY))
+    {
+        lcd_redraw = true;
+        MemPool_Free(&xLcdFramePool, frame);
+    }
+}
+
+// Bus task context, or the LCD task for waited frames
+static void LCD_Frame_Done(I2cBusXfer_t *xfer)
+{
+    LcdFrame_t *frame = (LcdFrame_t *)xfer->context;
+
+    if (xfer->status != HAL_OK)
+    {
+        TRACE("LCD I2C write failed (%u bytes)", frame->length);
+        lcd_redraw = true;
+        Health_Update(HEALTH_COMMS_LOSS, 0);
+    }
+    else
+    {
+        Health_Update(0, HEALTH_COMMS_LOSS);
+    }
+    MemPool_Free(&xLcdFramePool, frame);
 }
 
 /******************************************************************************
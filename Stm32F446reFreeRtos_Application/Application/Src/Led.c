@@ -2,7 +2,7 @@
 /**
   ******************************************************************************
   * @file           : Led.c
-  * @brief          : Led Handler
+  * @brief          : Status LED pattern engine
   ******************************************************************************
   * @attention
   *
@@ -15,6 +15,14 @@
   *
   *History: v01
   * 	17-07-2025	-	v01	- Initial version
+  * 	17-10-2026	-	LED pin driven through Board_Led_Toggle
+  * 	17-10-2026	-	Mode derived from the SampleRing, xLedModeQueue removed
+  * 	17-10-2026	-	Pattern from the highest priority active health fault,
+  * 					wakes only for an edge or a health change
+  * 	17-10-2026	-	Table driven blink/heartbeat/morse patterns stepped by a
+  * 					software timer, Led_Handler task removed
+  * 	17-10-2026	-	Step lengths scaled by Led_SetSpeed
+  * 	17-10-2026	-	Led.h included with its real case, for case sensitive hosts
   *
   *
   *
@@ -24,66 +32,131 @@
 /******************************************************************************
 *							INCLUDES
 ******************************************************************************/
-#include "led.h"
+#include "Led.h"
 #include "App.h"
 /******************************************************************************
 *							GLOBAL VARIABLES
 ******************************************************************************/
-
-/* FreeRtos Queue for LED control */
-extern QueueHandle_t xLedModeQueue;
-
+static StaticTimer_t led_timer_buffer;
+static TimerHandle_t led_timer;
+static LedMode_t led_mode;
+static uint8_t led_step;
+static volatile uint16_t led_speed = LED_SPEED_DEFAULT;
 
 
 /******************************************************************************
 *							LOCAL FUNCTION DECLARATIONS
 ******************************************************************************/
+static void Led_Timer_Callback(TimerHandle_t timer);
+static LedMode_t Led_Mode_From(EventBits_t faults);
 
 /******************************************************************************
 *							CONST DECLARATIONS
 ******************************************************************************/
+typedef struct
+{
+    EventBits_t fault;
+    LedMode_t mode;
+} LedFault_t;
 
+// Highest priority first, the first active fault picks the pattern
+static const LedFault_t led_faults[] =
+{
+    { HEALTH_OVER_TEMPERATURE,    LED_MODE_OVER_TEMP    },
+    { HEALTH_SENSOR_DISCONNECTED, LED_MODE_SENSOR_FAIL  },
+    { HEALTH_ADC_TIMEOUT,         LED_MODE_ADC_ERROR    },
+    { HEALTH_COMMS_LOSS,          LED_MODE_COMMS_LOSS   },
+};
+
+static const LedStep_t led_heartbeat[] = { LED_ON(60), LED_OFF(140), LED_ON(60), LED_OFF(1740) };
+static const LedStep_t led_fast[]      = { LED_ON(100), LED_OFF(100) };
+static const LedStep_t led_morse_s[]   = { LED_DOT, LED_DOT, LED_DOT, LED_WORD_GAP };
+static const LedStep_t led_morse_a[]   = { LED_DOT, LED_DASH, LED_WORD_GAP };
+static const LedStep_t led_morse_c[]   = { LED_DASH, LED_DOT, LED_DASH, LED_DOT, LED_WORD_GAP };
+
+#define LED_PATTERN(steps)      { (steps), sizeof(steps) / sizeof((steps)[0]) }
+
+// Indexed by LedMode_t
+static const LedPattern_t led_patterns[LED_MODE_COUNT] =
+{
+    [LED_MODE_NORMAL]      = LED_PATTERN(led_heartbeat),
+    [LED_MODE_SENSOR_FAIL] = LED_PATTERN(led_morse_s),
+    [LED_MODE_ADC_ERROR]   = LED_PATTERN(led_morse_a),
+    [LED_MODE_OVER_TEMP]   = LED_PATTERN(led_fast),
+    [LED_MODE_COMMS_LOSS]  = LED_PATTERN(led_morse_c),
+};
 
 /******************************************************************************
 *							API IMPLEMENTATION
 ******************************************************************************/
-void Led_Handler(void *pvParameters)
+bool Led_Init(void)
 {
-    LedMode_t currentMode = LED_MODE_NORMAL;
-    TickType_t xLastWakeTime = xTaskGetTickCount();
-
-    while (1)
+    // One-shot, every callback re-arms it with the length of the next step
+    led_timer = xTimerCreateStatic("LED", 1, pdFALSE, NULL, Led_Timer_Callback, &led_timer_buffer);
+    if (led_timer == NULL)
     {
-        if (xQueueReceive(xLedModeQueue, &currentMode, 0) == pdPASS)
-        {
-            // Mode updated
-        }
+        return false;
+    }
 
-        switch (currentMode)
-        {
-            case LED_MODE_SENSOR_FAIL:
-                HAL_GPIO_TogglePin(GPIOA, GPIO_PIN_5);
-                vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(200));
-                break;
-
-            case LED_MODE_ADC_ERROR:
-                HAL_GPIO_TogglePin(GPIOA, GPIO_PIN_5);
-                vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(500));
-                break;
-
-            case LED_MODE_NORMAL:
-            default:
-                HAL_GPIO_TogglePin(GPIOA, GPIO_PIN_5);
-                vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(1000));
-                break;
-        }
+    // First step runs as soon as the timer task starts
+    led_mode = LED_MODE_COUNT;
+    return (xTimerStart(led_timer, 0) == pdPASS);
+}
+
+bool Led_SetSpeed(uint16_t percent)
+{
+    if ((percent < LED_SPEED_MIN) || (percent > LED_SPEED_MAX))
+    {
+        return false;
     }
+
+    led_speed = percent;
+    return true;
+}
+
+uint16_t Led_GetSpeed(void)
+{
+    return led_speed;
 }
 
 
 /******************************************************************************
 *							LOCAL FUNCTION DEFINITIONS
 ******************************************************************************/
+// Runs in the timer service task, a health change restarts the pattern at
+// the next step boundary
+static void Led_Timer_Callback(TimerHandle_t timer)
+{
+    LedMode_t mode = Led_Mode_From(Health_Get());
+
+    if (mode != led_mode)
+    {
+        led_mode = mode;
+        led_step = 0;
+    }
+    else if (++led_step >= led_patterns[led_mode].count)
+    {
+        led_step = 0;
+    }
+
+    const LedStep_t *step = &led_patterns[led_mode].steps[led_step];
+    uint32_t ms = ((uint32_t)step->ms * 100U) / led_speed;
+
+    Board_Led_Set(step->on);
+    xTimerChangePeriod(timer, (ms > 0) ? pdMS_TO_TICKS(ms) : 1, 0);
+}
+
+static LedMode_t Led_Mode_From(EventBits_t faults)
+{
+    for (uint32_t i = 0; i < sizeof(led_faults) / sizeof(led_faults[0]); i++)
+    {
+        if (faults & led_faults[i].fault)
+        {
+            return led_faults[i].mode;
+        }
+    }
+    return LED_MODE_NORMAL;
+}
 
 
 /******************************************************************************
@@ -15,6 +15,27 @@
   *
   *History: v01
   * 	17-07-2025	-	v01	- Initial version
+  * 	17-10-2026	-	ADC1 triggered by TIM2, samples streamed by DMA2 Stream0
+  * 					into a circular double buffer. The task sleeps until a
+  * 					half/complete transfer notification instead of polling.
+  * 	17-10-2026	-	Fixed-point filter stage: median-of-k spike rejector
+  * 					followed by a CIC decimator (LM35_FILTER_* in Lm35.h).
+  * 	17-10-2026	-	Float conversion replaced by a centi-degree lookup table
+  * 					built by the preprocessor, with Q4 interpolation and
+  * 					optional gain/offset calibration.
+  * 	17-10-2026	-	Temperature published as a timestamped sample through
+  * 					the single slot xTempMailbox (overwrite, never dropped).
+  * 	17-10-2026	-	Each publication emitted as a binary TRACE record.
+  * 	17-10-2026	-	ADC/TIM2 handles and HAL callbacks moved to Board.c
+  * 	17-10-2026	-	Samples published once into the SampleRing, LED mode and
+  * 					mailbox copies removed, LM35_GetData returns a copy
+  * 	17-10-2026	-	Sensor faults reported as Health bits, only on change
+  * 	17-10-2026	-	Period, thresholds and filter settings in LM35_Config_t,
+  * 					changeable at run time (LM35_SetConfig)
+  * 	17-10-2026	-	A late wake-up feeds only the newest half, the one the
+  * 					DMA is refilling is dropped and counted as an overrun
+  * 	17-10-2026	-	No thresholds, Health update or publication until the
+  * 					filter has produced its first output (no boot fault)
   *
   *
   *
@@ -29,27 +50,110 @@
 /******************************************************************************
 *							GLOBAL VARIABLES
 ******************************************************************************/
-/* ADC Handler structure */
-extern ADC_HandleTypeDef hadc1;
-extern QueueHandle_t xLedModeQueue;
-extern QueueHandle_t xTempQueue;
 
 // Static global structure (private to lm35.c only)
 static LM35_Data_t lm35_data = {
     .adc_raw = 0,
-    .temperature_c = 0.0f,
+    .adc_q4 = 0,
+    .temperature_cdeg = 0,
     .adc_timeout_error = false,
     .sensor_disconnected = false
 };
 
+// DMA target, first half and second half are processed alternately
+static uint16_t lm35_dma_buffer[LM35_DMA_BUFFER_LEN];
+
+// Task to be woken from the DMA interrupt
+static TaskHandle_t lm35_task_handle = NULL;
+
+// Half completed most recently, written by the DMA interrupt
+static volatile uint32_t lm35_last_half = LM35_NOTIFY_FULL_CPLT;
+
+// Halves dropped because the task was still behind when the next one completed
+static volatile uint32_t lm35_overruns = 0;
+
+// Filter state, all integer arithmetic
+typedef struct
+{
+    uint8_t  median_k;                         // Settings the state was built for
+    uint8_t  decim_log2;
+    uint16_t window[LM35_FILTER_MEDIAN_MAX];   // Last k raw samples
+    uint8_t  window_index;
+    uint8_t  window_fill;
+    uint32_t integrator[LM35_FILTER_CIC_ORDER];
+    uint32_t comb_delay[LM35_FILTER_CIC_ORDER];
+    uint32_t decim_count;
+    uint32_t warmup;                           // Outputs to drop after a reset
+    uint32_t output_q4;
+    bool     valid;                            // output_q4 holds a filter output
+} LM35_Filter_t;
+
+static LM35_Filter_t lm35_filter;
+
+// Calibration, identity until LM35_SetCalibration() is called
+static LM35_Calibration_t lm35_calibration = {
+    .gain_q15 = LM35_CAL_GAIN_ONE,
+    .offset_cdeg = 0
+};
+
+// Run time settings, boot defaults from Lm35.h
+static LM35_Config_t lm35_config = {
+    .sample_period_ms = LM35_SAMPLING_DELAY,
+    .disconnect_adc = LM35_DISCONNECT_ADC,
+    .overtemp_adc = LM35_OVERTEMPERATURE_ADC,
+    .median_k = LM35_FILTER_MEDIAN_K,
+    .decim_log2 = LM35_FILTER_DECIM_LOG2
+};
+
 
 /******************************************************************************
 *							LOCAL FUNCTION DECLARATIONS
 ******************************************************************************/
+static void LM35_Start_Acquisition(void);
+static void LM35_Stop_Acquisition(void);
+static void LM35_Filter_Reset(LM35_Filter_t *filter, const LM35_Config_t *config);
+static bool LM35_Filter_Block(LM35_Filter_t *filter, const uint16_t *block, uint32_t length);
+static uint16_t LM35_Filter_Median(LM35_Filter_t *filter, uint16_t sample);
 
 /******************************************************************************
 *							CONST DECLARATIONS
 ******************************************************************************/
+#define LM35_DMA_HALF_LEN        (LM35_DMA_BUFFER_LEN / 2)
+
+#define LM35_HEALTH_FAULTS       (HEALTH_ADC_TIMEOUT | HEALTH_SENSOR_DISCONNECTED | HEALTH_OVER_TEMPERATURE)
+
+/* The boot defaults must pass the same checks as LM35_SetConfig() */
+#if (LM35_FILTER_DECIM_MIN > LM35_FILTER_DECIM_MAX)
+#error "LM35 filter: CIC order leaves no valid decimation for the fraction bits"
+#endif
+#if (LM35_FILTER_DECIM_LOG2 < LM35_FILTER_DECIM_MIN) || (LM35_FILTER_DECIM_LOG2 > LM35_FILTER_DECIM_MAX)
+#error "LM35 filter: default decimation out of range"
+#endif
+#if (LM35_FILTER_MEDIAN_K > LM35_FILTER_MEDIAN_MAX) || ((LM35_FILTER_MEDIAN_K > 0) && ((LM35_FILTER_MEDIAN_K % 2) == 0))
+#error "LM35 filter: median window must be odd and at most 7"
+#endif
+#if (LM35_SAMPLING_DELAY < LM35_SAMPLING_MIN_MS) || (LM35_SAMPLING_DELAY > LM35_SAMPLING_MAX_MS)
+#error "LM35: default sampling period out of range"
+#endif
+
+/*
+ * Centi-degrees for every ADC code, expanded by the preprocessor so the
+ * table is computed at build time and lives in flash:
+ *   cdeg = code * VREF_MV * 10 / 4095   (LM35: 10 mV/C -> 1 mV = 10 cdeg)
+ * One extra entry (code 4096) lets the Q4 interpolation read code + 1.
+ */
+#define LM35_LUT_ENTRY(code)  ((uint16_t)((((code) * LM35_VREF_MV * 10UL) + (LM35_ADC_MAX_CODE / 2)) / LM35_ADC_MAX_CODE))
+#define LM35_LUT_4(n)     LM35_LUT_ENTRY(n), LM35_LUT_ENTRY((n) + 1), LM35_LUT_ENTRY((n) + 2), LM35_LUT_ENTRY((n) + 3)
+#define LM35_LUT_16(n)    LM35_LUT_4(n), LM35_LUT_4((n) + 4), LM35_LUT_4((n) + 8), LM35_LUT_4((n) + 12)
+#define LM35_LUT_64(n)    LM35_LUT_16(n), LM35_LUT_16((n) + 16), LM35_LUT_16((n) + 32), LM35_LUT_16((n) + 48)
+#define LM35_LUT_256(n)   LM35_LUT_64(n), LM35_LUT_64((n) + 64), LM35_LUT_64((n) + 128), LM35_LUT_64((n) + 192)
+#define LM35_LUT_1024(n)  LM35_LUT_256(n), LM35_LUT_256((n) + 256), LM35_LUT_256((n) + 512), LM35_LUT_256((n) + 768)
+#define LM35_LUT_4096(n)  LM35_LUT_1024(n), LM35_LUT_1024((n) + 1024), LM35_LUT_1024((n) + 2048), LM35_LUT_1024((n) + 3072)
+
+static const uint16_t lm35_cdeg_lut[LM35_ADC_MAX_CODE + 2] = {
+    LM35_LUT_4096(0UL),
+    LM35_LUT_ENTRY(4096UL)
+};
 
 
 /******************************************************************************
@@ -57,75 +161,350 @@ static LM35_Data_t lm35_data = {
 ******************************************************************************/
 void LM35_Handler(void *pvParameters)
 {
-    LedMode_t mode;
-    TickType_t xLastWakeTime = xTaskGetTickCount();
+    uint32_t events;
+    TickType_t xLastPublish = xTaskGetTickCount();
+    LM35_Config_t config;
+
+    lm35_task_handle = xTaskGetCurrentTaskHandle();
+    LM35_GetConfig(&config);
+    LM35_Filter_Reset(&lm35_filter, &config);
+    LM35_Start_Acquisition();
 
     while(1)
     {
-        HAL_ADC_Start(&hadc1);
-        if (HAL_ADC_PollForConversion(&hadc1, LM35_ADC_TIMEOUT) == HAL_OK)
+        // One consistent copy per pass, a new filter setting restarts the filter
+        LM35_GetConfig(&config);
+        if ((config.median_k != lm35_filter.median_k) || (config.decim_log2 != lm35_filter.decim_log2))
         {
-            lm35_data.adc_raw = HAL_ADC_GetValue(&hadc1);
+            LM35_Filter_Reset(&lm35_filter, &config);
+        }
+
+        // Sleep until DMA has filled one half of the buffer
+        if ((xTaskNotifyWait(0, 0xFFFFFFFFUL, &events, pdMS_TO_TICKS(LM35_ADC_TIMEOUT)) == pdTRUE) &&
+            ((events & LM35_NOTIFY_ADC_ERROR) == 0))
+        {
+            bool output = false;
+
+            // Both bits set means the task fell behind and the DMA is already
+            // refilling the older half: keep the newest one, drop the other
+            if ((events & LM35_NOTIFY_HALF_CPLT) && (events & LM35_NOTIFY_FULL_CPLT))
+            {
+                events &= ~(LM35_NOTIFY_HALF_CPLT | LM35_NOTIFY_FULL_CPLT);
+                events |= lm35_last_half;
+                lm35_overruns++;
+                TRACE("LM35 overrun %u", lm35_overruns);
+            }
+
+            if (events & LM35_NOTIFY_HALF_CPLT)
+            {
+                output = LM35_Filter_Block(&lm35_filter, &lm35_dma_buffer[0], LM35_DMA_HALF_LEN);
+            }
+            else if (events & LM35_NOTIFY_FULL_CPLT)
+            {
+                output = LM35_Filter_Block(&lm35_filter, &lm35_dma_buffer[LM35_DMA_HALF_LEN], LM35_DMA_HALF_LEN);
+            }
+
+            if (output)
+            {
+                lm35_data.adc_q4  = lm35_filter.output_q4;
+                lm35_data.adc_raw = (lm35_filter.output_q4 + (1UL << (LM35_FILTER_FRAC_BITS - 1))) >> LM35_FILTER_FRAC_BITS;
+            }
             lm35_data.adc_timeout_error = false;
+        }
+        else
+        {
+            // No data in time or DMA/overrun error, re-arm the conversion chain
+            lm35_data.adc_timeout_error = true;
+            LM35_Stop_Acquisition();
+            LM35_Filter_Reset(&lm35_filter, &config);
+            LM35_Start_Acquisition();
+        }
 
-            if (lm35_data.adc_raw < LM35_DISCONNECT_ADC)
+        // Nothing to judge before the first filter output after a (re)start,
+        // adc_raw is not a reading yet and would look like a disconnected sensor
+        if (!lm35_data.adc_timeout_error && !lm35_filter.valid)
+        {
+            continue;
+        }
+
+        // Publish at the same rate as before, independent of the ADC rate
+        TickType_t period = pdMS_TO_TICKS(config.sample_period_ms);
+        TickType_t late = xTaskGetTickCount() - xLastPublish;
+        if (late < period)
+        {
+            continue;
+        }
+        // Keep the cadence, unless the period just got shorter by a lot
+        xLastPublish = (late < (2 * period)) ? (xLastPublish + period) : xTaskGetTickCount();
+
+        if (!lm35_data.adc_timeout_error)
+        {
+            if (lm35_data.adc_raw < config.disconnect_adc)
             {
                 lm35_data.sensor_disconnected = true;
-                lm35_data.temperature_c = -100.0f;
+                lm35_data.temperature_cdeg = LM35_TEMP_INVALID_CDEG;
             }
-            else if  (lm35_data.adc_raw > LM35_OVERTEMPERATURE_ADC)
+            else if  (lm35_data.adc_raw > config.overtemp_adc)
             {
             	lm35_data.sensor_disconnected = true;
-            	lm35_data.temperature_c = ((float)(lm35_data.adc_raw) * 3.3f * 100.0f) / 4095.0f;
+            	lm35_data.temperature_cdeg = LM35_AdcToCentiCelsius(lm35_data.adc_q4);
             }
             else
             {
                 lm35_data.sensor_disconnected = false;
-                lm35_data.temperature_c = ((float)(lm35_data.adc_raw) * 3.3f * 100.0f) / 4095.0f;
+                lm35_data.temperature_cdeg = LM35_AdcToCentiCelsius(lm35_data.adc_q4);
             }
         }
-        else
-        {
-            lm35_data.adc_timeout_error = true;
-        }
 
-        // Decide LED mode
-        if (lm35_data.sensor_disconnected)
+        // One copy into the ring, every consumer (LCD, LED, ...) reads it there
+        SampleRing_Publish(&lm35_data);
+
+        // Health bits, observers only wake when one of them changes
+        EventBits_t faults = 0;
+        if (lm35_data.adc_timeout_error)
         {
-            mode = LED_MODE_SENSOR_FAIL;
+            faults = HEALTH_ADC_TIMEOUT;
         }
-        else if (lm35_data.adc_timeout_error)
+        else if (lm35_data.adc_raw < config.disconnect_adc)
         {
-            mode = LED_MODE_ADC_ERROR;
+            faults = HEALTH_SENSOR_DISCONNECTED;
         }
-        else
+        else if (lm35_data.adc_raw > config.overtemp_adc)
         {
-            mode = LED_MODE_NORMAL;
+            faults = HEALTH_OVER_TEMPERATURE;
         }
+        Health_Update(faults, LM35_HEALTH_FAULTS & ~faults);
+
+        TRACE("LM35 adc_q4=%u temp=%d cdeg fail=%u timeout=%u", lm35_data.adc_q4,
+              lm35_data.temperature_cdeg, (uint32_t)lm35_data.sensor_disconnected,
+              (uint32_t)lm35_data.adc_timeout_error);
+    }
+}
 
-        // Send LED mode
-        xQueueSend(xLedModeQueue, &mode, 0);
 
+// Copy of the last published data, never torn by a concurrent publish
+bool LM35_GetData(LM35_Data_t *data)
+{
+    LM35_Sample_t sample;
+
+    if (!SampleRing_Latest(NULL, &sample))
+    {
+        return false;
+    }
+
+    *data = sample.data;
+    return true;
+}
+
+
+int32_t LM35_AdcToCentiCelsius(uint32_t adc_q4)
+{
+    const uint32_t frac_mask = (1UL << LM35_FILTER_FRAC_BITS) - 1;
+    uint32_t code = adc_q4 >> LM35_FILTER_FRAC_BITS;
+    uint32_t frac = adc_q4 & frac_mask;
+    int32_t cdeg;
+    int32_t gain;
+    int32_t offset;
+
+    if (code > LM35_ADC_MAX_CODE)
+    {
+        code = LM35_ADC_MAX_CODE;
+        frac = frac_mask;
+    }
+
+    // Linear interpolation between the two neighbouring codes
+    cdeg = (int32_t)lm35_cdeg_lut[code];
+    cdeg += (int32_t)((((uint32_t)(lm35_cdeg_lut[code + 1] - lm35_cdeg_lut[code]) * frac) +
+                       (1U << (LM35_FILTER_FRAC_BITS - 1))) >> LM35_FILTER_FRAC_BITS);
+
+    taskENTER_CRITICAL();
+    gain   = lm35_calibration.gain_q15;
+    offset = lm35_calibration.offset_cdeg;
+    taskEXIT_CRITICAL();
+
+    if (gain != LM35_CAL_GAIN_ONE)
+    {
+        cdeg = (int32_t)((((int64_t)cdeg * gain) + (1L << 14)) >> 15);
+    }
+
+    return cdeg + offset;
+}
 
-        // Send Temperature to the Queue
-        xQueueSend(xTempQueue, &lm35_data.temperature_c,0);  // Only keep latest update
+void LM35_SetCalibration(const LM35_Calibration_t *cal)
+{
+    taskENTER_CRITICAL();
+    lm35_calibration = *cal;
+    taskEXIT_CRITICAL();
+}
 
-        HAL_ADC_Stop(&hadc1);
+void LM35_GetCalibration(LM35_Calibration_t *cal)
+{
+    taskENTER_CRITICAL();
+    *cal = lm35_calibration;
+    taskEXIT_CRITICAL();
+}
 
-        vTaskDelayUntil(&xLastWakeTime, LM35_SAMPLING_DELAY);
+bool LM35_SetConfig(const LM35_Config_t *config)
+{
+    if ((config->sample_period_ms < LM35_SAMPLING_MIN_MS) ||
+        (config->sample_period_ms > LM35_SAMPLING_MAX_MS) ||
+        (config->disconnect_adc >= config->overtemp_adc) ||
+        (config->overtemp_adc > LM35_ADC_MAX_CODE) ||
+        (config->median_k > LM35_FILTER_MEDIAN_MAX) ||
+        ((config->median_k > 0) && ((config->median_k % 2) == 0)) ||
+        (config->decim_log2 < LM35_FILTER_DECIM_MIN) ||
+        (config->decim_log2 > LM35_FILTER_DECIM_MAX))
+    {
+        return false;
     }
+
+    taskENTER_CRITICAL();
+    lm35_config = *config;
+    taskEXIT_CRITICAL();
+    return true;
+}
+
+void LM35_GetConfig(LM35_Config_t *config)
+{
+    taskENTER_CRITICAL();
+    *config = lm35_config;
+    taskEXIT_CRITICAL();
 }
 
 
-//  Read-only pointer to structure
-const LM35_Data_t* LM35_GetData(void)
+uint32_t LM35_GetOverrunCount(void)
 {
-    return &lm35_data;
+    return lm35_overruns;
+}
+
+
+void LM35_Adc_Event_FromISR(uint32_t event)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    if (lm35_task_handle == NULL)
+    {
+        return;
+    }
+
+    if (event & (LM35_NOTIFY_HALF_CPLT | LM35_NOTIFY_FULL_CPLT))
+    {
+        lm35_last_half = event & (LM35_NOTIFY_HALF_CPLT | LM35_NOTIFY_FULL_CPLT);
+    }
+
+    xTaskNotifyFromISR(lm35_task_handle, event, eSetBits, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
 /******************************************************************************
 *							LOCAL FUNCTION DEFINITIONS
 ******************************************************************************/
+static void LM35_Start_Acquisition(void)
+{
+    if (!Board_Adc_Start(lm35_dma_buffer, LM35_DMA_BUFFER_LEN))
+    {
+        printf("LM35 ADC DMA start failed!\r\n");
+    }
+}
+
+static void LM35_Stop_Acquisition(void)
+{
+    Board_Adc_Stop();
+}
+
+static void LM35_Filter_Reset(LM35_Filter_t *filter, const LM35_Config_t *config)
+{
+    memset(filter, 0, sizeof(*filter));
+    filter->valid = false;
+    filter->median_k = config->median_k;
+    filter->decim_log2 = config->decim_log2;
+
+    // The combs need ORDER outputs before the transient has left the chain
+    filter->warmup = LM35_FILTER_CIC_ORDER;
+}
+
+/*
+ * Feeds a block of raw samples through median -> CIC.
+ * Returns true when at least one decimated output has been produced,
+ * the latest one is left in filter->output_q4.
+ */
+static bool LM35_Filter_Block(LM35_Filter_t *filter, const uint16_t *block, uint32_t length)
+{
+    bool output = false;
+
+    for (uint32_t i = 0; i < length; i++)
+    {
+        uint32_t value = LM35_Filter_Median(filter, block[i]);
+
+        // Integrator section, runs at the ADC rate (wraps modulo 2^32 by design)
+        for (uint32_t stage = 0; stage < LM35_FILTER_CIC_ORDER; stage++)
+        {
+            filter->integrator[stage] += value;
+            value = filter->integrator[stage];
+        }
+
+        if (++filter->decim_count < (1UL << filter->decim_log2))
+        {
+            continue;
+        }
+        filter->decim_count = 0;
+
+        // Comb section, runs at the decimated rate
+        for (uint32_t stage = 0; stage < LM35_FILTER_CIC_ORDER; stage++)
+        {
+            uint32_t delayed = filter->comb_delay[stage];
+            filter->comb_delay[stage] = value;
+            value -= delayed;
+        }
+
+        if (filter->warmup > 0)
+        {
+            filter->warmup--;
+            continue;
+        }
+
+        // Remove the CIC gain (2^(ORDER * DECIM_LOG2)) but keep FRAC_BITS of the growth
+        filter->output_q4 = value >> ((LM35_FILTER_CIC_ORDER * filter->decim_log2) - LM35_FILTER_FRAC_BITS);
+        filter->valid = true;
+        output = true;
+    }
+
+    return output;
+}
+
+static uint16_t LM35_Filter_Median(LM35_Filter_t *filter, uint16_t sample)
+{
+    const uint32_t k = filter->median_k;
+    uint16_t sorted[LM35_FILTER_MEDIAN_MAX];
+
+    if (k == 0)
+    {
+        return sample;
+    }
+
+    filter->window[filter->window_index] = sample;
+    filter->window_index = (filter->window_index + 1) % k;
+    if (filter->window_fill < k)
+    {
+        filter->window_fill++;
+        return sample;
+    }
+
+    // Insertion sort, k <= 7 so this stays a handful of compares
+    for (uint32_t i = 0; i < k; i++)
+    {
+        uint16_t value = filter->window[i];
+        uint32_t j = i;
+        while ((j > 0) && (sorted[j - 1] > value))
+        {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = value;
+    }
+
+    return sorted[k / 2];
+}
 
 
 /******************************************************************************
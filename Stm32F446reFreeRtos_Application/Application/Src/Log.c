@@ -0,0 +1,268 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Log.c
+  * @brief          : DMA backed printf/log transport on USART2
+  *
+  * printf ends up in _write, which only copies the bytes into a RAM ring and,
+  * if the UART is idle, starts a DMA transfer of the oldest contiguous run.
+  * Each DMA completion advances the tail and starts the next run. Producers
+  * never wait for the wire. With configUSE_NEWLIB_REENTRANT every task
+  * formats into its own newlib context, so the only shared step is the copy
+  * into the ring, which runs inside a short critical section.
+  *
+  * When the ring is full the write is dropped (or, in BLOCK mode, the task
+  * sleeps for space up to LOG_BLOCK_TIMEOUT_MS). The number of bytes lost is
+  * reported in-band with a marker line as soon as there is room again.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  *
+  *
+  *
+  ******************************************************************************
+  */
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "Log.h"
+#include "App.h"
+/******************************************************************************
+*							GLOBAL VARIABLES
+******************************************************************************/
+#if (LOG_BUFFER_SIZE & (LOG_BUFFER_SIZE - 1)) != 0
+#error "LOG_BUFFER_SIZE must be a power of two"
+#endif
+
+#define LOG_BUFFER_MASK         (LOG_BUFFER_SIZE - 1U)
+#define LOG_MARKER_MAX          40          // "\r\n[log: " + 10 digits + " bytes dropped]\r\n"
+
+extern UART_HandleTypeDef huart2;
+
+static uint8_t log_buffer[LOG_BUFFER_SIZE];
+
+// Free running indices, head written by producers, tail by the DMA side
+static volatile uint32_t log_head;
+static volatile uint32_t log_tail;
+static volatile uint32_t log_dma_len;          // Length of the run in flight, 0 when idle
+
+static volatile uint32_t log_unreported_drops;
+static volatile LogOverflow_t log_policy = LOG_OVERFLOW_DEFAULT;
+static LogStats_t log_stats;
+
+/******************************************************************************
+*							LOCAL FUNCTION DECLARATIONS
+******************************************************************************/
+static void Log_Copy(const uint8_t *data, uint32_t length);
+static void Log_Kick(void);
+static uint32_t Log_Format_Drop_Marker(char *marker, uint32_t dropped);
+
+/******************************************************************************
+*							CONST DECLARATIONS
+******************************************************************************/
+
+
+/******************************************************************************
+*							API IMPLEMENTATION
+******************************************************************************/
+uint32_t Log_Write(const char *data, uint32_t length)
+{
+    char marker[LOG_MARKER_MAX];
+    uint32_t marker_len = 0;
+    uint32_t marker_drops = log_unreported_drops;
+    bool in_isr = (xPortIsInsideInterrupt() == pdTRUE);
+    bool can_block = (log_policy == LOG_OVERFLOW_BLOCK) && !in_isr &&
+                     (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING);
+    TickType_t start = xTaskGetTickCount();
+    UBaseType_t saved_mask = 0;
+    uint32_t accepted = 0;
+
+    if ((data == NULL) || (length == 0) || (length > LOG_BUFFER_SIZE))
+    {
+        return 0;
+    }
+
+    // Formatted outside the critical section, the count is re-checked inside
+    if (marker_drops != 0)
+    {
+        marker_len = Log_Format_Drop_Marker(marker, marker_drops);
+    }
+
+    while (1)
+    {
+        if (in_isr)
+        {
+            saved_mask = taskENTER_CRITICAL_FROM_ISR();
+        }
+        else
+        {
+            taskENTER_CRITICAL();
+        }
+
+        uint32_t used = log_head - log_tail;
+        uint32_t space = LOG_BUFFER_SIZE - used;
+
+        if (length <= space)
+        {
+            if ((marker_len != 0) && ((marker_len + length) <= space) &&
+                (log_unreported_drops >= marker_drops))
+            {
+                Log_Copy((const uint8_t *)marker, marker_len);
+                log_unreported_drops -= marker_drops;
+                used += marker_len;
+            }
+
+            Log_Copy((const uint8_t *)data, length);
+            used += length;
+
+            log_stats.written += length;
+            if (used > log_stats.peak_used)
+            {
+                log_stats.peak_used = used;
+            }
+
+            Log_Kick();
+            accepted = length;
+        }
+        else if (!can_block || ((xTaskGetTickCount() - start) >= pdMS_TO_TICKS(LOG_BLOCK_TIMEOUT_MS)))
+        {
+            log_stats.dropped += length;
+            log_unreported_drops += length;
+            can_block = false;
+        }
+
+        if (in_isr)
+        {
+            taskEXIT_CRITICAL_FROM_ISR(saved_mask);
+        }
+        else
+        {
+            taskEXIT_CRITICAL();
+        }
+
+        if ((accepted != 0) || !can_block)
+        {
+            return accepted;
+        }
+
+        // BLOCK mode, let the DMA drain a bit
+        vTaskDelay(1);
+    }
+}
+
+void Log_SetOverflowPolicy(LogOverflow_t policy)
+{
+    log_policy = policy;
+}
+
+void Log_GetStats(LogStats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = log_stats;
+    taskEXIT_CRITICAL();
+}
+
+void Log_TxComplete_FromISR(void)
+{
+    UBaseType_t saved_mask = taskENTER_CRITICAL_FROM_ISR();
+
+    // On a TX error the run is discarded as well, the stream moves on
+    log_tail += log_dma_len;
+    log_dma_len = 0;
+    Log_Kick();
+
+    taskEXIT_CRITICAL_FROM_ISR(saved_mask);
+}
+
+// newlib hook, every printf/puts on stdout and stderr ends up here
+int _write(int file, char *ptr, int len)
+{
+    (void)file;
+
+    // Lost bytes are counted in the stats, newlib must not see an error
+    Log_Write(ptr, (uint32_t)len);
+    return len;
+}
+
+/******************************************************************************
+*							LOCAL FUNCTION DEFINITIONS
+******************************************************************************/
+// Caller holds the critical section and has checked the space
+static void Log_Copy(const uint8_t *data, uint32_t length)
+{
+    uint32_t offset = log_head & LOG_BUFFER_MASK;
+    uint32_t first = LOG_BUFFER_SIZE - offset;
+
+    if (first > length)
+    {
+        first = length;
+    }
+
+    memcpy(&log_buffer[offset], data, first);
+    memcpy(&log_buffer[0], data + first, length - first);
+    log_head += length;
+}
+
+// Caller holds the critical section
+static void Log_Kick(void)
+{
+    uint32_t pending = log_head - log_tail;
+    uint32_t offset = log_tail & LOG_BUFFER_MASK;
+    uint32_t chunk = LOG_BUFFER_SIZE - offset;
+
+    if ((log_dma_len != 0) || (pending == 0))
+    {
+        return;
+    }
+
+    // DMA cannot wrap, send up to the end of the buffer first
+    if (chunk > pending)
+    {
+        chunk = pending;
+    }
+
+    if (HAL_UART_Transmit_DMA(&huart2, &log_buffer[offset], (uint16_t)chunk) == HAL_OK)
+    {
+        log_dma_len = chunk;
+    }
+}
+
+static uint32_t Log_Format_Drop_Marker(char *marker, uint32_t dropped)
+{
+    static const char prefix[] = "\r\n[log: ";
+    static const char suffix[] = " bytes dropped]\r\n";
+    char digits[10];
+    uint32_t count = 0;
+    uint32_t len = 0;
+
+    do
+    {
+        digits[count++] = (char)('0' + (dropped % 10U));
+        dropped /= 10U;
+    } while (dropped != 0);
+
+    memcpy(marker, prefix, sizeof(prefix) - 1);
+    len = sizeof(prefix) - 1;
+    while (count != 0)
+    {
+        marker[len++] = digits[--count];
+    }
+    memcpy(&marker[len], suffix, sizeof(suffix) - 1);
+    len += sizeof(suffix) - 1;
+
+    return len;
+}
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
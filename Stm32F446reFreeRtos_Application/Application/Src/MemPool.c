@@ -0,0 +1,151 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : MemPool.c
+  * @brief          : Fixed-block memory pools. Producers fill a block and pass
+  *                   its pointer through a queue or mailbox, the consumer
+  *                   frees it, so payloads are never copied on the way.
+  *
+  * The free list is a LIFO of freed blocks linked through their first word,
+  * blocks that were never used are handed out from a fresh index so a pool
+  * needs no initialisation pass. Each operation is a few instructions under
+  * the interrupt mask (BASEPRI), which works in task and interrupt context.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  *
+  *
+  *
+  ******************************************************************************
+  */
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "MemPool.h"
+#include "App.h"
+/******************************************************************************
+*							GLOBAL VARIABLES
+******************************************************************************/
+static MemPool_t *mempool_registry = NULL;
+
+/******************************************************************************
+*							LOCAL FUNCTION DECLARATIONS
+******************************************************************************/
+
+/******************************************************************************
+*							CONST DECLARATIONS
+******************************************************************************/
+
+
+/******************************************************************************
+*							API IMPLEMENTATION
+******************************************************************************/
+void MemPool_Init(MemPool_t *pool)
+{
+    taskENTER_CRITICAL();
+    pool->free_list = NULL;
+    pool->fresh = 0;
+    pool->next = mempool_registry;
+    mempool_registry = pool;
+    taskEXIT_CRITICAL();
+}
+
+void *MemPool_Alloc(MemPool_t *pool)
+{
+    void *block = NULL;
+    UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+
+    if (pool->free_list != NULL)
+    {
+        block = pool->free_list;
+        pool->free_list = *(void **)block;
+    }
+    else if (pool->fresh < pool->block_count)
+    {
+        block = &pool->storage[(uint32_t)pool->fresh * pool->block_size];
+        pool->fresh++;
+    }
+
+    if (block != NULL)
+    {
+        pool->allocs++;
+        if (++pool->in_use > pool->peak_in_use)
+        {
+            pool->peak_in_use = pool->in_use;
+        }
+    }
+    else
+    {
+        pool->exhausted++;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+
+    if ((block == NULL) && (pool->on_exhausted != NULL))
+    {
+        pool->on_exhausted(pool);
+    }
+
+    return block;
+}
+
+void MemPool_Free(MemPool_t *pool, void *block)
+{
+    if (block == NULL)
+    {
+        return;
+    }
+
+    // Must be the start of a block of this pool
+    configASSERT(((uint8_t *)block >= pool->storage) &&
+                 ((uint8_t *)block < &pool->storage[(uint32_t)pool->block_count * pool->block_size]) &&
+                 ((((uint8_t *)block - pool->storage) % pool->block_size) == 0));
+
+    UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+    configASSERT(pool->in_use != 0);
+    *(void **)block = pool->free_list;
+    pool->free_list = block;
+    pool->in_use--;
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+
+void MemPool_SetExhaustedHook(MemPool_t *pool, MemPoolHook_t hook)
+{
+    pool->on_exhausted = hook;
+}
+
+void MemPool_GetStats(MemPool_t *pool, MemPoolStats_t *stats)
+{
+    UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+    stats->name = pool->name;
+    stats->block_size = pool->block_size;
+    stats->block_count = pool->block_count;
+    stats->in_use = pool->in_use;
+    stats->peak_in_use = pool->peak_in_use;
+    stats->allocs = pool->allocs;
+    stats->exhausted = pool->exhausted;
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+
+MemPool_t *MemPool_Next(MemPool_t *pool)
+{
+    return (pool == NULL) ? mempool_registry : pool->next;
+}
+
+/******************************************************************************
+*							LOCAL FUNCTION DEFINITIONS
+******************************************************************************/
+
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
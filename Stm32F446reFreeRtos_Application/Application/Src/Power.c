@@ -0,0 +1,105 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Power.c
+  * @brief          : Tickless idle hooks
+  *
+  * FreeRTOS stops the SysTick while every task is blocked and sleeps (WFI)
+  * until the next timeout or interrupt, then steps the RTOS tick by the time
+  * actually slept. vTaskDelayUntil based timing (LM35 publish) and software
+  * timers (LED patterns) are therefore unaffected.
+  *
+  * The HAL time base is a separate 1 kHz TIM1 interrupt and would wake the
+  * core every millisecond on its own. It is suspended for the duration of the
+  * sleep and uwTick is advanced afterwards by the time measured on TIM5 (the
+  * 1 MHz run-time stats counter, which keeps running in sleep), so HAL_GetTick
+  * based timeouts stay correct.
+  *
+  * SLEEP is used rather than STOP: TIM2/ADC1/DMA keep sampling the LM35 at
+  * 1 kHz and the UART/I2C DMA transfers must complete, none of which run with
+  * the clocks stopped (and the F446 has no LPTIM to time a STOP period).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  *
+  *
+  *
+  ******************************************************************************
+  */
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "Power.h"
+#include "App.h"
+/******************************************************************************
+*							GLOBAL VARIABLES
+******************************************************************************/
+extern TIM_HandleTypeDef htim1;
+extern TIM_HandleTypeDef htim5;
+
+static uint32_t power_sleep_start_us;
+static uint32_t power_carry_us;         // Sub-millisecond rest, added next time
+static PowerStats_t power_stats;
+
+/******************************************************************************
+*							LOCAL FUNCTION DECLARATIONS
+******************************************************************************/
+
+/******************************************************************************
+*							CONST DECLARATIONS
+******************************************************************************/
+
+
+/******************************************************************************
+*							API IMPLEMENTATION
+******************************************************************************/
+void PreSleepProcessing(uint32_t ulExpectedIdleTime)
+{
+    (void)ulExpectedIdleTime;
+
+    HAL_SuspendTick();
+    power_sleep_start_us = htim5.Instance->CNT;
+}
+
+void PostSleepProcessing(uint32_t ulExpectedIdleTime)
+{
+    (void)ulExpectedIdleTime;
+
+    uint32_t slept_us = (htim5.Instance->CNT - power_sleep_start_us) + power_carry_us;
+    uint32_t slept_ms = slept_us / 1000U;
+
+    power_carry_us = slept_us % 1000U;
+    uwTick += slept_ms;     // uwTick counts milliseconds whatever uwTickFreq is
+
+    // The update that fell during the sleep is already accounted for above
+    __HAL_TIM_CLEAR_IT(&htim1, TIM_IT_UPDATE);
+    HAL_ResumeTick();
+
+    power_stats.sleeps++;
+    power_stats.slept_ms += slept_ms;
+}
+
+void Power_GetStats(PowerStats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = power_stats;
+    taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+*							LOCAL FUNCTION DEFINITIONS
+******************************************************************************/
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
@@ -0,0 +1,361 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Rpc.c
+  * @brief          : Runtime reconfiguration commands over USART1 (HC-05).
+  *
+  * The task collects the bytes between two 0x00 delimiters from the USART1
+  * receive stream, decodes and CRC checks the frame and looks the command up
+  * in rpc_commands. Handlers only call the modules' setters/getters (short
+  * critical sections, no blocking), so a command is answered in well under
+  * a millisecond. The response goes out through Telemetry_Send and
+  * interleaves with the sample frames on the same link.
+  *
+  * The dispatch time of every request is measured on the 1 MHz run-time
+  * stats counter, from the closing delimiter to the return of the handler.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  * 	17-10-2026	-	SET_ALERT command, alert settings in GET_CONFIG
+  *
+  *
+  *
+  ******************************************************************************
+  */
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "Rpc.h"
+#include "App.h"
+/******************************************************************************
+*							GLOBAL VARIABLES
+******************************************************************************/
+#define RPC_REQUEST_MAX         (RPC_REQUEST_HEADER_LEN + RPC_ARGS_MAX + TELEMETRY_CRC_LEN)
+#define RPC_RESPONSE_MAX        (RPC_RESPONSE_HEADER_LEN + RPC_RESULT_MAX + TELEMETRY_CRC_LEN)
+#define RPC_RX_MAX              COBS_ENCODED_MAX(RPC_REQUEST_MAX)
+
+// Calibration the RPC accepts: gain 0.5 .. 2.0, offset +/-10 C
+#define RPC_CAL_GAIN_MIN        (LM35_CAL_GAIN_ONE / 2)
+#define RPC_CAL_GAIN_MAX        (LM35_CAL_GAIN_ONE * 2)
+#define RPC_CAL_OFFSET_MAX      1000
+
+// Encoded frame being collected, rpc_rx_overflow drops it at the delimiter
+static uint8_t rpc_rx[RPC_RX_MAX];
+static uint32_t rpc_rx_len;
+static bool rpc_rx_overflow;
+
+static uint8_t rpc_request[RPC_REQUEST_MAX];
+static uint8_t rpc_response[RPC_RESPONSE_MAX];
+
+static RpcStats_t rpc_stats;
+static uint32_t rpc_total_us;
+
+typedef RpcStatus_t (*RpcHandler_t)(const uint8_t *args, uint8_t *result, uint32_t *result_len);
+
+typedef struct
+{
+    uint8_t command;
+    uint8_t arg_len;
+    RpcHandler_t handler;
+} RpcEntry_t;
+
+/******************************************************************************
+*							LOCAL FUNCTION DECLARATIONS
+******************************************************************************/
+static void Rpc_Frame(uint32_t start_us);
+static void Rpc_Account(RpcStatus_t status, uint32_t elapsed_us, bool corrupt);
+static uint16_t Rpc_Get_U16(const uint8_t *src);
+static uint32_t Rpc_Get_U32(const uint8_t *src);
+
+static RpcStatus_t Rpc_Ping(const uint8_t *args, uint8_t *result, uint32_t *result_len);
+static RpcStatus_t Rpc_Get_Config(const uint8_t *args, uint8_t *result, uint32_t *result_len);
+static RpcStatus_t Rpc_Set_Period(const uint8_t *args, uint8_t *result, uint32_t *result_len);
+static RpcStatus_t Rpc_Set_Thresholds(const uint8_t *args, uint8_t *result, uint32_t *result_len);
+static RpcStatus_t Rpc_Set_Filter(const uint8_t *args, uint8_t *result, uint32_t *result_len);
+static RpcStatus_t Rpc_Set_Calibration(const uint8_t *args, uint8_t *result, uint32_t *result_len);
+static RpcStatus_t Rpc_Set_Led_Speed(const uint8_t *args, uint8_t *result, uint32_t *result_len);
+static RpcStatus_t Rpc_Set_Alert(const uint8_t *args, uint8_t *result, uint32_t *result_len);
+static RpcStatus_t Rpc_Get_Stats(const uint8_t *args, uint8_t *result, uint32_t *result_len);
+
+/******************************************************************************
+*							CONST DECLARATIONS
+******************************************************************************/
+_Static_assert(RPC_RESPONSE_MAX <= TELEMETRY_PAYLOAD_MAX, "Rpc: response larger than a telemetry frame");
+
+static const RpcEntry_t rpc_commands[] =
+{
+    { RPC_CMD_PING,            0, Rpc_Ping            },
+    { RPC_CMD_GET_CONFIG,      0, Rpc_Get_Config      },
+    { RPC_CMD_SET_PERIOD,      2, Rpc_Set_Period      },
+    { RPC_CMD_SET_THRESHOLDS,  4, Rpc_Set_Thresholds  },
+    { RPC_CMD_SET_FILTER,      2, Rpc_Set_Filter      },
+    { RPC_CMD_SET_CALIBRATION, 8, Rpc_Set_Calibration },
+    { RPC_CMD_SET_LED_SPEED,   2, Rpc_Set_Led_Speed   },
+    { RPC_CMD_SET_ALERT,       3, Rpc_Set_Alert       },
+    { RPC_CMD_GET_STATS,       0, Rpc_Get_Stats       },
+};
+
+/******************************************************************************
+*							API IMPLEMENTATION
+******************************************************************************/
+void Rpc_Handler(void *params)
+{
+    uint8_t chunk[32];
+
+    while (1)
+    {
+        size_t n = UartRx_Read(UART_RX_BT, chunk, sizeof(chunk), portMAX_DELAY);
+
+        for (size_t i = 0; i < n; i++)
+        {
+            if (chunk[i] != COBS_DELIMITER)
+            {
+                if (rpc_rx_len < RPC_RX_MAX)
+                {
+                    rpc_rx[rpc_rx_len++] = chunk[i];
+                }
+                else
+                {
+                    rpc_rx_overflow = true;
+                }
+                continue;
+            }
+
+            // Back to back delimiters (frame start and end) are empty frames
+            if (rpc_rx_overflow)
+            {
+                Rpc_Account(RPC_STATUS_OK, 0, true);
+            }
+            else if (rpc_rx_len > 0)
+            {
+                Rpc_Frame(getRunTimeCounterValue());
+            }
+            rpc_rx_len = 0;
+            rpc_rx_overflow = false;
+        }
+    }
+}
+
+void Rpc_GetStats(RpcStats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = rpc_stats;
+    taskEXIT_CRITICAL();
+}
+
+
+/******************************************************************************
+*							LOCAL FUNCTION DEFINITIONS
+******************************************************************************/
+static void Rpc_Frame(uint32_t start_us)
+{
+    uint32_t len = Cobs_Decode(rpc_rx, rpc_rx_len, rpc_request, sizeof(rpc_request));
+
+    if ((len < (RPC_REQUEST_HEADER_LEN + TELEMETRY_CRC_LEN)) ||
+        (Crc16_Update(CRC16_INIT, rpc_request, len - TELEMETRY_CRC_LEN) !=
+         Rpc_Get_U16(&rpc_request[len - TELEMETRY_CRC_LEN])) ||
+        (rpc_request[0] != TELEMETRY_SCHEMA_VERSION) ||
+        (rpc_request[1] != TELEMETRY_TYPE_RPC_REQUEST))
+    {
+        Rpc_Account(RPC_STATUS_OK, 0, true);
+        return;
+    }
+
+    uint8_t command = rpc_request[3];
+    uint32_t arg_len = len - RPC_REQUEST_HEADER_LEN - TELEMETRY_CRC_LEN;
+    uint32_t result_len = 0;
+    RpcStatus_t status = RPC_STATUS_UNKNOWN_CMD;
+
+    for (uint32_t i = 0; i < sizeof(rpc_commands) / sizeof(rpc_commands[0]); i++)
+    {
+        if (rpc_commands[i].command != command)
+        {
+            continue;
+        }
+
+        status = RPC_STATUS_BAD_LENGTH;
+        if (arg_len == rpc_commands[i].arg_len)
+        {
+            status = rpc_commands[i].handler(&rpc_request[RPC_REQUEST_HEADER_LEN],
+                                             &rpc_response[RPC_RESPONSE_HEADER_LEN], &result_len);
+        }
+        break;
+    }
+
+    uint32_t elapsed_us = getRunTimeCounterValue() - start_us;
+    Rpc_Account(status, elapsed_us, false);
+
+    uint32_t out = 0;
+    rpc_response[out++] = TELEMETRY_SCHEMA_VERSION;
+    rpc_response[out++] = TELEMETRY_TYPE_RPC_RESPONSE;
+    rpc_response[out++] = rpc_request[2];
+    rpc_response[out++] = command;
+    rpc_response[out++] = (uint8_t)status;
+    out += Telemetry_Put_U16(&rpc_response[out], (elapsed_us > 0xFFFF) ? 0xFFFF : (uint16_t)elapsed_us);
+    out += (status == RPC_STATUS_OK) ? result_len : 0;
+
+    if (!Telemetry_Send(rpc_response, out))
+    {
+        taskENTER_CRITICAL();
+        rpc_stats.dropped++;
+        taskEXIT_CRITICAL();
+        TRACE("RPC response %u dropped, TX busy", (uint32_t)rpc_request[2]);
+    }
+}
+
+static void Rpc_Account(RpcStatus_t status, uint32_t elapsed_us, bool corrupt)
+{
+    taskENTER_CRITICAL();
+    if (corrupt)
+    {
+        rpc_stats.corrupt++;
+    }
+    else
+    {
+        rpc_stats.requests++;
+        rpc_stats.errors += (status != RPC_STATUS_OK) ? 1U : 0U;
+        rpc_total_us += elapsed_us;
+        rpc_stats.avg_us = (uint16_t)(rpc_total_us / rpc_stats.requests);
+        if (elapsed_us > rpc_stats.max_us)
+        {
+            rpc_stats.max_us = (elapsed_us > 0xFFFF) ? 0xFFFF : (uint16_t)elapsed_us;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+static uint16_t Rpc_Get_U16(const uint8_t *src)
+{
+    return (uint16_t)(src[0] | (src[1] << 8));
+}
+
+static uint32_t Rpc_Get_U32(const uint8_t *src)
+{
+    return (uint32_t)src[0] | ((uint32_t)src[1] << 8) | ((uint32_t)src[2] << 16) | ((uint32_t)src[3] << 24);
+}
+
+static RpcStatus_t Rpc_Ping(const uint8_t *args, uint8_t *result, uint32_t *result_len)
+{
+    *result_len = Telemetry_Put_U32(result, (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS));
+    return RPC_STATUS_OK;
+}
+
+static RpcStatus_t Rpc_Get_Config(const uint8_t *args, uint8_t *result, uint32_t *result_len)
+{
+    LM35_Config_t config;
+    LM35_Calibration_t cal;
+    AlertConfig_t alert;
+    uint32_t len = 0;
+
+    LM35_GetConfig(&config);
+    LM35_GetCalibration(&cal);
+    Alert_GetConfig(&alert);
+
+    len += Telemetry_Put_U16(&result[len], config.sample_period_ms);
+    len += Telemetry_Put_U16(&result[len], config.disconnect_adc);
+    len += Telemetry_Put_U16(&result[len], config.overtemp_adc);
+    result[len++] = config.median_k;
+    result[len++] = config.decim_log2;
+    len += Telemetry_Put_U32(&result[len], (uint32_t)cal.gain_q15);
+    len += Telemetry_Put_U32(&result[len], (uint32_t)cal.offset_cdeg);
+    len += Telemetry_Put_U16(&result[len], Led_GetSpeed());
+    len += Telemetry_Put_U16(&result[len], alert.window_s);
+    result[len++] = alert.channel;
+
+    *result_len = len;
+    return RPC_STATUS_OK;
+}
+
+static RpcStatus_t Rpc_Set_Period(const uint8_t *args, uint8_t *result, uint32_t *result_len)
+{
+    LM35_Config_t config;
+
+    // Read-modify-write, the RPC task is the only writer
+    LM35_GetConfig(&config);
+    config.sample_period_ms = Rpc_Get_U16(&args[0]);
+    return LM35_SetConfig(&config) ? RPC_STATUS_OK : RPC_STATUS_BAD_VALUE;
+}
+
+static RpcStatus_t Rpc_Set_Thresholds(const uint8_t *args, uint8_t *result, uint32_t *result_len)
+{
+    LM35_Config_t config;
+
+    LM35_GetConfig(&config);
+    config.disconnect_adc = Rpc_Get_U16(&args[0]);
+    config.overtemp_adc = Rpc_Get_U16(&args[2]);
+    return LM35_SetConfig(&config) ? RPC_STATUS_OK : RPC_STATUS_BAD_VALUE;
+}
+
+static RpcStatus_t Rpc_Set_Filter(const uint8_t *args, uint8_t *result, uint32_t *result_len)
+{
+    LM35_Config_t config;
+
+    LM35_GetConfig(&config);
+    config.median_k = args[0];
+    config.decim_log2 = args[1];
+    return LM35_SetConfig(&config) ? RPC_STATUS_OK : RPC_STATUS_BAD_VALUE;
+}
+
+static RpcStatus_t Rpc_Set_Calibration(const uint8_t *args, uint8_t *result, uint32_t *result_len)
+{
+    LM35_Calibration_t cal = {
+        .gain_q15 = (int32_t)Rpc_Get_U32(&args[0]),
+        .offset_cdeg = (int32_t)Rpc_Get_U32(&args[4])
+    };
+
+    if ((cal.gain_q15 < RPC_CAL_GAIN_MIN) || (cal.gain_q15 > RPC_CAL_GAIN_MAX) ||
+        (cal.offset_cdeg < -RPC_CAL_OFFSET_MAX) || (cal.offset_cdeg > RPC_CAL_OFFSET_MAX))
+    {
+        return RPC_STATUS_BAD_VALUE;
+    }
+
+    LM35_SetCalibration(&cal);
+    return RPC_STATUS_OK;
+}
+
+static RpcStatus_t Rpc_Set_Led_Speed(const uint8_t *args, uint8_t *result, uint32_t *result_len)
+{
+    return Led_SetSpeed(Rpc_Get_U16(&args[0])) ? RPC_STATUS_OK : RPC_STATUS_BAD_VALUE;
+}
+
+static RpcStatus_t Rpc_Set_Alert(const uint8_t *args, uint8_t *result, uint32_t *result_len)
+{
+    AlertConfig_t config = {
+        .window_s = Rpc_Get_U16(&args[0]),
+        .channel = args[2]
+    };
+
+    return Alert_SetConfig(&config) ? RPC_STATUS_OK : RPC_STATUS_BAD_VALUE;
+}
+
+static RpcStatus_t Rpc_Get_Stats(const uint8_t *args, uint8_t *result, uint32_t *result_len)
+{
+    RpcStats_t stats;
+    uint32_t len = 0;
+
+    Rpc_GetStats(&stats);
+    len += Telemetry_Put_U32(&result[len], stats.requests);
+    len += Telemetry_Put_U32(&result[len], stats.errors);
+    len += Telemetry_Put_U32(&result[len], stats.corrupt);
+    len += Telemetry_Put_U32(&result[len], stats.dropped);
+    len += Telemetry_Put_U16(&result[len], stats.avg_us);
+    len += Telemetry_Put_U16(&result[len], stats.max_us);
+
+    *result_len = len;
+    return RPC_STATUS_OK;
+}
+
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
@@ -0,0 +1,203 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : SampleRing.c
+  * @brief          : Lock-free ring of timestamped LM35 samples, one writer
+  *                   and any number of readers each with its own cursor.
+  *
+  * Sample n (n >= 1) lives in slot n % SAMPLE_RING_LEN. The slot carries a
+  * seqlock word: 2n - 1 while the producer writes it, 2n once complete. A
+  * reader copies the slot and accepts the copy only if the word read before
+  * and after is 2n, otherwise the producer lapped it during the copy and it
+  * moves forward. Readers never block the producer and never see a torn
+  * sample, readers that fall more than SAMPLE_RING_LEN behind skip ahead and
+  * count the skipped samples.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  *
+  *
+  *
+  ******************************************************************************
+  */
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "SampleRing.h"
+#include "App.h"
+/******************************************************************************
+*							GLOBAL VARIABLES
+******************************************************************************/
+typedef struct
+{
+    volatile uint32_t lock;     // 2n - 1 writing sample n, 2n holding it
+    LM35_Sample_t sample;
+} SampleSlot_t;
+
+static SampleSlot_t sample_ring[SAMPLE_RING_LEN];
+static volatile uint32_t sample_ring_head;     // Last published sequence, 0 = none
+
+static TaskHandle_t sample_ring_waiters[SAMPLE_RING_MAX_READERS];
+static UBaseType_t sample_ring_waiter_count;
+
+/******************************************************************************
+*							LOCAL FUNCTION DECLARATIONS
+******************************************************************************/
+static bool SampleRing_Copy(uint32_t sequence, LM35_Sample_t *sample);
+
+/******************************************************************************
+*							CONST DECLARATIONS
+******************************************************************************/
+#define SAMPLE_RING_MASK        (SAMPLE_RING_LEN - 1U)
+
+#if (SAMPLE_RING_LEN & SAMPLE_RING_MASK) != 0
+#error "SAMPLE_RING_LEN must be a power of two"
+#endif
+
+/******************************************************************************
+*							API IMPLEMENTATION
+******************************************************************************/
+void SampleRing_Publish(const LM35_Data_t *data)
+{
+    uint32_t sequence = sample_ring_head + 1U;
+    SampleSlot_t *slot = &sample_ring[sequence & SAMPLE_RING_MASK];
+
+    slot->lock = (2U * sequence) - 1U;
+    __DMB();
+    slot->sample.timestamp = xTaskGetTickCount();
+    slot->sample.sequence = sequence;
+    slot->sample.data = *data;
+    __DMB();
+    slot->lock = 2U * sequence;
+    __DMB();
+    sample_ring_head = sequence;
+
+    for (UBaseType_t i = 0; i < sample_ring_waiter_count; i++)
+    {
+        xTaskNotify(sample_ring_waiters[i], SAMPLE_RING_NOTIFY, eSetBits);
+    }
+}
+
+bool SampleRing_Attach(SampleReader_t *reader, bool notify)
+{
+    reader->next = sample_ring_head + 1U;
+    reader->lost = 0;
+    reader->task = NULL;
+
+    if (!notify)
+    {
+        return true;
+    }
+
+    taskENTER_CRITICAL();
+    if (sample_ring_waiter_count < SAMPLE_RING_MAX_READERS)
+    {
+        reader->task = xTaskGetCurrentTaskHandle();
+        sample_ring_waiters[sample_ring_waiter_count++] = reader->task;
+    }
+    taskEXIT_CRITICAL();
+
+    return (reader->task != NULL);
+}
+
+bool SampleRing_Read(SampleReader_t *reader, LM35_Sample_t *sample)
+{
+    while (1)
+    {
+        uint32_t head = sample_ring_head;
+        __DMB();
+
+        if ((int32_t)(reader->next - head) > 0)
+        {
+            return false;   // Nothing new
+        }
+
+        // Lapped, the oldest sample still in the ring is head - LEN + 1
+        if ((head - reader->next) >= SAMPLE_RING_LEN)
+        {
+            uint32_t oldest = head - SAMPLE_RING_LEN + 1U;
+            reader->lost += oldest - reader->next;
+            reader->next = oldest;
+        }
+
+        if (SampleRing_Copy(reader->next, sample))
+        {
+            reader->next++;
+            return true;
+        }
+
+        // Slot already taken by a newer sample, possibly still being written
+        // by a producer this reader preempted: count it lost and move on
+        reader->lost++;
+        reader->next++;
+    }
+}
+
+bool SampleRing_Latest(SampleReader_t *reader, LM35_Sample_t *sample)
+{
+    while (1)
+    {
+        uint32_t head = sample_ring_head;
+        __DMB();
+
+        if (head == 0)
+        {
+            return false;   // Nothing published yet
+        }
+
+        if (SampleRing_Copy(head, sample))
+        {
+            if ((reader != NULL) && ((int32_t)(head + 1U - reader->next) > 0))
+            {
+                reader->next = head + 1U;
+            }
+            return true;
+        }
+    }
+}
+
+bool SampleRing_Wait(TickType_t timeout)
+{
+    uint32_t notified = 0;
+
+    if (xTaskNotifyWait(0, SAMPLE_RING_NOTIFY, &notified, timeout) != pdTRUE)
+    {
+        return false;
+    }
+
+    return ((notified & SAMPLE_RING_NOTIFY) != 0);
+}
+
+/******************************************************************************
+*							LOCAL FUNCTION DEFINITIONS
+******************************************************************************/
+static bool SampleRing_Copy(uint32_t sequence, LM35_Sample_t *sample)
+{
+    const SampleSlot_t *slot = &sample_ring[sequence & SAMPLE_RING_MASK];
+    uint32_t lock = slot->lock;
+
+    __DMB();
+    if (lock != (2U * sequence))
+    {
+        return false;
+    }
+
+    *sample = slot->sample;
+    __DMB();
+
+    return (slot->lock == lock);
+}
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
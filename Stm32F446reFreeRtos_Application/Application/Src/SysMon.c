@@ -0,0 +1,214 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : SysMon.c
+  * @brief          : System monitor, per-task CPU load from FreeRTOS run-time
+  *                   stats clocked by TIM5 (1 MHz, 32-bit free running).
+  *
+  * TIM5 keeps counting while the core sleeps in WFI, unlike the DWT cycle
+  * counter, so idle time is accounted correctly. CPU load is computed over
+  * each report window from the difference of the per-task counters, so the
+  * 32-bit wrap of the totals does not matter.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  * 	17-10-2026	-	Memory pool usage report
+  * 	17-10-2026	-	UART receive statistics
+  * 	17-10-2026	-	RPC command channel statistics
+  * 	17-10-2026	-	SIM800 command latency per type
+  * 	17-10-2026	-	Alert batching statistics
+  * 	17-10-2026	-	Task overflow reported instead of an empty task list
+  *
+  *
+  *
+  ******************************************************************************
+  */
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "SysMon.h"
+#include "App.h"
+/******************************************************************************
+*							GLOBAL VARIABLES
+******************************************************************************/
+extern TIM_HandleTypeDef htim5;
+
+static TaskStatus_t sysmon_status[SYSMON_MAX_TASKS];
+
+// Counters from the previous window, matched by xTaskNumber
+static UBaseType_t sysmon_prev_number[SYSMON_MAX_TASKS];
+static uint32_t sysmon_prev_runtime[SYSMON_MAX_TASKS];
+static UBaseType_t sysmon_prev_count;
+static uint32_t sysmon_prev_total;
+static PowerStats_t sysmon_prev_power;
+
+/******************************************************************************
+*							LOCAL FUNCTION DECLARATIONS
+******************************************************************************/
+static uint32_t SysMon_Previous_Runtime(UBaseType_t task_number);
+
+/******************************************************************************
+*							CONST DECLARATIONS
+******************************************************************************/
+
+
+/******************************************************************************
+*							API IMPLEMENTATION
+******************************************************************************/
+void SysMon_Handler(void *params)
+{
+    TickType_t xLastWakeTime = xTaskGetTickCount();
+    LogStats_t log_stats;
+    PowerStats_t power;
+
+    while (1)
+    {
+        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(SYSMON_PERIOD_MS));
+
+        uint32_t total = 0;
+        UBaseType_t tasks = uxTaskGetNumberOfTasks();
+        UBaseType_t count = uxTaskGetSystemState(sysmon_status, SYSMON_MAX_TASKS, &total);
+        uint32_t window = total - sysmon_prev_total;
+        uint32_t now_ms = (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+
+        if (window == 0)
+        {
+            continue;
+        }
+
+        Log_GetStats(&log_stats);
+        printf("SYS,%lu,%lu,%u,%u,%lu\r\n", (unsigned long)now_ms, (unsigned long)window,
+               (unsigned)xPortGetFreeHeapSize(), (unsigned)xPortGetMinimumEverFreeHeapSize(),
+               (unsigned long)log_stats.dropped);
+
+        // A task created outside the App table leaves the array short, nothing is filled in
+        if (tasks > SYSMON_MAX_TASKS)
+        {
+            printf("TOVF,%lu,%u,%u\r\n", (unsigned long)now_ms, (unsigned)tasks, (unsigned)SYSMON_MAX_TASKS);
+        }
+
+        for (UBaseType_t i = 0; i < count; i++)
+        {
+            uint32_t delta = sysmon_status[i].ulRunTimeCounter -
+                             SysMon_Previous_Runtime(sysmon_status[i].xTaskNumber);
+            uint32_t permille = (uint32_t)(((uint64_t)delta * 1000U) / window);
+
+            printf("TSK,%lu,%s,%lu,%u,%u\r\n", (unsigned long)now_ms, sysmon_status[i].pcTaskName,
+                   (unsigned long)permille, (unsigned)sysmon_status[i].usStackHighWaterMark,
+                   (unsigned)sysmon_status[i].uxCurrentPriority);
+        }
+
+        // Without tickless idle every millisecond would be a wakeup
+        Power_GetStats(&power);
+        uint32_t sleeps = power.sleeps - sysmon_prev_power.sleeps;
+        uint32_t slept_ms = power.slept_ms - sysmon_prev_power.slept_ms;
+        uint32_t avoided = (slept_ms > sleeps) ? (slept_ms - sleeps) : 0;
+        uint32_t window_ms = (window / 1000U) ? (window / 1000U) : 1U;
+
+        printf("PWR,%lu,%lu,%lu,%lu\r\n", (unsigned long)now_ms,
+               (unsigned long)((sleeps * 1000U) / window_ms),
+               (unsigned long)((avoided * 1000U) / window_ms),
+               (unsigned long)((slept_ms * 1000U) / window_ms));
+        sysmon_prev_power = power;
+
+        for (MemPool_t *pool = MemPool_Next(NULL); pool != NULL; pool = MemPool_Next(pool))
+        {
+            MemPoolStats_t stats;
+
+            MemPool_GetStats(pool, &stats);
+            printf("POOL,%lu,%s,%u,%u,%u,%lu\r\n", (unsigned long)now_ms, stats.name,
+                   (unsigned)stats.in_use, (unsigned)stats.peak_in_use,
+                   (unsigned)stats.block_count, (unsigned long)stats.exhausted);
+        }
+
+        for (uint32_t port = 0; port < UART_RX_PORT_COUNT; port++)
+        {
+            UartRxStats_t rx;
+
+            UartRx_GetStats((UartRxPort_t)port, &rx);
+            printf("URX,%lu,%s,%lu,%lu,%lu,%lu,%lu\r\n", (unsigned long)now_ms,
+                   UartRx_Name((UartRxPort_t)port), (unsigned long)rx.bytes,
+                   (unsigned long)rx.dropped, (unsigned long)rx.events,
+                   (unsigned long)rx.errors, (unsigned long)rx.peak_fill);
+        }
+
+        RpcStats_t rpc;
+        Rpc_GetStats(&rpc);
+        printf("RPC,%lu,%lu,%lu,%lu,%u,%u\r\n", (unsigned long)now_ms,
+               (unsigned long)rpc.requests, (unsigned long)rpc.errors,
+               (unsigned long)rpc.corrupt, (unsigned)rpc.avg_us, (unsigned)rpc.max_us);
+
+        GsmStats_t gsm;
+        Gsm_GetStats(&gsm);
+        for (uint32_t type = 0; type < GSM_TYPE_COUNT; type++)
+        {
+            const GsmLatency_t *latency = &gsm.type[type];
+
+            printf("GSM,%lu,%s,%lu,%lu,%lu,%lu,%lu\r\n", (unsigned long)now_ms,
+                   Gsm_TypeName((GsmType_t)type), (unsigned long)latency->count,
+                   (unsigned long)latency->errors, (unsigned long)latency->timeouts,
+                   (unsigned long)latency->avg_ms, (unsigned long)latency->max_ms);
+        }
+        printf("MDM,%lu,%u,%lu,%lu,%lu,%lu,%lu\r\n", (unsigned long)now_ms, (unsigned)Gsm_IsReady(),
+               (unsigned long)gsm.lines, (unsigned long)gsm.commands, (unsigned long)gsm.urcs,
+               (unsigned long)gsm.resets, (unsigned long)gsm.overflows);
+
+        AlertStats_t alert;
+        Alert_GetStats(&alert);
+        printf("ALR,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu\r\n", (unsigned long)now_ms,
+               (unsigned long)alert.events, (unsigned long)alert.batches,
+               (unsigned long)alert.delivered, (unsigned long)alert.attempts,
+               (unsigned long)alert.failures, (unsigned long)alert.pending,
+               (unsigned long)alert.max_delivery_ms);
+
+        for (UBaseType_t i = 0; i < count; i++)
+        {
+            sysmon_prev_number[i] = sysmon_status[i].xTaskNumber;
+            sysmon_prev_runtime[i] = sysmon_status[i].ulRunTimeCounter;
+        }
+        sysmon_prev_count = count;
+        sysmon_prev_total = total;
+    }
+}
+
+void configureTimerForRunTimeStats(void)
+{
+    // Called by vTaskStartScheduler, TIM5 is already configured by MX_TIM5_Init
+    HAL_TIM_Base_Start(&htim5);
+}
+
+unsigned long getRunTimeCounterValue(void)
+{
+    return htim5.Instance->CNT;
+}
+
+/******************************************************************************
+*							LOCAL FUNCTION DEFINITIONS
+******************************************************************************/
+static uint32_t SysMon_Previous_Runtime(UBaseType_t task_number)
+{
+    for (UBaseType_t i = 0; i < sysmon_prev_count; i++)
+    {
+        if (sysmon_prev_number[i] == task_number)
+        {
+            return sysmon_prev_runtime[i];
+        }
+    }
+
+    // New task, everything it has run so far falls in this window
+    return 0;
+}
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
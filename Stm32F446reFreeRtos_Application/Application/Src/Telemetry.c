@@ -0,0 +1,270 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Telemetry.c
+  * @brief          : Streams LM35 samples as framed binary records on USART1.
+  *
+  * The task reads every sample from the SampleRing and appends it as a
+  * 7 byte record to the batch being built. The batch is framed (header, CRC,
+  * COBS) and handed to the USART1 TX DMA when it holds TELEMETRY_BATCH_MAX
+  * samples, when its oldest sample is TELEMETRY_FLUSH_MS old, or when the
+  * next sample does not follow on (the reader lost samples in between).
+  * Frames are encoded into xTelemetryFramePool blocks, separate from the
+  * batch, so the next batch fills and is encoded while the previous frame
+  * is still on the wire. The TX complete interrupt gives the block back.
+  *
+  * Rpc.c sends its responses through Telemetry_Send as well, a mutex keeps
+  * the two senders from starting the DMA at the same time.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  * 	17-10-2026	-	Framing and TX split out into Telemetry_Send, shared
+  * 					with the RPC responses under a mutex
+  * 	17-10-2026	-	Frames taken from xTelemetryFramePool, freed on TX complete
+  *
+  *
+  *
+  ******************************************************************************
+  */
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "Telemetry.h"
+#include "App.h"
+#include "semphr.h"
+/******************************************************************************
+*							GLOBAL VARIABLES
+******************************************************************************/
+#define TELEMETRY_TX_WAIT_MS    50      // A full frame takes ~12 ms at 115200
+
+extern UART_HandleTypeDef huart1;
+extern MemPool_t xTelemetryFramePool;
+
+// Batch being built, records start at TELEMETRY_HEADER_LEN
+static uint8_t telemetry_payload[TELEMETRY_PAYLOAD_MAX];
+static uint8_t telemetry_count;
+static uint32_t telemetry_first_sequence;
+static TickType_t telemetry_first_tick;
+static uint16_t telemetry_skipped;
+
+// Frame on the wire, owned by the DMA until the TX complete frees it
+static uint8_t *volatile telemetry_tx_frame;
+static uint16_t telemetry_frame_sequence;
+
+// Held from the busy wait until the DMA owns the frame
+static StaticSemaphore_t telemetry_tx_lock_buffer;
+static SemaphoreHandle_t telemetry_tx_lock;
+
+/******************************************************************************
+*							LOCAL FUNCTION DECLARATIONS
+******************************************************************************/
+static void Telemetry_Add(const LM35_Sample_t *sample);
+static void Telemetry_Flush(void);
+
+/******************************************************************************
+*							CONST DECLARATIONS
+******************************************************************************/
+_Static_assert(TELEMETRY_BATCH_MAX <= 255, "Telemetry: record count is one byte");
+_Static_assert(TELEMETRY_FLUSH_MS <= 0xFFFF, "Telemetry: record tick offset is 16 bits");
+
+/******************************************************************************
+*							API IMPLEMENTATION
+******************************************************************************/
+bool Telemetry_Init(void)
+{
+    telemetry_tx_lock = xSemaphoreCreateMutexStatic(&telemetry_tx_lock_buffer);
+    return (telemetry_tx_lock != NULL);
+}
+
+void Telemetry_Handler(void *params)
+{
+    SampleReader_t reader;
+    LM35_Sample_t sample;
+    uint32_t lost_seen = 0;
+
+    SampleRing_Attach(&reader, true);
+
+    while (1)
+    {
+        TickType_t timeout = portMAX_DELAY;
+
+        if (telemetry_count > 0)
+        {
+            TickType_t age = xTaskGetTickCount() - telemetry_first_tick;
+            timeout = (age < pdMS_TO_TICKS(TELEMETRY_FLUSH_MS)) ? (pdMS_TO_TICKS(TELEMETRY_FLUSH_MS) - age) : 0;
+        }
+
+        SampleRing_Wait(timeout);
+
+        while (SampleRing_Read(&reader, &sample))
+        {
+            uint32_t skipped = reader.lost - lost_seen;
+            lost_seen = reader.lost;
+
+            // Records of one frame are consecutive, a gap starts a new frame
+            if ((skipped != 0) && (telemetry_count > 0))
+            {
+                Telemetry_Flush();
+            }
+            skipped += telemetry_skipped;
+            telemetry_skipped = (skipped > 0xFFFF) ? 0xFFFF : (uint16_t)skipped;
+
+            Telemetry_Add(&sample);
+            if (telemetry_count == TELEMETRY_BATCH_MAX)
+            {
+                Telemetry_Flush();
+            }
+        }
+
+        if ((telemetry_count > 0) &&
+            ((xTaskGetTickCount() - telemetry_first_tick) >= pdMS_TO_TICKS(TELEMETRY_FLUSH_MS)))
+        {
+            Telemetry_Flush();
+        }
+    }
+}
+
+bool Telemetry_Send(uint8_t *payload, uint32_t length)
+{
+    uint8_t *frame;
+    uint32_t frame_len = 0;
+    bool sent = false;
+
+    if ((length + TELEMETRY_CRC_LEN) > TELEMETRY_PAYLOAD_MAX)
+    {
+        return false;
+    }
+    length += Telemetry_Put_U16(&payload[length], Crc16_Update(CRC16_INIT, payload, length));
+
+    // Encoded before taking the lock, the previous frame may still be going out
+    frame = MemPool_Alloc(&xTelemetryFramePool);
+    if (frame == NULL)
+    {
+        return false;
+    }
+    frame[frame_len++] = COBS_DELIMITER;
+    frame_len += Cobs_Encode(payload, length, &frame[frame_len]);
+    frame[frame_len++] = COBS_DELIMITER;
+
+    if (xSemaphoreTake(telemetry_tx_lock, pdMS_TO_TICKS(TELEMETRY_TX_WAIT_MS)) == pdTRUE)
+    {
+        // Previous frame still on the wire, it normally is long gone by now
+        for (uint32_t waited = 0; (telemetry_tx_frame != NULL) && (waited < TELEMETRY_TX_WAIT_MS); waited++)
+        {
+            vTaskDelay(pdMS_TO_TICKS(1));
+        }
+
+        if (telemetry_tx_frame == NULL)
+        {
+            telemetry_tx_frame = frame;
+            sent = (HAL_UART_Transmit_DMA(&huart1, frame, (uint16_t)frame_len) == HAL_OK);
+            if (!sent)
+            {
+                telemetry_tx_frame = NULL;
+            }
+        }
+
+        xSemaphoreGive(telemetry_tx_lock);
+    }
+
+    if (!sent)
+    {
+        MemPool_Free(&xTelemetryFramePool, frame);
+    }
+    return sent;
+}
+
+void Telemetry_TxComplete_FromISR(void)
+{
+    uint8_t *frame = telemetry_tx_frame;
+
+    telemetry_tx_frame = NULL;
+    if (frame != NULL)
+    {
+        MemPool_Free(&xTelemetryFramePool, frame);
+    }
+}
+
+uint32_t Telemetry_Put_U16(uint8_t *dst, uint16_t value)
+{
+    dst[0] = (uint8_t)(value);
+    dst[1] = (uint8_t)(value >> 8);
+    return 2;
+}
+
+uint32_t Telemetry_Put_U32(uint8_t *dst, uint32_t value)
+{
+    dst[0] = (uint8_t)(value);
+    dst[1] = (uint8_t)(value >> 8);
+    dst[2] = (uint8_t)(value >> 16);
+    dst[3] = (uint8_t)(value >> 24);
+    return 4;
+}
+
+
+/******************************************************************************
+*							LOCAL FUNCTION DEFINITIONS
+******************************************************************************/
+static void Telemetry_Add(const LM35_Sample_t *sample)
+{
+    uint8_t *record = &telemetry_payload[TELEMETRY_HEADER_LEN + (telemetry_count * TELEMETRY_RECORD_LEN)];
+    int32_t cdeg = sample->data.temperature_cdeg;
+    uint8_t flags = 0;
+
+    if (telemetry_count == 0)
+    {
+        telemetry_first_sequence = sample->sequence;
+        telemetry_first_tick = sample->timestamp;
+    }
+
+    cdeg = (cdeg > INT16_MAX) ? INT16_MAX : ((cdeg < INT16_MIN) ? INT16_MIN : cdeg);
+    flags |= sample->data.adc_timeout_error ? TELEMETRY_FLAG_ADC_TIMEOUT : 0U;
+    flags |= sample->data.sensor_disconnected ? TELEMETRY_FLAG_DISCONNECTED : 0U;
+
+    record += Telemetry_Put_U16(record, (uint16_t)((sample->timestamp - telemetry_first_tick) * portTICK_PERIOD_MS));
+    record += Telemetry_Put_U16(record, (uint16_t)sample->data.adc_q4);
+    record += Telemetry_Put_U16(record, (uint16_t)(int16_t)cdeg);
+    *record = flags;
+
+    telemetry_count++;
+}
+
+// Frames the batch and starts the DMA. A frame that cannot be sent is
+// dropped but still takes a sequence number, so the host sees the gap.
+static void Telemetry_Flush(void)
+{
+    uint32_t len = 0;
+    uint16_t sequence = telemetry_frame_sequence++;
+
+    telemetry_payload[len++] = TELEMETRY_SCHEMA_VERSION;
+    telemetry_payload[len++] = TELEMETRY_TYPE_SAMPLES;
+    len += Telemetry_Put_U16(&telemetry_payload[len], sequence);
+    len += Telemetry_Put_U32(&telemetry_payload[len], telemetry_first_sequence);
+    len += Telemetry_Put_U32(&telemetry_payload[len], (uint32_t)(telemetry_first_tick * portTICK_PERIOD_MS));
+    len += Telemetry_Put_U16(&telemetry_payload[len], telemetry_skipped);
+    telemetry_payload[len++] = telemetry_count;
+
+    len += telemetry_count * TELEMETRY_RECORD_LEN;
+
+    telemetry_count = 0;
+    telemetry_skipped = 0;
+
+    if (!Telemetry_Send(telemetry_payload, len))
+    {
+        TRACE("Telemetry frame %u dropped, TX busy or no frame block", sequence);
+    }
+}
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
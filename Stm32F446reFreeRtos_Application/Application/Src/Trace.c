@@ -0,0 +1,106 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : Trace.c
+  * @brief          : Binary deferred-formatting trace logger
+  *
+  * A record is {id:u16, tick:u32, args:u32 x n, check:u8}, little endian,
+  * COBS encoded and wrapped in 0x00 delimiters. It is queued on the same
+  * USART2 DMA ring as printf, so text and trace can share the console. The
+  * host decoder (trace_host_tool/trace_decoder.py) splits the stream on 0x00,
+  * decodes what is a valid record and prints everything else as text.
+  * Formatting happens on the host, the target only copies a few words.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  *
+  *
+  *
+  ******************************************************************************
+  */
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "Trace.h"
+#include "App.h"
+/******************************************************************************
+*							GLOBAL VARIABLES
+******************************************************************************/
+#define TRACE_HEADER_LEN        6       // id + tick
+#define TRACE_PAYLOAD_MAX       (TRACE_HEADER_LEN + (4U * TRACE_MAX_ARGS) + 1U)
+#define TRACE_FRAME_MAX         (COBS_ENCODED_MAX(TRACE_PAYLOAD_MAX) + 2U)
+
+/******************************************************************************
+*							LOCAL FUNCTION DECLARATIONS
+******************************************************************************/
+static uint32_t Trace_Put_U32(uint8_t *dst, uint32_t value);
+
+/******************************************************************************
+*							CONST DECLARATIONS
+******************************************************************************/
+
+
+/******************************************************************************
+*							API IMPLEMENTATION
+******************************************************************************/
+void Trace_Record(uint16_t id, const uint32_t *args, uint32_t nargs)
+{
+    uint8_t payload[TRACE_PAYLOAD_MAX];
+    uint8_t frame[TRACE_FRAME_MAX];
+    uint32_t len = 0;
+    uint8_t check = 0;
+    TickType_t tick = (xPortIsInsideInterrupt() == pdTRUE) ? xTaskGetTickCountFromISR()
+                                                           : xTaskGetTickCount();
+
+    if (nargs > TRACE_MAX_ARGS)
+    {
+        nargs = TRACE_MAX_ARGS;
+    }
+
+    payload[len++] = (uint8_t)(id & 0xFF);
+    payload[len++] = (uint8_t)(id >> 8);
+    len += Trace_Put_U32(&payload[len], (uint32_t)tick);
+    for (uint32_t i = 0; i < nargs; i++)
+    {
+        len += Trace_Put_U32(&payload[len], args[i]);
+    }
+
+    // Lets the decoder tell a record from plain text between delimiters
+    for (uint32_t i = 0; i < len; i++)
+    {
+        check ^= payload[i];
+    }
+    payload[len++] = check ^ 0xA5;
+
+    frame[0] = COBS_DELIMITER;
+    uint32_t frame_len = 1 + Cobs_Encode(payload, len, &frame[1]);
+    frame[frame_len++] = COBS_DELIMITER;
+
+    Log_Write((const char *)frame, frame_len);
+}
+
+/******************************************************************************
+*							LOCAL FUNCTION DEFINITIONS
+******************************************************************************/
+static uint32_t Trace_Put_U32(uint8_t *dst, uint32_t value)
+{
+    dst[0] = (uint8_t)(value);
+    dst[1] = (uint8_t)(value >> 8);
+    dst[2] = (uint8_t)(value >> 16);
+    dst[3] = (uint8_t)(value >> 24);
+    return 4;
+}
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
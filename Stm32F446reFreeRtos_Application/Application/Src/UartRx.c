@@ -0,0 +1,253 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file           : UartRx.c
+  * @brief          : Receive engine for USART1 (HC-05) and USART3 (SIM800).
+  *
+  * Each port receives into a circular DMA ring via HAL_UARTEx_ReceiveToIdle_DMA.
+  * The HAL reports the DMA write position on half transfer, transfer complete
+  * and on the IDLE line after a burst, so a burst costs one interrupt per
+  * UART_RX_DMA_LEN / 2 bytes plus one at its end, never one per byte. Every
+  * event copies the bytes between the last and the current position into the
+  * port's stream buffer, which wakes the reader task (or sets the bits the
+  * reader asked for with UartRx_SetNotify).
+  *
+  * Both ports and their DMA streams share interrupt priority 5, so the events
+  * of one port never nest and the ring position needs no locking.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2026 Sudharshan Godi.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *History: v01
+  * 	17-10-2026	-	v01	- Initial version
+  * 	17-10-2026	-	Optional reader notification on every delivery
+  *
+  *
+  *
+  ******************************************************************************
+  */
+
+/******************************************************************************
+*							INCLUDES
+******************************************************************************/
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+#include "UartRx.h"
+/******************************************************************************
+*							GLOBAL VARIABLES
+******************************************************************************/
+extern UART_HandleTypeDef huart1;
+extern UART_HandleTypeDef huart3;
+
+typedef struct
+{
+    UART_HandleTypeDef *huart;
+    const char *name;
+    uint16_t head;                      // DMA position already handed over
+    StreamBufferHandle_t stream;
+    TaskHandle_t notify_task;           // UartRx_SetNotify, NULL = none
+    uint32_t notify_bits;
+    StaticStreamBuffer_t stream_control;
+    uint8_t stream_storage[UART_RX_STREAM_LEN + 1];    // +1, see xStreamBufferCreateStatic
+    uint8_t dma[UART_RX_DMA_LEN];
+    UartRxStats_t stats;
+} UartRxChannel_t;
+
+static UartRxChannel_t uart_rx[UART_RX_PORT_COUNT] =
+{
+    [UART_RX_BT]  = { .huart = &huart1, .name = "BT"  },
+    [UART_RX_GSM] = { .huart = &huart3, .name = "GSM" },
+};
+
+/******************************************************************************
+*							LOCAL FUNCTION DECLARATIONS
+******************************************************************************/
+static UartRxChannel_t *UartRx_Find(UART_HandleTypeDef *huart);
+static bool UartRx_Start(UartRxChannel_t *channel);
+static void UartRx_Push(UartRxChannel_t *channel, uint16_t position, BaseType_t *woken);
+static void UartRx_Deliver(UartRxChannel_t *channel, const uint8_t *data, size_t length,
+                           BaseType_t *woken);
+
+/******************************************************************************
+*							CONST DECLARATIONS
+******************************************************************************/
+
+
+/******************************************************************************
+*							API IMPLEMENTATION
+******************************************************************************/
+bool UartRx_Init(void)
+{
+    bool ok = true;
+
+    for (uint32_t i = 0; i < UART_RX_PORT_COUNT; i++)
+    {
+        UartRxChannel_t *channel = &uart_rx[i];
+
+        // Trigger level 1, the reader wakes for every chunk
+        channel->stream = xStreamBufferCreateStatic(UART_RX_STREAM_LEN, 1,
+                                                    channel->stream_storage,
+                                                    &channel->stream_control);
+        if ((channel->stream == NULL) || !UartRx_Start(channel))
+        {
+            ok = false;
+        }
+    }
+
+    return ok;
+}
+
+size_t UartRx_Read(UartRxPort_t port, uint8_t *data, size_t length, TickType_t timeout)
+{
+    return xStreamBufferReceive(uart_rx[port].stream, data, length, timeout);
+}
+
+void UartRx_Flush(UartRxPort_t port)
+{
+    uint8_t scratch[32];
+
+    // xStreamBufferReset() refuses while a task is blocked on the buffer
+    while (xStreamBufferReceive(uart_rx[port].stream, scratch, sizeof(scratch), 0) > 0)
+    {
+    }
+}
+
+void UartRx_SetNotify(UartRxPort_t port, TaskHandle_t task, uint32_t bits)
+{
+    taskENTER_CRITICAL();
+    uart_rx[port].notify_bits = bits;
+    uart_rx[port].notify_task = task;
+    taskEXIT_CRITICAL();
+}
+
+void UartRx_GetStats(UartRxPort_t port, UartRxStats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = uart_rx[port].stats;
+    taskEXIT_CRITICAL();
+}
+
+const char *UartRx_Name(UartRxPort_t port)
+{
+    return uart_rx[port].name;
+}
+
+void UartRx_Event_FromISR(UART_HandleTypeDef *huart, uint16_t position)
+{
+    UartRxChannel_t *channel = UartRx_Find(huart);
+    BaseType_t woken = pdFALSE;
+
+    if (channel == NULL)
+    {
+        return;
+    }
+
+    channel->stats.events++;
+    UartRx_Push(channel, position, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+void UartRx_Error_FromISR(UART_HandleTypeDef *huart)
+{
+    UartRxChannel_t *channel = UartRx_Find(huart);
+    BaseType_t woken = pdFALSE;
+
+    if (channel == NULL)
+    {
+        return;
+    }
+
+    // The HAL aborted the DMA, keep what it wrote before the error
+    channel->stats.errors++;
+    UartRx_Push(channel, (uint16_t)(UART_RX_DMA_LEN - __HAL_DMA_GET_COUNTER(huart->hdmarx)), &woken);
+    UartRx_Start(channel);
+    portYIELD_FROM_ISR(woken);
+}
+
+
+/******************************************************************************
+*							LOCAL FUNCTION DEFINITIONS
+******************************************************************************/
+static UartRxChannel_t *UartRx_Find(UART_HandleTypeDef *huart)
+{
+    for (uint32_t i = 0; i < UART_RX_PORT_COUNT; i++)
+    {
+        if (uart_rx[i].huart == huart)
+        {
+            return &uart_rx[i];
+        }
+    }
+    return NULL;
+}
+
+static bool UartRx_Start(UartRxChannel_t *channel)
+{
+    // The DMA only restarts at 0 if the HAL accepted the request
+    if (HAL_UARTEx_ReceiveToIdle_DMA(channel->huart, channel->dma, UART_RX_DMA_LEN) != HAL_OK)
+    {
+        return false;
+    }
+    channel->head = 0;
+    return true;
+}
+
+// Hand over everything the DMA wrote between head and position. position is
+// UART_RX_DMA_LEN on transfer complete, the ring then continues at 0.
+static void UartRx_Push(UartRxChannel_t *channel, uint16_t position, BaseType_t *woken)
+{
+    uint16_t head = channel->head;
+
+    if (position > UART_RX_DMA_LEN)
+    {
+        return;
+    }
+
+    if (position > head)
+    {
+        UartRx_Deliver(channel, &channel->dma[head], position - head, woken);
+    }
+    else if (position < head)
+    {
+        // Transfer complete event was missed, the ring wrapped meanwhile
+        UartRx_Deliver(channel, &channel->dma[head], UART_RX_DMA_LEN - head, woken);
+        UartRx_Deliver(channel, channel->dma, position, woken);
+    }
+
+    channel->head = (position == UART_RX_DMA_LEN) ? 0 : position;
+}
+
+static void UartRx_Deliver(UartRxChannel_t *channel, const uint8_t *data, size_t length,
+                           BaseType_t *woken)
+{
+    if (length == 0)
+    {
+        return;
+    }
+
+    size_t sent = xStreamBufferSendFromISR(channel->stream, data, length, woken);
+    size_t fill = xStreamBufferBytesAvailable(channel->stream);
+
+    channel->stats.bytes += sent;
+    channel->stats.dropped += length - sent;
+    if ((sent > 0) && (channel->notify_task != NULL))
+    {
+        xTaskNotifyFromISR(channel->notify_task, channel->notify_bits, eSetBits, woken);
+    }
+    if (fill > channel->stats.peak_fill)
+    {
+        channel->stats.peak_fill = fill;
+    }
+}
+
+
+/******************************************************************************
+*							EOF
+******************************************************************************/
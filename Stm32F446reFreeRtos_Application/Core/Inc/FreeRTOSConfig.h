@@ -60,23 +60,25 @@
 #define configENABLE_MPU                         0
 
 #define configUSE_PREEMPTION                     1
+#define configUSE_TICKLESS_IDLE                  1
 #define configSUPPORT_STATIC_ALLOCATION          1
 #define configSUPPORT_DYNAMIC_ALLOCATION         1
 #define configUSE_IDLE_HOOK                      0
 #define configUSE_TICK_HOOK                      0
 #define configCPU_CLOCK_HZ                       ( SystemCoreClock )
 #define configTICK_RATE_HZ                       ((TickType_t)1000)
-#define configMAX_PRIORITIES                     ( 56 )
+#define configMAX_PRIORITIES                     ( 8 )
 #define configMINIMAL_STACK_SIZE                 ((uint16_t)128)
 #define configTOTAL_HEAP_SIZE                    ((size_t)15360)
 #define configMAX_TASK_NAME_LEN                  ( 16 )
 #define configUSE_TRACE_FACILITY                 1
+#define configGENERATE_RUN_TIME_STATS            1
 #define configUSE_16_BIT_TICKS                   0
 #define configUSE_MUTEXES                        1
 #define configQUEUE_REGISTRY_SIZE                8
 #define configUSE_RECURSIVE_MUTEXES              1
 #define configUSE_COUNTING_SEMAPHORES            1
-#define configUSE_PORT_OPTIMISED_TASK_SELECTION  0
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION  1
 /* USER CODE BEGIN MESSAGE_BUFFER_LENGTH_TYPE */
 /* Defaults to size_t for backward compatibility, but can be changed
    if lengths will always be less than the number of bytes in a size_t. */
@@ -151,6 +153,12 @@ to all Cortex-M ports, and do not rely on any particular library functions. */
 See http://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html. */
 #define configMAX_SYSCALL_INTERRUPT_PRIORITY 	( configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY << (8 - configPRIO_BITS) )
 
+/* USER CODE BEGIN 2 */
+/* Definitions needed when configGENERATE_RUN_TIME_STATS is on */
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS configureTimerForRunTimeStats
+#define portGET_RUN_TIME_COUNTER_VALUE getRunTimeCounterValue
+/* USER CODE END 2 */
+
 /* Normal assert() semantics without relying on the provision of an assert.h
 header file. */
 /* USER CODE BEGIN 1 */
@@ -168,6 +176,30 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* Task selection uses CLZ on a 32-bit ready bitmap (configUSE_PORT_OPTIMISED_TASK_SELECTION)
+   with 8 priority levels. The CMSIS-RTOS2 wrapper requires 56 levels and the generic
+   selection, so Middlewares/.../CMSIS_RTOS_V2/cmsis_os2.c is excluded from the build.
+   The application only uses the native FreeRTOS API; SysTick_Handler lives in
+   stm32f4xx_it.c and the idle/timer task memory in App.c.
+   The ARM_CM4F port always enables lazy FPU stacking (FPCCR ASPEN|LSPEN), a task
+   only gets the extended 26 word frame once it has used the FPU. */
+#if (configUSE_PORT_OPTIMISED_TASK_SELECTION == 1) && (configMAX_PRIORITIES > 32)
+#error "configMAX_PRIORITIES must be 32 or less with the port optimised task selection"
+#endif
+
+/* SysTick from HCLK/8 (22.5 MHz) so one tickless sleep can last ~745 ms instead of ~93 ms */
+#define configSYSTICK_CLOCK_HZ                   ( SystemCoreClock / 8 )
+
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+void PreSleepProcessing(uint32_t ulExpectedIdleTime);
+void PostSleepProcessing(uint32_t ulExpectedIdleTime);
+#endif
+
+/* The configPRE_SLEEP_PROCESSING() and configPOST_SLEEP_PROCESSING() macros
+allow the application to place the microcontroller into a low power state.
+Implemented in Application/Src/Power.c */
+#define configPRE_SLEEP_PROCESSING( x )          PreSleepProcessing( x )
+#define configPOST_SLEEP_PROCESSING( x )         PostSleepProcessing( x )
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,392 @@
+/*
+ * Host simulation of the ADC -> DMA -> LM35 task buffer hand-off.
+ *
+ * Application/Src/Lm35.c is built unchanged against stub headers and its
+ * task loop, LM35_Handler(), runs as is. The model of the circular DMA
+ * writes one ADC sample per TIM2 period into the buffer given to
+ * Board_Adc_Start() and calls LM35_Adc_Event_FromISR() on every half and
+ * full transfer, as Board.c does. xTaskNotifyWait() is where simulated time
+ * passes: the task wakes after a random scheduling latency (plus optional
+ * stalls, a higher priority task hogging the CPU) and then reads the halves
+ * it was notified for, taking -c us per sample while the DMA keeps writing.
+ * When it wakes with both halves pending it reads only the newest one, as
+ * LM35_Handler() does, and the older one is dropped as an overrun.
+ *
+ * A half is "torn" when the DMA writes into it before the task is done
+ * with it, and "lost" when it completes again before the task saw it.
+ * Both mean the double buffer hand-off failed, the exit code is non-zero.
+ * So does an overrun count that differs from LM35_GetOverrunCount().
+ *
+ *     -t <s>         simulated time (default 60)
+ *     -l <ms>        task wake latency, uniform 0..ms (default 2)
+ *     -c <us>        task processing cost per sample (default 2)
+ *     -b <ms>        stall length, the task cannot run (default 0 = none)
+ *     -e <ms>        stall period (default 1000)
+ *     -T <C>         LM35 temperature (default 25)
+ *     -n <LSB>       ADC noise, gaussian sigma (default 1)
+ *     -s <seed>      latency/noise seed (default 1)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <setjmp.h>
+#include <unistd.h>
+
+#include "App.h"
+#include "Lm35.c"
+
+#define SIM_HALF_LEN        (LM35_DMA_BUFFER_LEN / 2)
+#define SIM_TASK            ((TaskHandle_t)&lm35_data)
+
+typedef struct
+{
+    int pending;                /* Event raised, the task has not read it yet */
+    int reading;                /* The task is processing it */
+    int torn;                   /* DMA wrote into it while pending or reading */
+    uint64_t event_us;
+} SimHalf_t;
+
+/* Time and model */
+static uint64_t sim_now_us;
+static uint64_t sim_end_us;
+static uint64_t sim_sample_us;
+static uint64_t sim_next_sample_us;
+static double sim_latency_ms = 2.0;
+static double sim_cost_us = 2.0;
+static double sim_stall_ms;
+static double sim_stall_every_ms = 1000.0;
+static double sim_temp_c = 25.0;
+static double sim_noise_lsb = 1.0;
+static double sim_seconds = 60.0;
+static jmp_buf sim_exit;
+
+/* DMA */
+static uint16_t *dma_buffer;
+static uint32_t dma_length;
+static uint32_t dma_pos;
+static int dma_running;
+static SimHalf_t dma_halves[2];
+
+/* Task notification */
+static uint32_t notify_value;
+
+/* Results */
+static uint64_t res_filled;
+static uint64_t res_read;
+static uint64_t res_late;
+static uint64_t res_dropped;
+static uint64_t res_lost;
+static uint64_t res_torn;
+static uint64_t res_timeouts;
+static uint64_t res_starts;
+static uint64_t res_published;
+static uint64_t res_faults;
+static double res_latency_sum_ms;
+static double res_latency_max_ms;
+static int32_t res_cdeg_min = INT32_MAX;
+static int32_t res_cdeg_max = INT32_MIN;
+
+static double sim_gauss(void)
+{
+    double u1 = ((double)rand() + 1.0) / ((double)RAND_MAX + 2.0);
+    double u2 = ((double)rand() + 1.0) / ((double)RAND_MAX + 2.0);
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+static uint16_t sim_adc_sample(void)
+{
+    double code = (sim_temp_c * 10.0 * LM35_ADC_MAX_CODE / LM35_VREF_MV) + (sim_noise_lsb * sim_gauss());
+    long rounded = lround(code);
+
+    if (rounded < 0) rounded = 0;
+    if (rounded > LM35_ADC_MAX_CODE) rounded = LM35_ADC_MAX_CODE;
+    return (uint16_t)rounded;
+}
+
+/* One TIM2 trigger: conversion, DMA transfer, half/full interrupt */
+static void sim_dma_sample(void)
+{
+    sim_now_us = sim_next_sample_us;
+    sim_next_sample_us += sim_sample_us;
+    if (sim_now_us >= sim_end_us)
+    {
+        longjmp(sim_exit, 1);
+    }
+    if (!dma_running)
+    {
+        return;
+    }
+
+    SimHalf_t *half = &dma_halves[dma_pos / SIM_HALF_LEN];
+
+    if (half->pending || half->reading)
+    {
+        half->torn = 1;
+    }
+    dma_buffer[dma_pos++] = sim_adc_sample();
+
+    if ((dma_pos % SIM_HALF_LEN) != 0)
+    {
+        return;
+    }
+
+    res_filled++;
+    if (half->pending)
+    {
+        /* Completed again before the task got to it, the old data is gone */
+        res_lost++;
+    }
+    half->pending = 1;
+    half->torn = 0;
+    half->event_us = sim_now_us;
+
+    if (dma_pos == dma_length)
+    {
+        dma_pos = 0;
+        LM35_Adc_Event_FromISR(LM35_NOTIFY_FULL_CPLT);
+    }
+    else
+    {
+        LM35_Adc_Event_FromISR(LM35_NOTIFY_HALF_CPLT);
+    }
+}
+
+static void sim_advance_to(uint64_t until_us)
+{
+    while (sim_next_sample_us <= until_us)
+    {
+        sim_dma_sample();
+    }
+    sim_now_us = until_us;
+}
+
+/* The task finished the halves it was given at the last wake up */
+static void sim_finish_reads(void)
+{
+    uint32_t halves = (uint32_t)(dma_halves[0].reading + dma_halves[1].reading);
+
+    sim_advance_to(sim_now_us + (uint64_t)(sim_cost_us * SIM_HALF_LEN * halves));
+    for (int i = 0; i < 2; i++)
+    {
+        if (!dma_halves[i].reading)
+        {
+            continue;
+        }
+        dma_halves[i].reading = 0;
+        res_read++;
+        if (dma_halves[i].torn)
+        {
+            res_torn++;
+        }
+    }
+}
+
+/* Scheduling: random latency, and nothing runs inside a stall window */
+static uint64_t sim_wake_at(uint64_t ready_us)
+{
+    uint64_t wake = ready_us + (uint64_t)(sim_latency_ms * 1000.0 * rand() / ((double)RAND_MAX + 1.0));
+
+    if (sim_stall_ms > 0)
+    {
+        uint64_t every = (uint64_t)(sim_stall_every_ms * 1000.0);
+        uint64_t into = wake % every;
+
+        if (into < (uint64_t)(sim_stall_ms * 1000.0))
+        {
+            wake += (uint64_t)(sim_stall_ms * 1000.0) - into;
+        }
+    }
+    return wake;
+}
+
+/******************************************************************************
+*                           FreeRTOS / Board stubs
+******************************************************************************/
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)(sim_now_us / 1000);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return SIM_TASK;
+}
+
+BaseType_t xTaskNotifyFromISR(TaskHandle_t task, uint32_t value, eNotifyAction action,
+                              BaseType_t *higher_priority_woken)
+{
+    (void)task;
+    (void)action;
+    notify_value |= value;
+    *higher_priority_woken = pdTRUE;
+    return pdPASS;
+}
+
+BaseType_t xTaskNotifyWait(uint32_t clear_on_entry, uint32_t clear_on_exit,
+                           uint32_t *value, TickType_t timeout)
+{
+    sim_finish_reads();
+
+    notify_value &= ~clear_on_entry;
+    uint64_t deadline = sim_now_us + ((uint64_t)timeout * 1000);
+    while (notify_value == 0)
+    {
+        if (sim_next_sample_us > deadline)
+        {
+            sim_advance_to(deadline);
+            res_timeouts++;
+            return pdFALSE;
+        }
+        sim_dma_sample();
+    }
+
+    sim_advance_to(sim_wake_at(sim_now_us));
+
+    *value = notify_value;
+    notify_value &= ~clear_on_exit;
+    if ((*value & (LM35_NOTIFY_HALF_CPLT | LM35_NOTIFY_FULL_CPLT)) ==
+        (LM35_NOTIFY_HALF_CPLT | LM35_NOTIFY_FULL_CPLT))
+    {
+        res_late++;
+    }
+
+    /* Older of two pending halves, the DMA is refilling it */
+    int stale = -1;
+    if (dma_halves[0].pending && dma_halves[1].pending)
+    {
+        stale = (dma_halves[0].event_us < dma_halves[1].event_us) ? 0 : 1;
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+        uint32_t bit = (i == 0) ? LM35_NOTIFY_HALF_CPLT : LM35_NOTIFY_FULL_CPLT;
+        double latency_ms;
+
+        if (!(*value & bit) || !dma_halves[i].pending)
+        {
+            continue;
+        }
+        if (i == stale)
+        {
+            dma_halves[i].pending = 0;
+            res_dropped++;
+            continue;
+        }
+        latency_ms = (double)(sim_now_us - dma_halves[i].event_us) / 1000.0;
+        res_latency_sum_ms += latency_ms;
+        if (latency_ms > res_latency_max_ms)
+        {
+            res_latency_max_ms = latency_ms;
+        }
+        dma_halves[i].pending = 0;
+        dma_halves[i].reading = 1;
+    }
+    return pdTRUE;
+}
+
+bool Board_Adc_Start(uint16_t *buffer, uint32_t length)
+{
+    dma_buffer = buffer;
+    dma_length = length;
+    dma_pos = 0;
+    memset(dma_halves, 0, sizeof(dma_halves));
+    dma_running = 1;
+    res_starts++;
+    return true;
+}
+
+void Board_Adc_Stop(void)
+{
+    dma_running = 0;
+}
+
+void SampleRing_Publish(const LM35_Data_t *data)
+{
+    res_published++;
+    if (data->adc_timeout_error || data->sensor_disconnected)
+    {
+        res_faults++;
+        return;
+    }
+    if (data->temperature_cdeg < res_cdeg_min) res_cdeg_min = data->temperature_cdeg;
+    if (data->temperature_cdeg > res_cdeg_max) res_cdeg_max = data->temperature_cdeg;
+}
+
+bool SampleRing_Latest(SampleReader_t *reader, LM35_Sample_t *sample)
+{
+    (void)reader;
+    (void)sample;
+    return false;
+}
+
+void Health_Update(EventBits_t set, EventBits_t clear)
+{
+    (void)set;
+    (void)clear;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned seed = 1;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "t:l:c:b:e:T:n:s:")) != -1)
+    {
+        switch (opt)
+        {
+        case 't': sim_seconds = atof(optarg); break;
+        case 'l': sim_latency_ms = atof(optarg); break;
+        case 'c': sim_cost_us = atof(optarg); break;
+        case 'b': sim_stall_ms = atof(optarg); break;
+        case 'e': sim_stall_every_ms = atof(optarg); break;
+        case 'T': sim_temp_c = atof(optarg); break;
+        case 'n': sim_noise_lsb = atof(optarg); break;
+        case 's': seed = (unsigned)strtoul(optarg, NULL, 0); break;
+        default:
+            fprintf(stderr, "usage: %s [-t s] [-l ms] [-c us] [-b ms] [-e ms] [-T C] [-n LSB] [-s seed]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+
+    srand(seed);
+    sim_sample_us = 1000000ULL / LM35_ADC_SAMPLE_RATE_HZ;
+    sim_next_sample_us = sim_sample_us;
+    sim_end_us = (uint64_t)(sim_seconds * 1e6);
+
+    if (setjmp(sim_exit) == 0)
+    {
+        LM35_Handler(NULL);
+    }
+
+    double half_ms = (double)SIM_HALF_LEN * (double)sim_sample_us / 1000.0;
+
+    printf("%.1f s, ADC %u Hz, %u sample halves (%.0f ms to read each), wake latency 0..%.1f ms, "
+           "%.1f us/sample, stall %.0f ms every %.0f ms\n",
+           sim_seconds, (unsigned)LM35_ADC_SAMPLE_RATE_HZ, (unsigned)SIM_HALF_LEN, half_ms,
+           sim_latency_ms, sim_cost_us, sim_stall_ms, sim_stall_every_ms);
+    printf("halves     : %llu filled, %llu read, %llu late (both bits), %llu dropped, %llu lost, %llu torn\n",
+           (unsigned long long)res_filled, (unsigned long long)res_read, (unsigned long long)res_late,
+           (unsigned long long)res_dropped, (unsigned long long)res_lost, (unsigned long long)res_torn);
+    printf("overruns   : %lu counted by the task\n", (unsigned long)LM35_GetOverrunCount());
+    printf("latency    : avg %.2f ms, max %.2f ms (event to read)\n",
+           res_read ? res_latency_sum_ms / (double)res_read : 0.0, res_latency_max_ms);
+    printf("throughput : %.1f samples/s read, %llu timeouts, %llu DMA starts\n",
+           (double)(res_read * SIM_HALF_LEN) / sim_seconds, (unsigned long long)res_timeouts,
+           (unsigned long long)res_starts);
+    if (res_cdeg_min <= res_cdeg_max)
+    {
+        printf("published  : %llu samples, %llu faults, %.2f .. %.2f C (input %.2f C)\n",
+               (unsigned long long)res_published, (unsigned long long)res_faults,
+               res_cdeg_min / 100.0, res_cdeg_max / 100.0, sim_temp_c);
+    }
+    else
+    {
+        printf("published  : %llu samples, %llu faults\n",
+               (unsigned long long)res_published, (unsigned long long)res_faults);
+    }
+
+    return ((res_lost != 0) || (res_torn != 0) || (res_timeouts != 0) ||
+            (res_dropped != LM35_GetOverrunCount())) ? 1 : 0;
+}
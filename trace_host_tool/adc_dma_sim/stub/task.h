@@ -0,0 +1,25 @@
+/* Minimal task.h for the host ADC DMA simulation, time is owned by adc_dma_sim.c */
+#ifndef ADC_DMA_SIM_TASK_H
+#define ADC_DMA_SIM_TASK_H
+
+#include "FreeRTOS.h"
+
+typedef void *TaskHandle_t;
+
+typedef enum
+{
+    eNoAction = 0,
+    eSetBits
+} eNotifyAction;
+
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+TickType_t xTaskGetTickCount(void);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+BaseType_t xTaskNotifyWait(uint32_t clear_on_entry, uint32_t clear_on_exit,
+                           uint32_t *value, TickType_t timeout);
+BaseType_t xTaskNotifyFromISR(TaskHandle_t task, uint32_t value, eNotifyAction action,
+                              BaseType_t *higher_priority_woken);
+
+#endif
@@ -0,0 +1,135 @@
+/*
+ * Host simulation of the application on the FreeRTOS POSIX port
+ * (../freertos_posix).
+ *
+ * App.c, Lm35.c, Lcd16x2.c, Led.c, I2cBus.c, MemPool.c, SampleRing.c and
+ * Health.c are built unchanged, App_Run() creates the same tasks, pools and
+ * timers as on the target. sim_board.c implements Board.h: the LM35 input is
+ * played from a trace file or a step script, the I2C3 traffic drives a model
+ * of the LCD and the LED pin is captured, both printed as LCD/LED lines.
+ * The UART side (log, telemetry, RPC, GSM, alert) and SysMon are not
+ * simulated, their tasks are parked and their entry points do nothing.
+ *
+ * Time is virtual by default: when every task is blocked the next tick is
+ * raised at once, so a run takes milliseconds and gives the same output
+ * every time. A top priority task prints the SIM summary line after -t
+ * simulated seconds and ends the scheduler.
+ *
+ *     -t <s>          simulated time (default 10)
+ *     -f <file>       ADC trace, one code per line at 1 kHz
+ *     -a <ms:code,..> ADC steps, e.g. 0:310,3000:700 (default 310, ~25 C)
+ *     -r              real time, ticks from a 1 ms host timer
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "App.h"
+#include "sim_board.h"
+
+static uint32_t sim_run_ms = 10000;
+
+/* Not simulated, the tasks exist but never run their loop */
+static void Sim_Park(void)
+{
+    for (;;)
+    {
+        vTaskSuspend(NULL);
+    }
+}
+
+void SysMon_Handler(void *params)    { (void)params; Sim_Park(); }
+void Telemetry_Handler(void *params) { (void)params; Sim_Park(); }
+void Rpc_Handler(void *params)       { (void)params; Sim_Park(); }
+void Gsm_Handler(void *params)       { (void)params; Sim_Park(); }
+void Alert_Handler(void *params)     { (void)params; Sim_Park(); }
+
+bool UartRx_Init(void)    { return true; }
+bool Telemetry_Init(void) { return true; }
+bool Gsm_Init(void)       { return true; }
+
+void UartRx_Event_FromISR(UART_HandleTypeDef *huart, uint16_t position)
+{
+    (void)huart;
+    (void)position;
+}
+
+void UartRx_Error_FromISR(UART_HandleTypeDef *huart)
+{
+    (void)huart;
+}
+
+void Telemetry_TxComplete_FromISR(void) {}
+void Gsm_TxComplete_FromISR(void) {}
+void Log_TxComplete_FromISR(void) {}
+
+/* printf goes to the host stdout, only __io_putchar lands here */
+uint32_t Log_Write(const char *data, uint32_t length)
+{
+    return (uint32_t)fwrite(data, 1, length, stdout);
+}
+
+/* TRACE records are binary on the target, not decoded here */
+void Trace_Record(uint16_t id, const uint32_t *args, uint32_t nargs)
+{
+    (void)id;
+    (void)args;
+    (void)nargs;
+}
+
+static void sim_stop_task(void *params)
+{
+    (void)params;
+    vTaskDelay(pdMS_TO_TICKS(sim_run_ms));
+    Sim_Board_Report();
+    vTaskEndScheduler();
+}
+
+int main(int argc, char **argv)
+{
+    bool real_time = false;
+    int opt;
+
+    Sim_Board_Init();
+    while ((opt = getopt(argc, argv, "t:f:a:r")) != -1)
+    {
+        switch (opt)
+        {
+        case 't': sim_run_ms = (uint32_t)(strtod(optarg, NULL) * 1000.0); break;
+        case 'f':
+            if (!Sim_Adc_LoadTrace(optarg))
+            {
+                fprintf(stderr, "cannot read ADC trace %s\n", optarg);
+                return 1;
+            }
+            break;
+        case 'a':
+            if (!Sim_Adc_LoadSteps(optarg))
+            {
+                fprintf(stderr, "bad ADC steps \"%s\", expected ms:code,...\n", optarg);
+                return 1;
+            }
+            break;
+        case 'r': real_time = true; break;
+        default:
+            fprintf(stderr, "usage: %s [-t s] [-f trace | -a ms:code,...] [-r]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    if (!real_time)
+    {
+        vPortSetVirtualTime();
+    }
+    if (xTaskCreate(sim_stop_task, "Stop", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1,
+                    NULL) != pdPASS)
+    {
+        fprintf(stderr, "stop task creation failed\n");
+        return 1;
+    }
+
+    /* Creates the application tasks, returns once the scheduler ends */
+    App_Run();
+    return 0;
+}
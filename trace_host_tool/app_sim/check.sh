@@ -0,0 +1,72 @@
+#!/bin/sh
+# Scripted runs of app_sim, each checks the last LCD frame and the LED
+# pattern once the fault state has settled. Exit code non-zero on failure.
+#
+#     ./check.sh ./app_sim
+
+SIM=${1:-./app_sim}
+failures=0
+
+# led_pattern <log> <from ms> <durations>: the LED edges after <from> must
+# repeat <durations> (ms between edges, any starting step), a cycle at least
+led_pattern() {
+    awk -F, -v from="$2" -v pattern="$3" '
+        BEGIN { n = split(pattern, pat, " ") }
+        $1 == "LED" && $2 >= from { t[count++] = $2 }
+        END {
+            if (count <= n) { print "too few LED edges: " count; exit 1 }
+            for (off = 0; off < n; off++) {
+                ok = 1
+                for (k = 0; (k < count - 1) && ok; k++) {
+                    ok = ((t[k + 1] - t[k]) == pat[((k + off) % n) + 1])
+                }
+                if (ok) exit 0
+            }
+            printf "LED edges after %d ms:", from
+            for (k = 0; k < count - 1; k++) printf " %d", t[k + 1] - t[k]
+            print ""
+            exit 1
+        }' "$1"
+}
+
+# lcd_line1 <log> <text>: first row of the last frame on the glass
+lcd_line1() {
+    last=$(grep '^LCD,' "$1" | tail -n 1 | cut -d, -f3- | cut -d'|' -f1 | sed 's/ *$//')
+    [ "$last" = "$2" ] || { echo "LCD shows \"$last\", expected \"$2\""; return 1; }
+}
+
+# scenario <name> <lcd row 0> <from ms> <led durations> <app_sim options>
+scenario() {
+    name=$1 lcd=$2 from=$3 led=$4
+    shift 4
+    log=app_sim_$name.log
+
+    if "$SIM" "$@" > "$log" && grep -q '^SIM,' "$log" &&
+       lcd_line1 "$log" "$lcd" && led_pattern "$log" "$from" "$led"; then
+        echo "PASS $name"
+    else
+        echo "FAIL $name (see $log)"
+        failures=$((failures + 1))
+    fi
+}
+
+HEARTBEAT="60 140 60 1740"
+OVER_TEMP="100 100"
+MORSE_S="150 150 150 150 150 1050"
+
+# 25 C throughout
+scenario normal "Temp: 25.0 C" 0 "$HEARTBEAT" -t 10
+
+# 25 C, over the 625 code threshold (~50 C) from 3 s
+scenario over_temp "Temp: 56.4 C" 4500 "$OVER_TEMP" -t 8 -a 0:310,3000:700
+
+# Sensor output below the 30 code disconnect threshold
+scenario disconnected "Temp: -100.0 C" 2500 "$MORSE_S" -t 8 -a 0:5
+
+# Trace file: over temperature for 3 s, then back to 25 C (last code held)
+trace=app_sim_recovery.trace
+{ echo "# 3 s at 56 C, then 25 C"; awk 'BEGIN { for (i = 0; i < 3000; i++) print 700; print 310 }'; } > "$trace"
+scenario recovery "Temp: 25.0 C" 6000 "$HEARTBEAT" -t 12 -f "$trace"
+
+[ "$failures" -eq 0 ] && echo "all passed" || echo "FAILED"
+exit "$failures"
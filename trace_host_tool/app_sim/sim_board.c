@@ -0,0 +1,361 @@
+/*
+ * Host implementation of Board.h for the application simulation.
+ *
+ * Everything the peripherals do happens in the tick hook, the simulated
+ * TIM2/DMA and I2C3 interrupts:
+ *   - ADC: one code per tick (LM35_ADC_SAMPLE_RATE_HZ is the tick rate) is
+ *     written into the buffer given to Board_Adc_Start(), the half and full
+ *     transfers are reported with LM35_Adc_Event_FromISR() as Board.c does.
+ *   - I2C3: a write completes after its bytes would have taken at 100 kHz
+ *     (9 bits each, at least one tick), then its bytes reach the PCF8574 +
+ *     HD44780 model and I2cBus_Event_FromISR() reports it. Only the LCD
+ *     expander acknowledges, anything else fails with I2C_BUS_EVT_ERROR.
+ *   - LED: Board_Led_Set() is captured as is.
+ *
+ * Output, one line per change, <ms> is the tick count:
+ *     LED,<ms>,<0|1>
+ *     LCD,<ms>,<row 0>|<row 1>
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "App.h"
+#include "sim_board.h"
+
+#define SIM_LCD_ADDR            (0x27 << 1)     /* PCF8574, as in Lcd16x2.c */
+#define SIM_PCF_ENABLE          0x04
+#define SIM_PCF_REGISTER_SEL    0x01
+#define SIM_DDRAM_LEN           0x80
+#define SIM_I2C_BIT_NS          10000U          /* 100 kHz */
+#define SIM_I2C_TICK_NS         (1000000000U / configTICK_RATE_HZ)
+#define SIM_MAX_STEPS           64
+
+typedef struct
+{
+    uint32_t ms;
+    uint16_t code;
+} SimStep_t;
+
+/* ADC input */
+static uint16_t *sim_trace;
+static uint32_t sim_trace_len;
+static SimStep_t sim_steps[SIM_MAX_STEPS];
+static uint32_t sim_step_count;
+
+/* ADC + DMA */
+static uint16_t *adc_buffer;
+static uint32_t adc_length;
+static uint32_t adc_pos;
+static bool adc_running;
+static uint32_t adc_samples;
+
+/* I2C3, one transfer at a time as the bus task issues them */
+static const uint8_t *i2c_data;
+static uint16_t i2c_length;
+static uint32_t i2c_ticks_left;
+static bool i2c_acked;
+static uint32_t i2c_writes;
+static uint32_t i2c_bytes;
+static uint32_t i2c_nacks;
+
+/* HD44780 behind the PCF8574 */
+static char glass_ddram[SIM_DDRAM_LEN];
+static uint8_t glass_addr;
+static bool glass_four_bit;
+static bool glass_have_high;
+static uint8_t glass_high;
+static uint8_t glass_last;
+static char glass_shown[2][LCD_COLS + 1];
+static uint32_t glass_frames;
+
+/* LED */
+static bool led_on;
+static uint32_t led_edges;
+
+USART_TypeDef sim_usart[3];
+GPIO_TypeDef sim_gpioc;
+
+static uint16_t Sim_Adc_Code(uint32_t ms)
+{
+    if (sim_trace_len > 0)
+    {
+        return sim_trace[(ms < sim_trace_len) ? ms : (sim_trace_len - 1)];
+    }
+
+    uint16_t code = SIM_ADC_DEFAULT;
+    for (uint32_t i = 0; (i < sim_step_count) && (sim_steps[i].ms <= ms); i++)
+    {
+        code = sim_steps[i].code;
+    }
+    return code;
+}
+
+void Sim_Board_Init(void)
+{
+    /* The controller clears DDRAM to blanks at power-on */
+    memset(glass_ddram, ' ', sizeof(glass_ddram));
+    memset(glass_shown, ' ', sizeof(glass_shown));
+    glass_shown[0][LCD_COLS] = '\0';
+    glass_shown[1][LCD_COLS] = '\0';
+}
+
+bool Sim_Adc_LoadTrace(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    char line[128];
+    uint32_t size = 0;
+
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        char *end;
+        unsigned long code = strtoul(line, &end, 0);
+
+        if ((end == line) || (line[0] == '#'))
+        {
+            continue;
+        }
+        if (sim_trace_len == size)
+        {
+            size = size ? (2 * size) : 4096;
+            sim_trace = realloc(sim_trace, size * sizeof(sim_trace[0]));
+        }
+        sim_trace[sim_trace_len++] = (uint16_t)((code > LM35_ADC_MAX_CODE) ? LM35_ADC_MAX_CODE : code);
+    }
+    fclose(file);
+    return (sim_trace_len > 0);
+}
+
+bool Sim_Adc_LoadSteps(const char *steps)
+{
+    const char *p = steps;
+
+    sim_step_count = 0;
+    while (*p != '\0')
+    {
+        char *end;
+        unsigned long ms = strtoul(p, &end, 0);
+        unsigned long code;
+
+        if ((*end != ':') || (sim_step_count == SIM_MAX_STEPS))
+        {
+            return false;
+        }
+        code = strtoul(end + 1, &end, 0);
+        if (((*end != ',') && (*end != '\0')) || (code > LM35_ADC_MAX_CODE) ||
+            ((sim_step_count > 0) && (ms < sim_steps[sim_step_count - 1].ms)))
+        {
+            return false;
+        }
+
+        sim_steps[sim_step_count++] = (SimStep_t){ .ms = (uint32_t)ms, .code = (uint16_t)code };
+        p = (*end == ',') ? (end + 1) : end;
+    }
+    return (sim_step_count > 0);
+}
+
+void Sim_Board_Report(void)
+{
+    printf("SIM,%lu,adc_samples=%lu,i2c_writes=%lu,i2c_bytes=%lu,i2c_nacks=%lu,lcd_frames=%lu,led_edges=%lu\n",
+           (unsigned long)xTaskGetTickCount(), (unsigned long)adc_samples, (unsigned long)i2c_writes,
+           (unsigned long)i2c_bytes, (unsigned long)i2c_nacks, (unsigned long)glass_frames,
+           (unsigned long)led_edges);
+}
+
+static void Glass_Instruction(bool rs, uint8_t value)
+{
+    if (rs)
+    {
+        glass_ddram[glass_addr] = (char)value;
+        glass_addr = (glass_addr + 1) % SIM_DDRAM_LEN;
+    }
+    else if (value == 0x01)
+    {
+        memset(glass_ddram, ' ', sizeof(glass_ddram));
+        glass_addr = 0;
+    }
+    else if (value & 0x80)
+    {
+        glass_addr = value & 0x7F;
+    }
+}
+
+static void Glass_Byte(uint8_t byte)
+{
+    /* Falling edge of E latches the nibble */
+    if ((glass_last & SIM_PCF_ENABLE) && !(byte & SIM_PCF_ENABLE))
+    {
+        uint8_t nibble = byte & 0xF0;
+
+        if (!glass_four_bit)
+        {
+            /* 8-bit interface, only the function set to 4-bit matters */
+            if (nibble == 0x20)
+            {
+                glass_four_bit = true;
+                glass_have_high = false;
+            }
+        }
+        else if (!glass_have_high)
+        {
+            glass_high = nibble;
+            glass_have_high = true;
+        }
+        else
+        {
+            glass_have_high = false;
+            Glass_Instruction((byte & SIM_PCF_REGISTER_SEL) != 0, glass_high | (nibble >> 4));
+        }
+    }
+    glass_last = byte;
+}
+
+/* Prints the glass when a transfer changed what it shows */
+static void Glass_Report(uint32_t ms)
+{
+    static const uint8_t row_addr[2] = { 0x00, 0x40 };
+    char rows[2][LCD_COLS + 1];
+
+    for (int row = 0; row < 2; row++)
+    {
+        memcpy(rows[row], &glass_ddram[row_addr[row]], LCD_COLS);
+        rows[row][LCD_COLS] = '\0';
+    }
+    if (memcmp(rows, glass_shown, sizeof(rows)) == 0)
+    {
+        return;
+    }
+
+    memcpy(glass_shown, rows, sizeof(rows));
+    glass_frames++;
+    printf("LCD,%lu,%s|%s\n", (unsigned long)ms, rows[0], rows[1]);
+}
+
+/* TIM2/DMA2 and I2C3 interrupts, once per tick */
+void vApplicationTickHook(void)
+{
+    uint32_t ms = xTaskGetTickCountFromISR();
+
+    if (adc_running)
+    {
+        adc_buffer[adc_pos++] = Sim_Adc_Code(ms);
+        adc_samples++;
+        if (adc_pos == (adc_length / 2))
+        {
+            LM35_Adc_Event_FromISR(LM35_NOTIFY_HALF_CPLT);
+        }
+        else if (adc_pos == adc_length)
+        {
+            adc_pos = 0;
+            LM35_Adc_Event_FromISR(LM35_NOTIFY_FULL_CPLT);
+        }
+    }
+
+    if ((i2c_ticks_left > 0) && (--i2c_ticks_left == 0))
+    {
+        if (!i2c_acked)
+        {
+            i2c_nacks++;
+            I2cBus_Event_FromISR(I2C_BUS_EVT_ERROR);
+            return;
+        }
+
+        for (uint16_t i = 0; i < i2c_length; i++)
+        {
+            Glass_Byte(i2c_data[i]);
+        }
+        i2c_bytes += i2c_length;
+        Glass_Report(ms);
+        I2cBus_Event_FromISR(I2C_BUS_EVT_DONE);
+    }
+}
+
+void Board_Led_Set(bool on)
+{
+    if (on != led_on)
+    {
+        led_on = on;
+        led_edges++;
+        printf("LED,%lu,%d\n", (unsigned long)xTaskGetTickCount(), on ? 1 : 0);
+    }
+}
+
+bool Board_Adc_Start(uint16_t *buffer, uint32_t length)
+{
+    taskENTER_CRITICAL();
+    adc_buffer = buffer;
+    adc_length = length;
+    adc_pos = 0;
+    adc_running = true;
+    taskEXIT_CRITICAL();
+    return true;
+}
+
+void Board_Adc_Stop(void)
+{
+    taskENTER_CRITICAL();
+    adc_running = false;
+    taskEXIT_CRITICAL();
+}
+
+static HAL_StatusTypeDef Sim_I2c_Start(uint16_t dev_addr, const uint8_t *data, uint16_t length)
+{
+    /* Address byte plus data, ACK bit included */
+    uint32_t ns = (1U + length) * 9U * SIM_I2C_BIT_NS;
+
+    taskENTER_CRITICAL();
+    if (i2c_ticks_left > 0)
+    {
+        taskEXIT_CRITICAL();
+        return HAL_BUSY;
+    }
+    i2c_data = data;
+    i2c_length = length;
+    i2c_acked = (dev_addr == SIM_LCD_ADDR) && (data != NULL);
+    i2c_ticks_left = (ns + SIM_I2C_TICK_NS - 1) / SIM_I2C_TICK_NS;
+    i2c_writes++;
+    taskEXIT_CRITICAL();
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef Board_I2c_Write(uint16_t dev_addr, uint8_t *data, uint16_t length)
+{
+    return Sim_I2c_Start(dev_addr, data, length);
+}
+
+HAL_StatusTypeDef Board_I2c_Read(uint16_t dev_addr, uint8_t *data, uint16_t length)
+{
+    /* The expander is only ever written, a read is NACKed */
+    (void)data;
+    return Sim_I2c_Start(dev_addr, NULL, length);
+}
+
+HAL_StatusTypeDef Board_I2c_Probe(uint16_t dev_addr, uint32_t timeout_ms)
+{
+    (void)timeout_ms;
+    return (dev_addr == SIM_LCD_ADDR) ? HAL_OK : HAL_ERROR;
+}
+
+void Board_I2c_Recover(void)
+{
+    taskENTER_CRITICAL();
+    i2c_ticks_left = 0;
+    taskEXIT_CRITICAL();
+}
+
+/* Only reached from vApplicationStackOverflowHook */
+void HAL_GPIO_TogglePin(GPIO_TypeDef *port, uint16_t pin)
+{
+    (void)port;
+    (void)pin;
+}
+
+void HAL_Delay(uint32_t ms)
+{
+    (void)ms;
+}
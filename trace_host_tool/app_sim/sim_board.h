@@ -0,0 +1,27 @@
+/*
+ * Board.h on the host: ADC input played from a trace or a step script, the
+ * I2C3 traffic fed to a PCF8574 + HD44780 model and the LED pin captured.
+ */
+#ifndef APP_SIM_SIM_BOARD_H
+#define APP_SIM_SIM_BOARD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ADC code played when no trace or script is given, about 25 C */
+#define SIM_ADC_DEFAULT         310
+
+/* Power-on state of the models, before the scheduler starts */
+void Sim_Board_Init(void);
+
+/* One ADC code per line at LM35_ADC_SAMPLE_RATE_HZ, '#' starts a comment.
+   The last code is held once the trace ends. */
+bool Sim_Adc_LoadTrace(const char *path);
+
+/* "ms:code,ms:code,...", each code from its time on, times ascending */
+bool Sim_Adc_LoadSteps(const char *steps);
+
+/* Prints the SIM summary line */
+void Sim_Board_Report(void);
+
+#endif
@@ -0,0 +1,63 @@
+/*
+ * Host stand-in for the parts of the STM32F4 HAL that App.h, App.c and the
+ * simulated modules touch. The peripherals themselves are behind Board.h,
+ * sim_board.c implements it.
+ */
+#ifndef APP_SIM_STM32F4XX_HAL_H
+#define APP_SIM_STM32F4XX_HAL_H
+
+#include <stdint.h>
+
+typedef enum
+{
+    HAL_OK = 0,
+    HAL_ERROR,
+    HAL_BUSY,
+    HAL_TIMEOUT
+} HAL_StatusTypeDef;
+
+typedef struct
+{
+    uint32_t unused;
+} USART_TypeDef;
+
+typedef struct
+{
+    uint32_t ErrorCode;
+} DMA_HandleTypeDef;
+
+typedef struct
+{
+    USART_TypeDef *Instance;
+    DMA_HandleTypeDef *hdmarx;
+    uint32_t ErrorCode;
+} UART_HandleTypeDef;
+
+typedef struct
+{
+    uint32_t unused;
+} GPIO_TypeDef;
+
+extern USART_TypeDef sim_usart[3];
+extern GPIO_TypeDef sim_gpioc;
+
+#define USART1                  (&sim_usart[0])
+#define USART2                  (&sim_usart[1])
+#define USART3                  (&sim_usart[2])
+#define HAL_UART_ERROR_PE       0x00000001U
+#define HAL_UART_ERROR_NE       0x00000002U
+#define HAL_UART_ERROR_FE       0x00000004U
+#define HAL_UART_ERROR_ORE      0x00000008U
+#define HAL_UART_ERROR_DMA      0x00000010U
+#define HAL_DMA_ERROR_NONE      0x00000000U
+
+#define GPIOC                   (&sim_gpioc)
+#define GPIO_PIN_13             ((uint16_t)0x2000)
+
+/* SampleRing.c orders its stores, the host needs a full barrier */
+#define __DMB()                 __sync_synchronize()
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef *port, uint16_t pin);
+void HAL_Delay(uint32_t ms);
+
+#endif
@@ -0,0 +1,174 @@
+/*
+ * Host benchmark of the LM35 ADC code -> temperature conversion.
+ *
+ * LM35_AdcToCentiCelsius() from Application/Src/Lm35.c (build time lookup
+ * table + Q4 interpolation, integer only) is compared with the float
+ * formula the firmware used before,
+ *     temperature_c = (adc * 3.3f * 100.0f) / 4095.0f
+ * for speed (TSC cycles and ns per conversion over all 4096 codes) and for
+ * accuracy against the exact value code * 33000 / 4095 centi-degrees:
+ *   - every one of the 4096 table codes must be within 0.5 cdeg (rounded),
+ *   - every Q4 input (65536 of them) must be within 1 cdeg after interpolation.
+ * The exit code is non-zero if either check fails.
+ *
+ *     -r <n>         timing passes over the 4096 codes, the fastest is kept (default 200)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "App.h"
+#include "Lm35.c"
+
+#define CONV_CODES          (LM35_ADC_MAX_CODE + 1)
+#define CONV_Q4_ONE         (1U << LM35_FILTER_FRAC_BITS)
+
+static volatile int32_t conv_sink_i;
+static volatile float conv_sink_f;
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static uint64_t now_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return (uint64_t)now_ns();
+#endif
+}
+
+/* The conversion Lm35.c used before the table, kept verbatim */
+static float conv_float(uint32_t adc_raw)
+{
+    return ((float)(adc_raw) * 3.3f * 100.0f) / 4095.0f;
+}
+
+static double conv_exact_cdeg(double code)
+{
+    return code * LM35_VREF_MV * 10.0 / LM35_ADC_MAX_CODE;
+}
+
+/* Fastest pass over all codes, per conversion */
+static void conv_time_lut(int repeat, double *cycles, double *ns)
+{
+    *cycles = INFINITY;
+    *ns = INFINITY;
+    for (int r = 0; r < repeat; r++)
+    {
+        uint64_t c0 = now_cycles();
+        double t0 = now_ns();
+        for (uint32_t code = 0; code < CONV_CODES; code++)
+        {
+            conv_sink_i = LM35_AdcToCentiCelsius(code << LM35_FILTER_FRAC_BITS);
+        }
+        double t = now_ns() - t0;
+        double c = (double)(now_cycles() - c0);
+        if (c < *cycles) *cycles = c;
+        if (t < *ns) *ns = t;
+    }
+    *cycles /= CONV_CODES;
+    *ns /= CONV_CODES;
+}
+
+static void conv_time_float(int repeat, double *cycles, double *ns)
+{
+    *cycles = INFINITY;
+    *ns = INFINITY;
+    for (int r = 0; r < repeat; r++)
+    {
+        uint64_t c0 = now_cycles();
+        double t0 = now_ns();
+        for (uint32_t code = 0; code < CONV_CODES; code++)
+        {
+            conv_sink_f = conv_float(code);
+        }
+        double t = now_ns() - t0;
+        double c = (double)(now_cycles() - c0);
+        if (c < *cycles) *cycles = c;
+        if (t < *ns) *ns = t;
+    }
+    *cycles /= CONV_CODES;
+    *ns /= CONV_CODES;
+}
+
+int main(int argc, char **argv)
+{
+    int repeat = 200;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "r:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'r': repeat = atoi(optarg); break;
+        default:
+            fprintf(stderr, "usage: %s [-r n]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (repeat < 1)
+    {
+        fprintf(stderr, "-r must be at least 1\n");
+        return 1;
+    }
+
+    /* Table codes: LUT and float against the exact value */
+    double lut_max = 0.0, float_max = 0.0, lut_sum = 0.0;
+    uint32_t lut_worst = 0, float_worst = 0, lut_bad = 0;
+
+    for (uint32_t code = 0; code < CONV_CODES; code++)
+    {
+        double exact = conv_exact_cdeg(code);
+        double lut_err = fabs((double)LM35_AdcToCentiCelsius(code << LM35_FILTER_FRAC_BITS) - exact);
+        double float_err = fabs((double)conv_float(code) * 100.0 - exact);
+
+        lut_sum += lut_err;
+        if (lut_err > lut_max) { lut_max = lut_err; lut_worst = code; }
+        if (float_err > float_max) { float_max = float_err; float_worst = code; }
+        if (lut_err > 0.5) lut_bad++;
+    }
+
+    /* Every Q4 input, interpolated between two table entries */
+    double q4_max = 0.0, q4_bias = 0.0;
+    uint32_t q4_worst = 0, q4_bad = 0;
+    uint32_t q4_count = LM35_ADC_MAX_CODE * CONV_Q4_ONE + 1;
+
+    for (uint32_t q4 = 0; q4 < q4_count; q4++)
+    {
+        double error = (double)LM35_AdcToCentiCelsius(q4) - conv_exact_cdeg((double)q4 / CONV_Q4_ONE);
+
+        q4_bias += error;
+        if (fabs(error) > q4_max) { q4_max = fabs(error); q4_worst = q4; }
+        if (fabs(error) > 1.0) q4_bad++;
+    }
+    q4_bias /= q4_count;
+
+    double lut_cycles, lut_ns, float_cycles, float_ns;
+    conv_time_lut(repeat, &lut_cycles, &lut_ns);
+    conv_time_float(repeat, &float_cycles, &float_ns);
+
+    printf("%u codes, Vref %u mV, LUT %u bytes, Q%u interpolation\n\n", (unsigned)CONV_CODES,
+           (unsigned)LM35_VREF_MV, (unsigned)sizeof(lm35_cdeg_lut), (unsigned)LM35_FILTER_FRAC_BITS);
+    printf("%-6s %11s %10s %14s %11s\n", "method", "cyc/conv", "ns/conv", "max err cdeg", "at code");
+    printf("%-6s %11.1f %10.2f %14.3f %11u\n", "lut", lut_cycles, lut_ns, lut_max, (unsigned)lut_worst);
+    printf("%-6s %11.1f %10.2f %14.3f %11u\n", "float", float_cycles, float_ns, float_max, (unsigned)float_worst);
+    printf("\ntable codes : avg err %.3f cdeg, %u of %u over 0.5 cdeg\n",
+           lut_sum / CONV_CODES, (unsigned)lut_bad, (unsigned)CONV_CODES);
+    printf("Q4 inputs   : max err %.3f cdeg at %u.%02u, bias %+.3f cdeg, %u of %u over 1 cdeg\n",
+           q4_max, (unsigned)(q4_worst >> LM35_FILTER_FRAC_BITS),
+           (unsigned)(((q4_worst & (CONV_Q4_ONE - 1)) * 100) / CONV_Q4_ONE), q4_bias,
+           (unsigned)q4_bad, (unsigned)q4_count);
+
+    return ((lut_bad != 0) || (q4_bad != 0)) ? 1 : 0;
+}
@@ -0,0 +1,38 @@
+/*
+ * Host replacement for Application/Inc/App.h (same include guard), only what
+ * Lm35.c needs to compile. The task loop is never run, so the sample ring,
+ * health and board functions do nothing.
+ */
+#ifndef SRC_APP_H_
+#define SRC_APP_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "Lm35.h"
+
+#define HEALTH_SENSOR_DISCONNECTED  (1UL << 0)
+#define HEALTH_ADC_TIMEOUT          (1UL << 1)
+#define HEALTH_OVER_TEMPERATURE     (1UL << 2)
+
+typedef struct SampleReader SampleReader_t;
+
+static inline void SampleRing_Publish(const LM35_Data_t *data) { (void)data; }
+static inline bool SampleRing_Latest(SampleReader_t *reader, LM35_Sample_t *sample)
+{
+    (void)reader; (void)sample;
+    return false;
+}
+static inline void Health_Update(EventBits_t set, EventBits_t clear) { (void)set; (void)clear; }
+static inline bool Board_Adc_Start(uint16_t *buffer, uint32_t length) { (void)buffer; (void)length; return false; }
+static inline void Board_Adc_Stop(void) {}
+
+#define TRACE(fmt, ...)     do { } while (0)
+
+#endif
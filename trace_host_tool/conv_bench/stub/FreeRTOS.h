@@ -0,0 +1,23 @@
+/*
+ * Minimal FreeRTOS.h for building Lm35.c on a host.
+ * Single threaded, only the conversion functions are called.
+ */
+#ifndef CONV_BENCH_FREERTOS_H
+#define CONV_BENCH_FREERTOS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint32_t EventBits_t;
+
+#define pdFALSE                 ((BaseType_t)0)
+#define pdTRUE                  ((BaseType_t)1)
+#define pdPASS                  pdTRUE
+#define portMAX_DELAY           ((TickType_t)0xFFFFFFFFUL)
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(ms))
+#define portYIELD_FROM_ISR(x)   ((void)(x))
+
+#endif
@@ -0,0 +1,232 @@
+/*
+ * Host benchmark of the LM35 filter stage in Application/Src/Lm35.c.
+ *
+ * A slow noisy ramp, quantised to 12 bits with occasional spikes, is fed
+ * through LM35_Filter_Block() (median-of-k -> CIC decimator) for every
+ * median_k and every decim_log2 the firmware accepts. Per setting it prints
+ * the cost per input sample (TSC cycles and ns, 64 sample blocks as in the
+ * task) and the accuracy of the Q4 output against the noiseless ramp,
+ * delayed by the filter group delay: rms error and bias in LSB, and
+ *     ENOB = 12 - log2(rms_error_LSB * sqrt(12))
+ * i.e. 12.0 for an ideal 12-bit converter, at most 16 with the Q4 output.
+ *
+ *     -n <LSB>       input noise, gaussian sigma (default 1)
+ *     -p <permille>  spikes per 1000 samples, +/-200..1000 LSB (default 1)
+ *     -N <log2>      input samples per setting (default 20, 1M samples)
+ *     -r <n>         timing repetitions, the fastest is kept (default 5)
+ *     -s <seed>      noise/spike seed (default 1)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "App.h"
+#include "Lm35.c"
+
+#define BENCH_BLOCK         (LM35_DMA_BUFFER_LEN / 2)
+#define BENCH_RAMP_FROM     200.0
+#define BENCH_RAMP_TO       3800.0
+
+static const uint8_t bench_median_k[] = { 0, 3, 5, 7 };
+
+static uint16_t *bench_input;
+static uint32_t bench_samples;
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static uint64_t now_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return (uint64_t)now_ns();
+#endif
+}
+
+static double bench_gauss(void)
+{
+    double u1 = ((double)rand() + 1.0) / ((double)RAND_MAX + 2.0);
+    double u2 = ((double)rand() + 1.0) / ((double)RAND_MAX + 2.0);
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+/* Noiseless input at sample i, in LSB */
+static double bench_ramp(double i)
+{
+    return BENCH_RAMP_FROM + ((BENCH_RAMP_TO - BENCH_RAMP_FROM) * i / (double)bench_samples);
+}
+
+static void bench_generate(double noise_lsb, double spike_permille)
+{
+    for (uint32_t i = 0; i < bench_samples; i++)
+    {
+        double value = bench_ramp(i) + (noise_lsb * bench_gauss());
+
+        if ((rand() % 1000000) < (int)(spike_permille * 1000.0))
+        {
+            double spike = 200.0 + (rand() % 801);
+            value += (rand() & 1) ? spike : -spike;
+        }
+
+        long code = lround(value);
+        if (code < 0) code = 0;
+        if (code > LM35_ADC_MAX_CODE) code = LM35_ADC_MAX_CODE;
+        bench_input[i] = (uint16_t)code;
+    }
+}
+
+static double bench_enob(double rms_lsb)
+{
+    return 12.0 - log2(rms_lsb * sqrt(12.0));
+}
+
+/* Fastest of n passes over the whole input, in 64 sample blocks */
+static void bench_time(const LM35_Config_t *config, int repeat, double *cycles, double *ns)
+{
+    *cycles = INFINITY;
+    *ns = INFINITY;
+
+    for (int r = 0; r < repeat; r++)
+    {
+        LM35_Filter_Reset(&lm35_filter, config);
+        volatile uint32_t sink = 0;
+        uint64_t c0 = now_cycles();
+        double t0 = now_ns();
+
+        for (uint32_t i = 0; i + BENCH_BLOCK <= bench_samples; i += BENCH_BLOCK)
+        {
+            sink += LM35_Filter_Block(&lm35_filter, &bench_input[i], BENCH_BLOCK);
+        }
+
+        double t = now_ns() - t0;
+        double c = (double)(now_cycles() - c0);
+        (void)sink;
+        if (c < *cycles) *cycles = c;
+        if (t < *ns) *ns = t;
+    }
+
+    *cycles /= bench_samples;
+    *ns /= bench_samples;
+}
+
+/* Every output against the ramp delayed by (k - 1) / 2 + ORDER * (R - 1) / 2 */
+static uint32_t bench_accuracy(const LM35_Config_t *config, double *rms, double *bias)
+{
+    double delay = ((config->median_k > 0) ? (config->median_k - 1) / 2.0 : 0.0) +
+                   (LM35_FILTER_CIC_ORDER * ((double)(1UL << config->decim_log2) - 1.0) / 2.0);
+    double sum = 0.0;
+    double sum_sq = 0.0;
+    uint32_t outputs = 0;
+    uint32_t skip = 2;
+
+    LM35_Filter_Reset(&lm35_filter, config);
+    for (uint32_t i = 0; i < bench_samples; i++)
+    {
+        if (!LM35_Filter_Block(&lm35_filter, &bench_input[i], 1))
+        {
+            continue;
+        }
+        if (skip > 0)
+        {
+            skip--;
+            continue;
+        }
+
+        double error = ((double)lm35_filter.output_q4 / (1 << LM35_FILTER_FRAC_BITS)) - bench_ramp(i - delay);
+        sum += error;
+        sum_sq += error * error;
+        outputs++;
+    }
+
+    *bias = outputs ? sum / outputs : 0.0;
+    *rms = outputs ? sqrt(sum_sq / outputs) : 0.0;
+    return outputs;
+}
+
+int main(int argc, char **argv)
+{
+    double noise_lsb = 1.0;
+    double spike_permille = 1.0;
+    unsigned log2_samples = 20;
+    int repeat = 5;
+    unsigned seed = 1;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:p:N:r:s:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n': noise_lsb = atof(optarg); break;
+        case 'p': spike_permille = atof(optarg); break;
+        case 'N': log2_samples = (unsigned)strtoul(optarg, NULL, 0); break;
+        case 'r': repeat = atoi(optarg); break;
+        case 's': seed = (unsigned)strtoul(optarg, NULL, 0); break;
+        default:
+            fprintf(stderr, "usage: %s [-n LSB] [-p permille] [-N log2] [-r n] [-s seed]\n", argv[0]);
+            return 1;
+        }
+    }
+    if ((log2_samples < 12) || (log2_samples > 26) || (repeat < 1))
+    {
+        fprintf(stderr, "-N must be 12..26, -r at least 1\n");
+        return 1;
+    }
+
+    srand(seed);
+    bench_samples = 1UL << log2_samples;
+    bench_input = malloc(bench_samples * sizeof(*bench_input));
+    if (bench_input == NULL)
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    bench_generate(noise_lsb, spike_permille);
+
+    /* Raw input against the ramp, the reference point */
+    double sum_sq = 0.0;
+    for (uint32_t i = 0; i < bench_samples; i++)
+    {
+        double error = bench_input[i] - bench_ramp(i);
+        sum_sq += error * error;
+    }
+    double raw_rms = sqrt(sum_sq / bench_samples);
+
+    printf("%u samples, ramp %.0f..%.0f LSB, noise %.2f LSB rms, %.2f spikes/1000, CIC order %u, Q%u output\n",
+           (unsigned)bench_samples, BENCH_RAMP_FROM, BENCH_RAMP_TO, noise_lsb, spike_permille,
+           (unsigned)LM35_FILTER_CIC_ORDER, (unsigned)LM35_FILTER_FRAC_BITS);
+    printf("raw ADC: rms error %.3f LSB, ENOB %.2f\n\n", raw_rms, bench_enob(raw_rms));
+    printf("%8s %6s %8s %11s %10s %9s %9s %6s\n", "median_k", "decim", "outputs", "cyc/sample",
+           "ns/sample", "rms LSB", "bias LSB", "ENOB");
+
+    for (size_t m = 0; m < sizeof(bench_median_k) / sizeof(bench_median_k[0]); m++)
+    {
+        for (uint8_t d = LM35_FILTER_DECIM_MIN; d <= LM35_FILTER_DECIM_MAX; d++)
+        {
+            LM35_Config_t config = lm35_config;
+            double cycles, ns, rms, bias;
+            uint32_t outputs;
+
+            config.median_k = bench_median_k[m];
+            config.decim_log2 = d;
+            bench_time(&config, repeat, &cycles, &ns);
+            outputs = bench_accuracy(&config, &rms, &bias);
+
+            printf("%8u %6u %8u %11.1f %10.2f %9.4f %9.4f %6.2f\n", (unsigned)config.median_k,
+                   1U << d, (unsigned)outputs, cycles, ns, rms, bias, bench_enob(rms));
+        }
+    }
+
+    free(bench_input);
+    return 0;
+}
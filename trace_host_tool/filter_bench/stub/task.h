@@ -0,0 +1,33 @@
+/* Minimal task.h for the host filter benchmark, the LM35 task is never run */
+#ifndef FILTER_BENCH_TASK_H
+#define FILTER_BENCH_TASK_H
+
+#include "FreeRTOS.h"
+
+typedef void *TaskHandle_t;
+
+typedef enum
+{
+    eNoAction = 0,
+    eSetBits
+} eNotifyAction;
+
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+static inline TickType_t xTaskGetTickCount(void) { return 0; }
+static inline TaskHandle_t xTaskGetCurrentTaskHandle(void) { return NULL; }
+static inline BaseType_t xTaskNotifyWait(uint32_t clear_on_entry, uint32_t clear_on_exit,
+                                         uint32_t *value, TickType_t timeout)
+{
+    (void)clear_on_entry; (void)clear_on_exit; (void)value; (void)timeout;
+    return pdFALSE;
+}
+static inline BaseType_t xTaskNotifyFromISR(TaskHandle_t task, uint32_t value, eNotifyAction action,
+                                            BaseType_t *higher_priority_woken)
+{
+    (void)task; (void)value; (void)action; (void)higher_priority_woken;
+    return pdPASS;
+}
+
+#endif
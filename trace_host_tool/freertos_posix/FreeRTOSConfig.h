@@ -0,0 +1,71 @@
+/*
+ * FreeRTOSConfig.h for the Linux host builds on freertos_posix.
+ *
+ * Kernel features, priorities, tick rate and heap size follow
+ * Core/Inc/FreeRTOSConfig.h so the application sees the same kernel. What
+ * only makes sense on the Cortex-M4 (NVIC priorities, tickless sleep, FPU,
+ * run time stats from TIM5) is left out. The priority count and the task
+ * selection can be overridden from the command line, kernel_bench builds the
+ * configuration the target had before as well.
+ */
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#include <stdint.h>
+
+#define configUSE_PREEMPTION                     1
+#define configUSE_TICKLESS_IDLE                  0
+#define configSUPPORT_STATIC_ALLOCATION          1
+#define configSUPPORT_DYNAMIC_ALLOCATION         1
+#define configUSE_IDLE_HOOK                      1      /* Owned by port.c, idle sleeps */
+#ifndef configUSE_TICK_HOOK
+#define configUSE_TICK_HOOK                      0
+#endif
+#define configCPU_CLOCK_HZ                       (180000000UL)
+#define configTICK_RATE_HZ                       ((TickType_t)1000)
+#ifndef configMAX_PRIORITIES
+#define configMAX_PRIORITIES                     (8)
+#endif
+#define configMINIMAL_STACK_SIZE                 ((uint16_t)128)
+#define configTOTAL_HEAP_SIZE                    ((size_t)15360)
+#define configMAX_TASK_NAME_LEN                  (16)
+#define configUSE_TRACE_FACILITY                 1
+#define configGENERATE_RUN_TIME_STATS            0
+#define configUSE_16_BIT_TICKS                   0
+#define configUSE_MUTEXES                        1
+#define configQUEUE_REGISTRY_SIZE                8
+#define configUSE_RECURSIVE_MUTEXES              1
+#define configUSE_COUNTING_SEMAPHORES            1
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION  1
+#endif
+#define configMESSAGE_BUFFER_LENGTH_TYPE         size_t
+#define configUSE_MALLOC_FAILED_HOOK             1      /* FreeRTOS.h default, as on the target */
+#define configCHECK_FOR_STACK_OVERFLOW           0      /* Tasks run on their pthread stacks */
+
+#define configUSE_CO_ROUTINES                    0
+#define configMAX_CO_ROUTINE_PRIORITIES          (2)
+
+#define configUSE_TIMERS                         1
+#define configTIMER_TASK_PRIORITY                (2)
+#define configTIMER_QUEUE_LENGTH                 10
+#define configTIMER_TASK_STACK_DEPTH             256
+
+#define INCLUDE_vTaskPrioritySet                 1
+#define INCLUDE_uxTaskPriorityGet                1
+#define INCLUDE_vTaskDelete                      1
+#define INCLUDE_vTaskCleanUpResources            0
+#define INCLUDE_vTaskSuspend                     1
+#define INCLUDE_vTaskDelayUntil                  1
+#define INCLUDE_vTaskDelay                       1
+#define INCLUDE_xTaskGetSchedulerState           1
+#define INCLUDE_xTimerPendFunctionCall           1
+#define INCLUDE_xQueueGetMutexHolder             1
+#define INCLUDE_uxTaskGetStackHighWaterMark      1
+#define INCLUDE_xTaskGetCurrentTaskHandle        1
+#define INCLUDE_eTaskGetState                    1
+
+void vAssertCalled(const char *file, int line);
+#define configASSERT(x)                          if ((x) == 0) vAssertCalled(__FILE__, __LINE__)
+
+#endif /* FREERTOS_CONFIG_H */
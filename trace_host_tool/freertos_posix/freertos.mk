@@ -0,0 +1,14 @@
+# Kernel, port and heap for the host builds on the FreeRTOS POSIX port.
+# Included by the tool Makefiles, APP can be overridden on the command line.
+FREERTOS_POSIX := $(dir $(lastword $(MAKEFILE_LIST)))
+APP ?= $(FREERTOS_POSIX)../../Stm32F446reFreeRtos_Application
+RTOS := $(APP)/Middlewares/Third_Party/FreeRTOS/Source
+
+RTOS_SRC := $(RTOS)/tasks.c $(RTOS)/queue.c $(RTOS)/list.c $(RTOS)/timers.c \
+            $(RTOS)/event_groups.c $(RTOS)/stream_buffer.c \
+            $(FREERTOS_POSIX)port.c $(APP)/Application/Src/Heap.c
+RTOS_INC := -I$(FREERTOS_POSIX) -I$(RTOS)/include -I$(APP)/Application/Inc
+RTOS_DEPS := $(wildcard $(FREERTOS_POSIX)*.h)
+
+CFLAGS ?= -O2 -g -Wall
+LDLIBS += -pthread
@@ -0,0 +1,440 @@
+/*
+ * FreeRTOS port for Linux hosts, for the simulation and benchmark builds of
+ * the application. The tree only carries the ARM_CM4F port, this one is
+ * written from the port interface in portable.h.
+ *
+ * Every task is a pthread. A single CPU token (port_owner) decides which
+ * thread runs, all others wait on their condition variable, so the kernel
+ * sees one core exactly as on the target. A context switch passes the token
+ * and waits for it to come back.
+ *
+ * Interrupts are simulated. The tick thread and the peripheral models pend
+ * a handler with vPortPendInterrupt(), the thread holding the token runs it
+ * the next time it enables interrupts: leaving the last critical section,
+ * a yield, or the idle hook. A task is never stopped asynchronously, so a
+ * task that computes without calling the kernel holds the tick off like a
+ * long critical section would. Ticks pended meanwhile are counted, none is
+ * lost. The idle hook sleeps until the next interrupt.
+ *
+ * With vPortSetVirtualTime() there is no tick thread: when every task is
+ * blocked the idle hook raises the next tick at once, so simulated time
+ * runs as fast as the host allows and a run is repeatable. Time then only
+ * moves while the idle task runs.
+ *
+ * The port owns vApplicationIdleHook (configUSE_IDLE_HOOK must be 1).
+ */
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define PORT_MAX_INTERRUPTS     8
+#define PORT_NESTING_INIT       0xAAAAU     /* Before the scheduler, as the CM4F port */
+
+typedef struct
+{
+    pthread_t thread;
+    pthread_cond_t cond;
+    TaskFunction_t code;
+    void *params;
+    bool dying;
+} PortThread_t;
+
+/* CPU token and everything host threads touch, under port_lock */
+static pthread_mutex_t port_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t port_irq_cond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t port_end_cond = PTHREAD_COND_INITIALIZER;
+static PortThread_t *port_owner;
+static bool port_ended;
+static uint32_t port_ticks_pending;
+static void (*port_irq_handler[PORT_MAX_INTERRUPTS])(void);
+static bool port_irq_pending[PORT_MAX_INTERRUPTS];
+
+/* Processor state, only the token holder touches it */
+static bool port_started;
+static bool port_masked = true;
+static bool port_in_isr;
+static bool port_switch_pending;
+static uint32_t port_nesting = PORT_NESTING_INIT;
+
+static bool port_virtual_time;
+static pthread_t port_tick_thread;
+static struct timespec port_epoch;
+
+static PortThread_t *prvThreadOf(void *task)
+{
+    /* pxTopOfStack is the first TCB member and never moves in this port */
+    return (PortThread_t *)(*(StackType_t **)task + 1);
+}
+
+/* Caller holds port_lock, returns with it held once the token is back */
+static void prvWaitForToken(PortThread_t *self)
+{
+    while ((port_owner != self) && !self->dying)
+    {
+        pthread_cond_wait(&self->cond, &port_lock);
+    }
+    if (self->dying)
+    {
+        pthread_mutex_unlock(&port_lock);
+        pthread_exit(NULL);
+    }
+}
+
+/* PendSV: pick the next task and hand it the token */
+static void prvSwitchContext(void)
+{
+    PortThread_t *from = prvThreadOf(xTaskGetCurrentTaskHandle());
+    PortThread_t *to;
+
+    vTaskSwitchContext();
+    to = prvThreadOf(xTaskGetCurrentTaskHandle());
+    if (to == from)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&port_lock);
+    port_owner = to;
+    pthread_cond_signal(&to->cond);
+    prvWaitForToken(from);
+    pthread_mutex_unlock(&port_lock);
+}
+
+static void prvTickHandler(void)
+{
+    if (xTaskIncrementTick() != pdFALSE)
+    {
+        port_switch_pending = true;
+    }
+}
+
+/* Next pending handler, the tick first. Caller holds port_lock. */
+static void (*prvTakeInterrupt(void))(void)
+{
+    if (port_ticks_pending > 0)
+    {
+        port_ticks_pending--;
+        return prvTickHandler;
+    }
+    for (int i = 0; i < PORT_MAX_INTERRUPTS; i++)
+    {
+        if (port_irq_pending[i])
+        {
+            port_irq_pending[i] = false;
+            return port_irq_handler[i];
+        }
+    }
+    return NULL;
+}
+
+/* Runs every pending handler, then the requested switch. Caller holds the
+   token with interrupts enabled. */
+static void prvServiceInterrupts(void)
+{
+    for (;;)
+    {
+        for (;;)
+        {
+            void (*handler)(void);
+
+            pthread_mutex_lock(&port_lock);
+            handler = prvTakeInterrupt();
+            pthread_mutex_unlock(&port_lock);
+            if (handler == NULL)
+            {
+                break;
+            }
+
+            port_masked = true;
+            port_in_isr = true;
+            handler();
+            port_in_isr = false;
+            port_masked = false;
+        }
+
+        if (!port_switch_pending)
+        {
+            break;
+        }
+        port_switch_pending = false;
+        prvSwitchContext();
+    }
+}
+
+static bool prvCanService(void)
+{
+    return port_started && !port_masked && !port_in_isr && (port_nesting == 0);
+}
+
+static void *prvThreadEntry(void *arg)
+{
+    PortThread_t *self = arg;
+
+    pthread_mutex_lock(&port_lock);
+    prvWaitForToken(self);
+    pthread_mutex_unlock(&port_lock);
+
+    prvServiceInterrupts();
+    self->code(self->params);
+
+    /* Tasks must not return, delete it as the kernel would expect */
+    vTaskDelete(NULL);
+    return NULL;
+}
+
+static void *prvTickEntry(void *arg)
+{
+    struct timespec next = port_epoch;
+    const long period_ns = 1000000000L / configTICK_RATE_HZ;
+
+    (void)arg;
+    for (;;)
+    {
+        next.tv_nsec += period_ns;
+        if (next.tv_nsec >= 1000000000L)
+        {
+            next.tv_nsec -= 1000000000L;
+            next.tv_sec++;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+
+        pthread_mutex_lock(&port_lock);
+        if (port_ended)
+        {
+            pthread_mutex_unlock(&port_lock);
+            return NULL;
+        }
+        port_ticks_pending++;
+        pthread_cond_broadcast(&port_irq_cond);
+        pthread_mutex_unlock(&port_lock);
+    }
+}
+
+StackType_t *pxPortInitialiseStack(StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters)
+{
+    /* The thread record sits at the top of the task stack, the pthread has
+       its own stack */
+    uintptr_t top = (uintptr_t)(pxTopOfStack + 1);
+    PortThread_t *thread = (PortThread_t *)((top - sizeof(PortThread_t)) & ~(uintptr_t)15U);
+    pthread_attr_t attr;
+
+    memset(thread, 0, sizeof(*thread));
+    thread->code = pxCode;
+    thread->params = pvParameters;
+    pthread_cond_init(&thread->cond, NULL);
+
+    pthread_attr_init(&attr);
+    if (pthread_create(&thread->thread, &attr, prvThreadEntry, thread) != 0)
+    {
+        fprintf(stderr, "freertos_posix: pthread_create failed\n");
+        abort();
+    }
+    pthread_attr_destroy(&attr);
+
+    return (StackType_t *)thread - 1;
+}
+
+BaseType_t xPortStartScheduler(void)
+{
+    PortThread_t *first = prvThreadOf(xTaskGetCurrentTaskHandle());
+
+    clock_gettime(CLOCK_MONOTONIC, &port_epoch);
+    port_nesting = 0;
+    port_masked = false;
+    port_started = true;
+
+    pthread_mutex_lock(&port_lock);
+    if (!port_virtual_time && (pthread_create(&port_tick_thread, NULL, prvTickEntry, NULL) != 0))
+    {
+        fprintf(stderr, "freertos_posix: tick thread creation failed\n");
+        abort();
+    }
+    port_owner = first;
+    pthread_cond_signal(&first->cond);
+    while (!port_ended)
+    {
+        pthread_cond_wait(&port_end_cond, &port_lock);
+    }
+    pthread_mutex_unlock(&port_lock);
+
+    if (!port_virtual_time)
+    {
+        pthread_join(port_tick_thread, NULL);
+    }
+    return pdFALSE;
+}
+
+void vPortEndScheduler(void)
+{
+    PortThread_t *self = prvThreadOf(xTaskGetCurrentTaskHandle());
+
+    /* Back to main, the calling task never runs again */
+    port_started = false;
+    pthread_mutex_lock(&port_lock);
+    port_ended = true;
+    port_owner = NULL;
+    pthread_cond_signal(&port_end_cond);
+    prvWaitForToken(self);
+    pthread_mutex_unlock(&port_lock);
+}
+
+void vPortYield(void)
+{
+    port_switch_pending = true;
+    if (prvCanService())
+    {
+        prvServiceInterrupts();
+    }
+}
+
+void vPortYieldFromISR(BaseType_t switch_required)
+{
+    if (switch_required != pdFALSE)
+    {
+        port_switch_pending = true;
+    }
+}
+
+void vPortDisableInterrupts(void)
+{
+    port_masked = true;
+}
+
+void vPortEnableInterrupts(void)
+{
+    port_masked = false;
+    if (prvCanService())
+    {
+        prvServiceInterrupts();
+    }
+}
+
+void vPortEnterCritical(void)
+{
+    port_masked = true;
+    port_nesting++;
+}
+
+void vPortExitCritical(void)
+{
+    configASSERT(port_nesting > 0);
+    if (--port_nesting == 0)
+    {
+        vPortEnableInterrupts();
+    }
+}
+
+UBaseType_t uxPortSetInterruptMask(void)
+{
+    UBaseType_t was_masked = port_masked;
+
+    port_masked = true;
+    return was_masked;
+}
+
+void vPortClearInterruptMask(UBaseType_t mask)
+{
+    /* Pending interrupts run at the next kernel entry, not from inside an
+       ISR style section */
+    port_masked = (mask != 0);
+}
+
+void vPortCancelThread(void *task)
+{
+    PortThread_t *thread = prvThreadOf(task);
+
+    pthread_mutex_lock(&port_lock);
+    thread->dying = true;
+    pthread_cond_signal(&thread->cond);
+    pthread_mutex_unlock(&port_lock);
+
+    pthread_join(thread->thread, NULL);
+    pthread_cond_destroy(&thread->cond);
+}
+
+void vPortPendInterrupt(void (*handler)(void))
+{
+    int i;
+
+    pthread_mutex_lock(&port_lock);
+    for (i = 0; i < PORT_MAX_INTERRUPTS; i++)
+    {
+        if ((port_irq_handler[i] == handler) || (port_irq_handler[i] == NULL))
+        {
+            break;
+        }
+    }
+    if (i == PORT_MAX_INTERRUPTS)
+    {
+        fprintf(stderr, "freertos_posix: more than %d interrupt handlers\n", PORT_MAX_INTERRUPTS);
+        abort();
+    }
+    port_irq_handler[i] = handler;
+    port_irq_pending[i] = true;
+    pthread_cond_broadcast(&port_irq_cond);
+    bool own = (port_owner != NULL) && pthread_equal(port_owner->thread, pthread_self());
+    pthread_mutex_unlock(&port_lock);
+
+    /* Pended by the running task: taken at once, as on the NVIC */
+    if (own && prvCanService())
+    {
+        prvServiceInterrupts();
+    }
+}
+
+void vPortSetVirtualTime(void)
+{
+    configASSERT(!port_started);
+    port_virtual_time = true;
+}
+
+uint64_t ullPortGetTimeNs(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)(now.tv_sec - port_epoch.tv_sec) * 1000000000ULL +
+           (uint64_t)(now.tv_nsec - port_epoch.tv_nsec);
+}
+
+/* Idle: sleep until something is pending, then take it. In virtual time
+   the next tick is due now. */
+void vApplicationIdleHook(void)
+{
+    pthread_mutex_lock(&port_lock);
+    while (port_ticks_pending == 0)
+    {
+        bool pending = false;
+
+        for (int i = 0; i < PORT_MAX_INTERRUPTS; i++)
+        {
+            pending |= port_irq_pending[i];
+        }
+        if (pending)
+        {
+            break;
+        }
+        if (port_virtual_time)
+        {
+            port_ticks_pending++;
+            break;
+        }
+        pthread_cond_wait(&port_irq_cond, &port_lock);
+    }
+    pthread_mutex_unlock(&port_lock);
+
+    prvServiceInterrupts();
+}
+
+void vAssertCalled(const char *file, int line)
+{
+    fprintf(stderr, "configASSERT failed at %s:%d\n", file, line);
+    abort();
+}
@@ -0,0 +1,96 @@
+/*
+ * FreeRTOS port for Linux hosts, see port.c.
+ *
+ * Types are sized for a 64-bit host: stack words and pointers are 8 bytes,
+ * ticks stay 32 bits as on the target. Interrupt masking and the context
+ * switch request only change port state, the switch itself happens when
+ * interrupts are enabled again, as PendSV does on the Cortex-M4.
+ */
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define portCHAR                char
+#define portFLOAT               float
+#define portDOUBLE              double
+#define portLONG                long
+#define portSHORT               short
+#define portSTACK_TYPE          size_t
+#define portBASE_TYPE           long
+#define portPOINTER_SIZE_TYPE   size_t
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#if (configUSE_16_BIT_TICKS == 1)
+#error "freertos_posix: 32-bit ticks only"
+#endif
+typedef uint32_t TickType_t;
+#define portMAX_DELAY           ((TickType_t)0xFFFFFFFFUL)
+#define portTICK_TYPE_IS_ATOMIC 1
+
+#define portSTACK_GROWTH        (-1)
+#define portTICK_PERIOD_MS      ((TickType_t)1000 / configTICK_RATE_HZ)
+#define portBYTE_ALIGNMENT      8
+#define portNOP()
+#define portMEMORY_BARRIER()    __sync_synchronize()
+
+/* Scheduler, interrupts and critical sections */
+void vPortYield(void);
+void vPortYieldFromISR(BaseType_t switch_required);
+void vPortEnableInterrupts(void);
+void vPortDisableInterrupts(void);
+void vPortEnterCritical(void);
+void vPortExitCritical(void);
+UBaseType_t uxPortSetInterruptMask(void);
+void vPortClearInterruptMask(UBaseType_t mask);
+void vPortCancelThread(void *task);
+
+#define portYIELD()                         vPortYield()
+#define portYIELD_WITHIN_API()              vPortYield()
+#define portEND_SWITCHING_ISR(x)            vPortYieldFromISR(x)
+#define portYIELD_FROM_ISR(x)               vPortYieldFromISR(x)
+#define portDISABLE_INTERRUPTS()            vPortDisableInterrupts()
+#define portENABLE_INTERRUPTS()             vPortEnableInterrupts()
+#define portENTER_CRITICAL()                vPortEnterCritical()
+#define portEXIT_CRITICAL()                 vPortExitCritical()
+#define portSET_INTERRUPT_MASK_FROM_ISR()   uxPortSetInterruptMask()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x) vPortClearInterruptMask(x)
+
+/* A deleted task's thread is stopped before its stack is freed */
+#define portCLEAN_UP_TCB(pxTCB)             vPortCancelThread(pxTCB)
+
+#define portTASK_FUNCTION_PROTO(vFunction, pvParameters) void vFunction(void *pvParameters)
+#define portTASK_FUNCTION(vFunction, pvParameters)       void vFunction(void *pvParameters)
+
+/* Simulated interrupts. handler runs on the thread of the running task, in
+   interrupt context, as soon as interrupts are enabled; at once when pended
+   by a task with interrupts enabled. Pending an already pending handler has
+   no effect, like an NVIC pending bit. Safe from any host thread. */
+void vPortPendInterrupt(void (*handler)(void));
+
+/* Ticks raised by the idle task instead of a 1 ms host timer, simulated
+   time only advances when every task is blocked. Before the scheduler. */
+void vPortSetVirtualTime(void);
+
+/* Host clock in ns since the scheduler started */
+uint64_t ullPortGetTimeNs(void);
+
+/* Highest ready priority from a 32-bit bitmap, as the ARM_CM4F port does
+   with CLZ */
+#if (configUSE_PORT_OPTIMISED_TASK_SELECTION == 1)
+#if (configMAX_PRIORITIES > 32)
+#error "configMAX_PRIORITIES must be 32 or less with the port optimised task selection"
+#endif
+#define portRECORD_READY_PRIORITY(uxPriority, uxReadyPriorities) \
+    (uxReadyPriorities) |= (1UL << (uxPriority))
+#define portRESET_READY_PRIORITY(uxPriority, uxReadyPriorities) \
+    (uxReadyPriorities) &= ~(1UL << (uxPriority))
+#define portGET_HIGHEST_PRIORITY(uxTopPriority, uxReadyPriorities) \
+    uxTopPriority = (31UL - (UBaseType_t)__builtin_clz((uint32_t)(uxReadyPriorities)))
+#endif
+
+#endif /* PORTMACRO_H */
@@ -0,0 +1,834 @@
+/*
+ * Host simulation of Application/Src/Gsm.c against a scripted SIM800.
+ *
+ * Gsm.c is built unchanged against stub HAL/FreeRTOS headers. The GSM task
+ * loop is run the way the scheduler would: when modem output arrives, when
+ * Gsm_Submit() notifies it or when Gsm_Wait() expires. The modem model answers command lines from the rules
+ * of the script (chained "AT+A;+B" lines included), shows the SMS prompt,
+ * echoes until ATE0, and can restart, go mute or lose lines. The workload
+ * of the script submits commands periodically, like the firmware tasks do.
+ *
+ * Script lines (see modem.txt):
+ *     rule   <AT cmd> <delay ms> <reply>|<reply>...    last reply is the final result
+ *     prompt <AT cmd> <delay ms> <after payload ms> <reply>|...
+ *     every  <period ms> <CTRL|STAT|SMS|GPRS> <chain|single> <timeout ms> <AT cmd> [<prefix>|-]
+ *     sms    <period ms> <timeout ms> <AT cmd> <text>
+ *     urc    <at ms> <line>
+ *     reset  <at ms> <silent ms>
+ *     mute   <from ms> <to ms>
+ *
+ *     -f <script>    modem script (default modem.txt)
+ *     -t <s>         simulated time (default 300)
+ *     -l <percent>   command lines the modem loses (default 0)
+ *     -j <percent>   +/- jitter on every rule delay (default 20)
+ *     -n             no chaining, every command on its own line
+ *     -s <seed>      loss/jitter seed (default 1)
+ *     -v             print the traffic
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+
+#include "Gsm.c"
+
+#define SIM_RULES_MAX       32
+#define SIM_REPLIES_MAX     6
+#define SIM_TEXT_MAX        96
+#define SIM_EVENTS_MAX      32
+#define SIM_LOADS_MAX       16
+#define SIM_OUT_MAX         256
+#define SIM_PENDING_MAX     64
+#define SIM_SAMPLES_MAX     20000
+#define SIM_BAUD            115200
+
+typedef struct
+{
+    char key[GSM_CMD_TEXT_MAX];     /* Command after "AT", prefix match */
+    int prompt;
+    uint32_t delay_ms;
+    uint32_t payload_ms;
+    int count;
+    char reply[SIM_REPLIES_MAX][SIM_TEXT_MAX];
+} SimRule_t;
+
+typedef struct
+{
+    char kind;                      /* 'u' urc, 'r' reset, 'm' mute */
+    uint32_t at;
+    uint32_t length;                /* Silent / mute time */
+    char text[SIM_TEXT_MAX];
+} SimEvent_t;
+
+typedef struct
+{
+    uint32_t period;
+    uint32_t next;
+    GsmCommand_t command;
+    char prefix[24];
+    char payload[161];
+} SimLoad_t;
+
+typedef struct
+{
+    uint32_t at;
+    char text[2 * SIM_TEXT_MAX];
+} SimOut_t;
+
+typedef struct
+{
+    int used;
+    uint8_t type;
+    int wants_info;
+    uint32_t submitted;
+} SimPending_t;
+
+typedef struct
+{
+    uint32_t submitted;
+    uint32_t rejected;
+    uint32_t status[GSM_RESET + 1];
+    uint32_t no_info;               /* OK without the line its prefix asked for */
+    uint64_t e2e_total;
+    uint32_t e2e_max;
+    uint32_t samples;
+    uint32_t latency[SIM_SAMPLES_MAX];
+} SimTypeStats_t;
+
+UART_HandleTypeDef huart3;
+
+static uint32_t sim_now;
+static int sim_verbose;
+static int sim_loss_pct;
+static int sim_jitter_pct = 20;
+
+static SimRule_t sim_rules[SIM_RULES_MAX];
+static int sim_rule_count;
+static SimEvent_t sim_events[SIM_EVENTS_MAX];
+static int sim_event_count;
+static SimLoad_t sim_loads[SIM_LOADS_MAX];
+static int sim_load_count;
+
+static SimOut_t sim_out[SIM_OUT_MAX];
+static int sim_out_count;
+static uint32_t sim_out_last;       /* Modem output stays in order */
+
+static SimPending_t sim_pending[SIM_PENDING_MAX];
+static SimTypeStats_t sim_stats[GSM_TYPE_COUNT];
+static uint32_t sim_urcs_seen;
+
+/* Modem state */
+static int modem_echo = 1;
+static uint32_t modem_deaf_until;
+static const SimRule_t *modem_payload_rule;
+static char modem_line[GSM_LINE_MAX];
+static uint32_t modem_line_len;
+
+/* GSM task notification value, see Gsm_Handler */
+static int sim_task;
+static uint32_t sim_notified;
+
+TickType_t xTaskGetTickCount(void)
+{
+    return sim_now;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    (void)ticks;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return &sim_task;
+}
+
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action)
+{
+    (void)task;
+    if (action == eSetBits)
+    {
+        sim_notified |= value;
+    }
+    return pdPASS;
+}
+
+BaseType_t xTaskNotifyWait(uint32_t clear_on_entry, uint32_t clear_on_exit, uint32_t *value, TickType_t wait)
+{
+    (void)clear_on_entry; (void)clear_on_exit; (void)value; (void)wait;
+    return pdFALSE;
+}
+
+void UartRx_SetNotify(UartRxPort_t port, TaskHandle_t task, uint32_t bits)
+{
+    (void)port; (void)task; (void)bits;
+}
+
+size_t UartRx_Read(UartRxPort_t port, uint8_t *data, size_t length, TickType_t timeout)
+{
+    (void)port; (void)data; (void)length; (void)timeout;
+    return 0;
+}
+
+void UartRx_Flush(UartRxPort_t port)
+{
+    (void)port;
+}
+
+static uint32_t sim_jitter(uint32_t ms)
+{
+    if ((sim_jitter_pct == 0) || (ms == 0))
+    {
+        return ms;
+    }
+    long delta = ((long)ms * ((rand() % (2 * sim_jitter_pct + 1)) - sim_jitter_pct)) / 100;
+    return (uint32_t)((long)ms + delta);
+}
+
+/* Answers come out in the order the commands went in, URCs whenever due */
+static void sim_emit_at(uint32_t at, const char *text)
+{
+    if (sim_out_count == SIM_OUT_MAX)
+    {
+        fprintf(stderr, "modem output queue full\n");
+        exit(2);
+    }
+    sim_out[sim_out_count].at = at;
+    snprintf(sim_out[sim_out_count].text, sizeof(sim_out[0].text), "%s", text);
+    sim_out_count++;
+}
+
+static void sim_emit(uint32_t delay_ms, const char *text)
+{
+    uint32_t at = sim_now + delay_ms;
+
+    if (at < sim_out_last)
+    {
+        at = sim_out_last;
+    }
+    sim_out_last = at;
+    sim_emit_at(at, text);
+}
+
+static int sim_is_error(const char *reply)
+{
+    return (strcmp(reply, "ERROR") == 0) || (strncmp(reply, "+CME ERROR", 10) == 0) ||
+           (strncmp(reply, "+CMS ERROR", 10) == 0);
+}
+
+static const SimRule_t *sim_find_rule(const char *command)
+{
+    const SimRule_t *best = NULL;
+
+    for (int i = 0; i < sim_rule_count; i++)
+    {
+        size_t len = strlen(sim_rules[i].key);
+
+        if ((len == 0) ? (command[0] == '\0') : (strncasecmp(command, sim_rules[i].key, len) == 0))
+        {
+            if ((best == NULL) || (len > strlen(best->key)))
+            {
+                best = &sim_rules[i];
+            }
+        }
+    }
+    return best;
+}
+
+/* Info lines of a rule, the final result only if it is an error */
+static int sim_append_replies(const SimRule_t *rule, char *out, size_t size)
+{
+    for (int i = 0; i < rule->count - 1; i++)
+    {
+        snprintf(out + strlen(out), size - strlen(out), "\r\n%s\r\n", rule->reply[i]);
+    }
+    if (sim_is_error(rule->reply[rule->count - 1]))
+    {
+        snprintf(out + strlen(out), size - strlen(out), "\r\n%s\r\n", rule->reply[rule->count - 1]);
+        return 0;
+    }
+    return 1;
+}
+
+static void sim_modem_command_line(char *line, uint32_t line_ms)
+{
+    char out[2 * SIM_TEXT_MAX] = "";
+    uint32_t delay = line_ms;
+    char *save = NULL;
+
+    if ((sim_now < modem_deaf_until) || ((rand() % 100) < sim_loss_pct))
+    {
+        if (sim_verbose)
+        {
+            printf("%9.3f  modem lost  %s\n", sim_now / 1000.0, line);
+        }
+        return;
+    }
+    if (modem_echo)
+    {
+        snprintf(out, sizeof(out), "%s\r\n", line);
+        sim_emit(line_ms, out);
+        out[0] = '\0';
+    }
+    if (strncasecmp(line, "AT", 2) != 0)
+    {
+        return;
+    }
+
+    char *part = strtok_r(line + 2, ";", &save);
+    if (part == NULL)
+    {
+        part = "";
+    }
+    for (; part != NULL; part = strtok_r(NULL, ";", &save))
+    {
+        const SimRule_t *rule = sim_find_rule(part);
+
+        if (rule == NULL)
+        {
+            strcat(out, "\r\nERROR\r\n");
+            sim_emit(delay, out);
+            return;
+        }
+        delay += sim_jitter(rule->delay_ms);
+        if (strcasecmp(part, "E0") == 0)
+        {
+            modem_echo = 0;
+        }
+        else if (strcasecmp(part, "E1") == 0)
+        {
+            modem_echo = 1;
+        }
+
+        if (rule->prompt)
+        {
+            strcat(out, "\r\n> ");
+            sim_emit(delay, out);
+            modem_payload_rule = rule;
+            return;
+        }
+        if (!sim_append_replies(rule, out, sizeof(out)))
+        {
+            sim_emit(delay, out);
+            return;
+        }
+    }
+
+    strcat(out, "\r\nOK\r\n");
+    sim_emit(delay, out);
+}
+
+static void sim_modem_byte(uint8_t c, uint32_t line_ms)
+{
+    if (modem_payload_rule != NULL)
+    {
+        if (c == GSM_CTRL_Z)
+        {
+            char out[2 * SIM_TEXT_MAX] = "";
+
+            if (!sim_append_replies(modem_payload_rule, out, sizeof(out)))
+            {
+                sim_emit(sim_jitter(modem_payload_rule->payload_ms), out);
+            }
+            else
+            {
+                snprintf(out + strlen(out), sizeof(out) - strlen(out), "\r\nOK\r\n");
+                sim_emit(line_ms + sim_jitter(modem_payload_rule->payload_ms), out);
+            }
+            modem_payload_rule = NULL;
+        }
+        else if (c == GSM_ESC)
+        {
+            modem_payload_rule = NULL;
+        }
+        return;
+    }
+
+    if (c == '\r')
+    {
+        modem_line[modem_line_len] = '\0';
+        sim_modem_command_line(modem_line, line_ms);
+        modem_line_len = 0;
+    }
+    else if ((c != '\n') && (modem_line_len < sizeof(modem_line) - 1))
+    {
+        modem_line[modem_line_len++] = (char)c;
+    }
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+    uint32_t line_ms = (uint32_t)(((uint64_t)Size * 10U * 1000U + SIM_BAUD - 1) / SIM_BAUD);
+
+    (void)huart;
+    if (sim_verbose && (Size > 0) && (pData[Size - 1] == '\r'))
+    {
+        printf("%9.3f  -> %.*s\n", sim_now / 1000.0, (int)Size - 1, (char *)pData);
+    }
+    else if (sim_verbose)
+    {
+        printf("%9.3f  -> (%u bytes)\n", sim_now / 1000.0, Size);
+    }
+    for (uint16_t i = 0; i < Size; i++)
+    {
+        sim_modem_byte(pData[i], line_ms);
+    }
+
+    /* The bytes are out before the modem answers, no need to model the ISR */
+    Gsm_TxComplete_FromISR();
+    return HAL_OK;
+}
+
+static void sim_done(const GsmResult_t *result, void *context)
+{
+    SimPending_t *pending = context;
+    SimTypeStats_t *stats = &sim_stats[pending->type];
+    uint32_t e2e = sim_now - pending->submitted;
+
+    stats->status[result->status]++;
+    stats->e2e_total += e2e;
+    if (e2e > stats->e2e_max)
+    {
+        stats->e2e_max = e2e;
+    }
+    if (((result->status == GSM_OK) || (result->status == GSM_ERROR)) &&
+        (stats->samples < SIM_SAMPLES_MAX))
+    {
+        stats->latency[stats->samples++] = result->latency_ms;
+    }
+    if ((result->status == GSM_OK) && pending->wants_info && (result->argc < 2))
+    {
+        stats->no_info++;
+    }
+    if (sim_verbose)
+    {
+        printf("%9.3f  done %-4s status %d argc %u latency %lu ms%s%s\n", sim_now / 1000.0,
+               Gsm_TypeName((GsmType_t)pending->type), result->status, result->argc,
+               (unsigned long)result->latency_ms, result->argc ? " first field " : "",
+               result->argc ? result->argv[0] : "");
+    }
+    pending->used = 0;
+}
+
+static void sim_urc(uint8_t argc, const char *const *argv, void *context)
+{
+    (void)context;
+    sim_urcs_seen++;
+    if (sim_verbose)
+    {
+        printf("%9.3f  URC %s (%u fields)\n", sim_now / 1000.0, argv[0], argc);
+    }
+}
+
+static void sim_submit(SimLoad_t *load)
+{
+    SimTypeStats_t *stats = &sim_stats[load->command.type];
+    SimPending_t *pending = NULL;
+
+    for (int i = 0; i < SIM_PENDING_MAX; i++)
+    {
+        if (!sim_pending[i].used)
+        {
+            pending = &sim_pending[i];
+            break;
+        }
+    }
+
+    stats->submitted++;
+    if (pending == NULL)
+    {
+        stats->rejected++;
+        return;
+    }
+
+    pending->used = 1;
+    pending->type = load->command.type;
+    pending->wants_info = (load->command.prefix != NULL) && (load->command.prefix[0] != '\0');
+    pending->submitted = sim_now;
+    load->command.context = pending;
+
+    if (!Gsm_Submit(&load->command, 0))
+    {
+        stats->rejected++;
+        pending->used = 0;
+    }
+}
+
+static int sim_type(const char *name)
+{
+    for (int i = 0; i < GSM_TYPE_COUNT; i++)
+    {
+        if (strcasecmp(name, Gsm_TypeName((GsmType_t)i)) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static const char *sim_at_key(const char *command)
+{
+    return (strncasecmp(command, "AT", 2) == 0) ? command + 2 : command;
+}
+
+static void sim_split_replies(SimRule_t *rule, char *text)
+{
+    char *save = NULL;
+
+    for (char *r = strtok_r(text, "|", &save); r && rule->count < SIM_REPLIES_MAX; r = strtok_r(NULL, "|", &save))
+    {
+        while (*r == ' ')
+        {
+            r++;
+        }
+        snprintf(rule->reply[rule->count++], SIM_TEXT_MAX, "%s", r);
+    }
+}
+
+static int sim_load_script(const char *path, int no_chain)
+{
+    FILE *file = fopen(path, "r");
+    char line[256];
+    int number = 0;
+
+    if (file == NULL)
+    {
+        perror(path);
+        return 0;
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        char word[16], command[GSM_CMD_TEXT_MAX + 2], extra[24], rest[200];
+        unsigned a, b, c;
+        int n = 0;
+
+        number++;
+        line[strcspn(line, "\r\n")] = '\0';
+        if ((sscanf(line, "%15s", word) != 1) || (word[0] == '#'))
+        {
+            continue;
+        }
+
+        if ((strcmp(word, "rule") == 0) && (sim_rule_count < SIM_RULES_MAX) &&
+            (sscanf(line, "rule %49s %u %n", command, &a, &n) == 2) && n)
+        {
+            SimRule_t *rule = &sim_rules[sim_rule_count++];
+            snprintf(rule->key, sizeof(rule->key), "%s", sim_at_key(command));
+            rule->delay_ms = a;
+            sim_split_replies(rule, line + n);
+        }
+        else if ((strcmp(word, "prompt") == 0) && (sim_rule_count < SIM_RULES_MAX) &&
+                 (sscanf(line, "prompt %49s %u %u %n", command, &a, &b, &n) == 3) && n)
+        {
+            SimRule_t *rule = &sim_rules[sim_rule_count++];
+            snprintf(rule->key, sizeof(rule->key), "%s", sim_at_key(command));
+            rule->prompt = 1;
+            rule->delay_ms = a;
+            rule->payload_ms = b;
+            sim_split_replies(rule, line + n);
+        }
+        else if ((strcmp(word, "every") == 0) && (sim_load_count < SIM_LOADS_MAX))
+        {
+            char type[8], mode[8];
+            SimLoad_t *load = &sim_loads[sim_load_count];
+            int fields = sscanf(line, "every %u %7s %7s %u %49s %23s", &a, type, mode, &c, command, extra);
+
+            if ((fields < 5) || (sim_type(type) < 0))
+            {
+                fprintf(stderr, "%s:%d: bad every line\n", path, number);
+                fclose(file);
+                return 0;
+            }
+            sim_load_count++;
+            load->period = a;
+            load->next = a;
+            load->command.type = (uint8_t)sim_type(type);
+            load->command.flags = ((strcmp(mode, "chain") == 0) && !no_chain) ? GSM_FLAG_CHAIN : 0;
+            load->command.timeout_ms = c;
+            load->command.done = sim_done;
+            snprintf(load->command.text, sizeof(load->command.text), "%s", sim_at_key(command));
+            if ((fields == 6) && (strcmp(extra, "-") != 0))
+            {
+                snprintf(load->prefix, sizeof(load->prefix), "%s", extra);
+                load->command.prefix = load->prefix;
+            }
+        }
+        else if ((strcmp(word, "sms") == 0) && (sim_load_count < SIM_LOADS_MAX) &&
+                 (sscanf(line, "sms %u %u %49s %n", &a, &c, command, &n) == 3) && n)
+        {
+            SimLoad_t *load = &sim_loads[sim_load_count++];
+
+            load->period = a;
+            load->next = a;
+            load->command.type = GSM_TYPE_SMS;
+            load->command.flags = GSM_FLAG_CTRL_Z;
+            load->command.timeout_ms = c;
+            load->command.done = sim_done;
+            snprintf(load->command.text, sizeof(load->command.text), "%s", sim_at_key(command));
+            snprintf(load->payload, sizeof(load->payload), "%s", line + n);
+            load->command.prefix = "+CMGS:";
+            load->command.payload = (const uint8_t *)load->payload;
+            load->command.payload_len = (uint16_t)strlen(load->payload);
+        }
+        else if ((strcmp(word, "urc") == 0) && (sim_event_count < SIM_EVENTS_MAX) &&
+                 (sscanf(line, "urc %u %n", &a, &n) == 1) && n)
+        {
+            SimEvent_t *event = &sim_events[sim_event_count++];
+            event->kind = 'u';
+            event->at = a;
+            snprintf(event->text, sizeof(event->text), "%s", line + n);
+        }
+        else if ((strcmp(word, "reset") == 0) && (sim_event_count < SIM_EVENTS_MAX) &&
+                 (sscanf(line, "reset %u %u", &a, &b) == 2))
+        {
+            sim_events[sim_event_count++] = (SimEvent_t){ .kind = 'r', .at = a, .length = b };
+        }
+        else if ((strcmp(word, "mute") == 0) && (sim_event_count < SIM_EVENTS_MAX) &&
+                 (sscanf(line, "mute %u %u", &a, &b) == 2) && (b > a))
+        {
+            sim_events[sim_event_count++] = (SimEvent_t){ .kind = 'm', .at = a, .length = b - a };
+        }
+        else
+        {
+            fprintf(stderr, "%s:%d: cannot parse \"%s\"\n", path, number, line);
+            fclose(file);
+            return 0;
+        }
+        (void)rest;
+    }
+
+    fclose(file);
+    return 1;
+}
+
+static void sim_event(const SimEvent_t *event)
+{
+    char text[2 * SIM_TEXT_MAX];
+
+    switch (event->kind)
+    {
+    case 'u':
+        snprintf(text, sizeof(text), "\r\n%s\r\n", event->text);
+        sim_emit_at(sim_now, text);
+        break;
+
+    case 'r':
+        /* Brown-out: pending answers are lost, the modem boots with echo on */
+        sim_out_count = 0;
+        sim_out_last = sim_now;
+        modem_payload_rule = NULL;
+        modem_line_len = 0;
+        modem_echo = 1;
+        modem_deaf_until = sim_now + event->length;
+        sim_emit(event->length, "\r\nRDY\r\n");
+        sim_emit_at(sim_now + event->length + 2000, "\r\nCall Ready\r\n\r\nSMS Ready\r\n");
+        break;
+
+    case 'm':
+        modem_deaf_until = sim_now + event->length;
+        break;
+    }
+    if (sim_verbose)
+    {
+        printf("%9.3f  event %c %s\n", sim_now / 1000.0, event->kind, event->text);
+    }
+}
+
+static void sim_print_rx(const char *text)
+{
+    char line[2 * SIM_TEXT_MAX];
+    size_t len = 0;
+
+    for (; *text != '\0'; text++)
+    {
+        if ((*text != '\r') && (*text != '\n'))
+        {
+            line[len++] = *text;
+        }
+        else if (len > 0)
+        {
+            line[len] = '\0';
+            printf("%9.3f  <- %s\n", sim_now / 1000.0, line);
+            len = 0;
+        }
+    }
+    if (len > 0)
+    {
+        line[len] = '\0';
+        printf("%9.3f  <- %s\n", sim_now / 1000.0, line);
+    }
+}
+
+static int sim_compare(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char **argv)
+{
+    const char *script = "modem.txt";
+    double seconds = 300.0;
+    unsigned seed = 1;
+    int no_chain = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "f:t:l:j:ns:v")) != -1)
+    {
+        switch (opt)
+        {
+        case 'f': script = optarg; break;
+        case 't': seconds = atof(optarg); break;
+        case 'l': sim_loss_pct = atoi(optarg); break;
+        case 'j': sim_jitter_pct = atoi(optarg); break;
+        case 'n': no_chain = 1; break;
+        case 's': seed = (unsigned)strtoul(optarg, NULL, 0); break;
+        case 'v': sim_verbose = 1; break;
+        default:
+            fprintf(stderr, "usage: %s [-f script] [-t s] [-l loss%%] [-j jitter%%] [-n] [-s seed] [-v]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+
+    srand(seed);
+    if (!sim_load_script(script, no_chain) || !Gsm_Init() ||
+        !Gsm_Subscribe("+CMTI:", sim_urc, NULL))
+    {
+        return 1;
+    }
+    /* As Gsm_Handler does, Gsm_Submit notifies the task from here on */
+    gsm_task = xTaskGetCurrentTaskHandle();
+
+    uint32_t end = (uint32_t)(seconds * 1000.0);
+    uint32_t wake_at = 0;
+
+    for (sim_now = 0; sim_now < end; sim_now++)
+    {
+        for (int i = 0; i < sim_event_count; i++)
+        {
+            if (sim_events[i].at == sim_now)
+            {
+                sim_event(&sim_events[i]);
+            }
+        }
+        for (int i = 0; i < sim_load_count; i++)
+        {
+            if (sim_loads[i].next == sim_now)
+            {
+                sim_submit(&sim_loads[i]);
+                sim_loads[i].next += sim_loads[i].period;
+            }
+        }
+
+        /* Modem output due now, in the order it was produced */
+        uint8_t rx[SIM_OUT_MAX * 2 * SIM_TEXT_MAX];
+        size_t rx_len = 0;
+        int kept = 0;
+
+        for (int i = 0; i < sim_out_count; i++)
+        {
+            if (sim_out[i].at <= sim_now)
+            {
+                size_t len = strlen(sim_out[i].text);
+                memcpy(&rx[rx_len], sim_out[i].text, len);
+                rx_len += len;
+                if (sim_verbose)
+                {
+                    sim_print_rx(sim_out[i].text);
+                }
+            }
+            else
+            {
+                sim_out[kept++] = sim_out[i];
+            }
+        }
+        sim_out_count = kept;
+
+        /* The task wakes for received bytes, a submit or when its wait runs out */
+        if ((rx_len > 0) || (sim_notified != 0) || (sim_now >= wake_at))
+        {
+            sim_notified = 0;
+            Gsm_Feed(rx, rx_len);
+            Gsm_Service();
+
+            TickType_t wait = Gsm_Wait();
+            wake_at = (wait == portMAX_DELAY) ? UINT32_MAX : (sim_now + wait);
+        }
+    }
+
+    GsmStats_t engine;
+    int failed = 0;
+
+    Gsm_GetStats(&engine);
+    printf("%.0f s, %s, loss %d %%, jitter %d %%, script %s\n", seconds,
+           no_chain ? "no chaining" : "chaining", sim_loss_pct, sim_jitter_pct, script);
+    printf("%-5s %6s %6s %6s %6s %6s %6s %7s %7s %7s %8s %8s\n", "type", "sent", "reject", "ok",
+           "error", "tmout", "reset", "avg_ms", "p99_ms", "max_ms", "e2e_avg", "e2e_max");
+
+    for (int t = 0; t < GSM_TYPE_COUNT; t++)
+    {
+        SimTypeStats_t *stats = &sim_stats[t];
+        const GsmLatency_t *latency = &engine.type[t];
+        uint32_t done = stats->status[GSM_OK] + stats->status[GSM_ERROR] +
+                        stats->status[GSM_TIMEOUT] + stats->status[GSM_RESET];
+        char p99[12] = "-";
+
+        if (stats->submitted == 0 && latency->count == 0)
+        {
+            continue;
+        }
+        if (stats->samples > 0)
+        {
+            qsort(stats->latency, stats->samples, sizeof(stats->latency[0]), sim_compare);
+            snprintf(p99, sizeof(p99), "%lu",
+                     (unsigned long)stats->latency[(stats->samples * 99U) / 100U]);
+        }
+
+        /* Start-up commands are the engine's own, CTRL only has its latency */
+        printf("%-5s %6lu %6lu %6lu %6lu %6lu %6lu %7lu %7s %7lu %8.1f %8lu\n",
+               Gsm_TypeName((GsmType_t)t), (unsigned long)stats->submitted,
+               (unsigned long)stats->rejected, (unsigned long)stats->status[GSM_OK],
+               (unsigned long)stats->status[GSM_ERROR], (unsigned long)stats->status[GSM_TIMEOUT],
+               (unsigned long)stats->status[GSM_RESET], (unsigned long)latency->avg_ms,
+               p99, (unsigned long)latency->max_ms,
+               done ? (double)stats->e2e_total / done : 0.0, (unsigned long)stats->e2e_max);
+
+        if (stats->no_info > 0)
+        {
+            printf("      %lu OK results without their information line\n", (unsigned long)stats->no_info);
+            failed = 1;
+        }
+        if (stats->submitted - stats->rejected < done)
+        {
+            printf("      more results than commands\n");
+            failed = 1;
+        }
+    }
+
+    uint32_t in_flight = 0;
+    for (int i = 0; i < SIM_PENDING_MAX; i++)
+    {
+        in_flight += (uint32_t)sim_pending[i].used;
+    }
+
+    printf("engine: %lu commands on %lu lines (%.2f per line), %lu URCs (%lu subscribed), "
+           "%lu resets, %lu overflows, %s, %lu still queued\n",
+           (unsigned long)engine.commands, (unsigned long)engine.lines,
+           engine.lines ? (double)engine.commands / engine.lines : 0.0,
+           (unsigned long)engine.urcs, (unsigned long)sim_urcs_seen, (unsigned long)engine.resets,
+           (unsigned long)engine.overflows, Gsm_IsReady() ? "ready" : "not ready",
+           (unsigned long)in_flight);
+
+    /* Every command comes back exactly once, bar the ones still queued */
+    if (in_flight > GSM_QUEUE_LEN + GSM_CHAIN_MAX)
+    {
+        printf("%lu commands never completed\n", (unsigned long)in_flight);
+        failed = 1;
+    }
+
+    return failed;
+}
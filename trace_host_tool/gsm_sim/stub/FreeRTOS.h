@@ -0,0 +1,23 @@
+/*
+ * Minimal FreeRTOS.h for building Gsm.c on a host.
+ * Single threaded, the simulation runs the GSM task loop itself, 1 tick = 1 ms.
+ */
+#ifndef GSM_SIM_FREERTOS_H
+#define GSM_SIM_FREERTOS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE                 ((BaseType_t)0)
+#define pdTRUE                  ((BaseType_t)1)
+#define pdPASS                  pdTRUE
+#define portMAX_DELAY           ((TickType_t)0xFFFFFFFFUL)
+#define portTICK_PERIOD_MS      ((TickType_t)1)
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(ms))
+#define portYIELD_FROM_ISR(x)   ((void)(x))
+
+#endif
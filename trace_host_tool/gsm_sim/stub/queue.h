@@ -0,0 +1,73 @@
+/*
+ * Host stand-in for a static FreeRTOS queue: a ring of fixed size items.
+ * Nothing blocks, a full queue fails at once whatever the wait.
+ */
+#ifndef GSM_SIM_QUEUE_H
+#define GSM_SIM_QUEUE_H
+
+#include <string.h>
+#include "FreeRTOS.h"
+
+typedef struct
+{
+    uint8_t *storage;
+    UBaseType_t length;
+    UBaseType_t item_size;
+    UBaseType_t head;
+    UBaseType_t count;
+} StaticQueue_t;
+
+typedef StaticQueue_t *QueueHandle_t;
+
+static inline QueueHandle_t xQueueCreateStatic(UBaseType_t length, UBaseType_t item_size,
+                                               uint8_t *storage, StaticQueue_t *queue)
+{
+    queue->storage = storage;
+    queue->length = length;
+    queue->item_size = item_size;
+    queue->head = 0;
+    queue->count = 0;
+    return queue;
+}
+
+static inline BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t wait)
+{
+    (void)wait;
+    if (queue->count == queue->length)
+    {
+        return pdFALSE;
+    }
+    memcpy(&queue->storage[((queue->head + queue->count) % queue->length) * queue->item_size],
+           item, queue->item_size);
+    queue->count++;
+    return pdTRUE;
+}
+
+static inline BaseType_t xQueuePeek(QueueHandle_t queue, void *item, TickType_t wait)
+{
+    (void)wait;
+    if (queue->count == 0)
+    {
+        return pdFALSE;
+    }
+    memcpy(item, &queue->storage[queue->head * queue->item_size], queue->item_size);
+    return pdTRUE;
+}
+
+static inline BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t wait)
+{
+    if (!xQueuePeek(queue, item, wait))
+    {
+        return pdFALSE;
+    }
+    queue->head = (queue->head + 1) % queue->length;
+    queue->count--;
+    return pdTRUE;
+}
+
+static inline UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+    return queue->count;
+}
+
+#endif
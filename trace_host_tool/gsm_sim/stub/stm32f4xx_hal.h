@@ -0,0 +1,25 @@
+/*
+ * Host stand-in for the parts of the STM32F4 HAL that Gsm.c touches.
+ * HAL_UART_Transmit_IT is implemented by the simulation (the modem model).
+ */
+#ifndef GSM_SIM_STM32F4XX_HAL_H
+#define GSM_SIM_STM32F4XX_HAL_H
+
+#include <stdint.h>
+
+typedef enum
+{
+    HAL_OK = 0,
+    HAL_ERROR,
+    HAL_BUSY,
+    HAL_TIMEOUT
+} HAL_StatusTypeDef;
+
+typedef struct
+{
+    uint32_t unused;
+} UART_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+
+#endif
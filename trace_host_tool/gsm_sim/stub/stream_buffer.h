@@ -0,0 +1,7 @@
+/* UartRx.h includes it, the modem simulation feeds Gsm.c directly */
+#ifndef GSM_SIM_STREAM_BUFFER_H
+#define GSM_SIM_STREAM_BUFFER_H
+
+#include "FreeRTOS.h"
+
+#endif
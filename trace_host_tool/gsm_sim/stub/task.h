@@ -0,0 +1,24 @@
+/* Minimal task.h for the host modem simulation, time is owned by gsm_sim.c */
+#ifndef GSM_SIM_TASK_H
+#define GSM_SIM_TASK_H
+
+#include "FreeRTOS.h"
+
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+typedef void *TaskHandle_t;
+
+typedef enum
+{
+    eNoAction = 0,
+    eSetBits
+} eNotifyAction;
+
+TickType_t xTaskGetTickCount(void);
+void vTaskDelay(TickType_t ticks);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action);
+BaseType_t xTaskNotifyWait(uint32_t clear_on_entry, uint32_t clear_on_exit, uint32_t *value, TickType_t wait);
+
+#endif
@@ -0,0 +1,26 @@
+/*
+ * Stock FreeRTOS heap_4 for the heap benchmark, entry points renamed to
+ * h4_*. It has its own translation unit so its static names stay apart
+ * from the benchmark.
+ */
+#define pvPortMalloc                    h4_malloc
+#define vPortFree                       h4_free
+#define xPortGetFreeHeapSize            h4_free_size
+#define xPortGetMinimumEverFreeHeapSize h4_min_free_size
+#define vPortInitialiseBlocks           h4_init_blocks
+#define vPortGetHeapStats               h4_heap_stats
+#include "heap_4.c"
+
+/* Blocks on the address ordered free list, the length of the walk a
+   malloc or free may need */
+size_t h4_free_blocks(void)
+{
+    size_t count = 0;
+
+    for (BlockLink_t *block = xStart.pxNextFreeBlock; (block != NULL) && (block != pxEnd);
+         block = block->pxNextFreeBlock)
+    {
+        count++;
+    }
+    return count;
+}
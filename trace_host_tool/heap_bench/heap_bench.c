@@ -0,0 +1,331 @@
+/*
+ * Host benchmark: replays one allocation trace against stock FreeRTOS heap_4
+ * and Application/Src/Heap.c (TLSF), and
+ * reports the latency of every pvPortMalloc/vPortFree call, the failed
+ * allocations and the minimum free heap.
+ *
+ * Trace format, one operation per line:
+ *     a <id> <size>      allocate size bytes and remember the block as id
+ *     f <id>             free block id
+ * Without a trace file a synthetic one is generated (see heap_bench_generate).
+ *
+ *     -n <ops>       synthetic trace length (default 1000000)
+ *     -l <blocks>    synthetic trace live blocks at most (default 64)
+ *     -s <seed>      synthetic trace seed (default 1)
+ *     -r <n>         replays per heap, the lowest latency figures are kept
+ *                    to filter out host preemption (default 5)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "FreeRTOS.h"
+#include "Heap.h"
+
+/* Stock heap_4, renamed, see heap4.c */
+void *h4_malloc(size_t size);
+void h4_free(void *pv);
+size_t h4_min_free_size(void);
+size_t h4_free_blocks(void);
+
+#define MAX_IDS     4096
+#define MAX_OPS     2000000
+
+typedef struct
+{
+    char op;
+    unsigned id;
+    size_t size;
+} Op_t;
+
+typedef struct
+{
+    const char *name;
+    void *(*alloc)(size_t);
+    void (*release)(void *);
+    size_t (*min_free)(void);
+    size_t (*free_blocks)(void);    /* List a call may walk, NULL if none */
+} Heap_t;
+
+static Op_t ops[MAX_OPS];
+static size_t op_count;
+static double samples[MAX_OPS];
+
+/* TSC cycles where there is one, else ns; the timer cost is taken off
+   every sample */
+static double now_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return (double)__rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+#endif
+}
+
+static double timer_overhead;
+
+static void heap_bench_calibrate(void)
+{
+    timer_overhead = 1e30;
+    for (int i = 0; i < 100000; i++)
+    {
+        double t0 = now_cycles();
+        double t1 = now_cycles();
+        if ((t1 - t0) < timer_overhead)
+        {
+            timer_overhead = t1 - t0;
+        }
+    }
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* Long running mix of small message sized blocks and a few large buffers,
+   with random lifetimes so heap_4 fragments over time */
+static void heap_bench_generate(size_t count, unsigned max_live, unsigned seed)
+{
+    static int live[MAX_IDS];
+    unsigned live_count = 0;
+
+    srand(seed);
+    while (op_count < count)
+    {
+        unsigned id = (unsigned)rand() % MAX_IDS;
+
+        if (live[id])
+        {
+            ops[op_count++] = (Op_t){ 'f', id, 0 };
+            live[id] = 0;
+            live_count--;
+        }
+        else if (live_count < max_live)
+        {
+            int r = rand() % 100;
+            size_t size = (r < 70) ? (size_t)(8 + rand() % 56) :
+                          (r < 95) ? (size_t)(64 + rand() % 192) :
+                                     (size_t)(256 + rand() % 768);
+            ops[op_count++] = (Op_t){ 'a', id, size };
+            live[id] = 1;
+            live_count++;
+        }
+    }
+}
+
+static int heap_bench_load(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char line[64];
+
+    if (f == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+    while ((op_count < MAX_OPS) && fgets(line, sizeof(line), f))
+    {
+        Op_t op = { 0 };
+        unsigned long size = 0;
+
+        if (sscanf(line, " %c %u %lu", &op.op, &op.id, &size) < 2 || op.id >= MAX_IDS)
+        {
+            continue;
+        }
+        op.size = size;
+        ops[op_count++] = op;
+    }
+    fclose(f);
+    return 0;
+}
+
+typedef struct
+{
+    size_t ops;
+    size_t failed;
+    double avg;
+    double p99;
+    double p999;
+    double max;
+    size_t walk;
+} Result_t;
+
+static void heap_bench_replay(const Heap_t *heap, Result_t *res)
+{
+    static void *blocks[MAX_IDS];
+    size_t n = 0, failed = 0, walk = 0;
+    double sum = 0;
+
+    memset(blocks, 0, sizeof(blocks));
+    for (size_t i = 0; i < op_count; i++)
+    {
+        const Op_t *op = &ops[i];
+        double t0, t1;
+
+        if (op->op == 'a')
+        {
+            if (blocks[op->id] != NULL)
+            {
+                continue;
+            }
+            t0 = now_cycles();
+            blocks[op->id] = heap->alloc(op->size);
+            t1 = now_cycles();
+            failed += (blocks[op->id] == NULL);
+        }
+        else
+        {
+            if (blocks[op->id] == NULL)
+            {
+                continue;
+            }
+            t0 = now_cycles();
+            heap->release(blocks[op->id]);
+            t1 = now_cycles();
+            blocks[op->id] = NULL;
+        }
+        samples[n] = (t1 - t0 > timer_overhead) ? (t1 - t0 - timer_overhead) : 0.0;
+        sum += samples[n++];
+
+        if ((heap->free_blocks != NULL) && (heap->free_blocks() > walk))
+        {
+            walk = heap->free_blocks();
+        }
+    }
+
+    for (unsigned id = 0; id < MAX_IDS; id++)
+    {
+        if (blocks[id] != NULL)
+        {
+            heap->release(blocks[id]);
+        }
+    }
+
+    qsort(samples, n, sizeof(samples[0]), cmp_double);
+    res->ops = n;
+    res->failed = failed;
+    res->avg = n ? sum / (double)n : 0.0;
+    res->p99 = n ? samples[(n * 99) / 100] : 0.0;
+    res->p999 = n ? samples[(n * 999) / 1000] : 0.0;
+    res->max = n ? samples[n - 1] : 0.0;
+    res->walk = walk;
+}
+
+/* Every replay frees all blocks, so the heap starts over each time and the
+   failures repeat exactly; only the timings vary and the lowest are kept */
+static void heap_bench_keep_best(Result_t *best, const Result_t *res, int first)
+{
+    if (first)
+    {
+        *best = *res;
+        return;
+    }
+    if (res->avg < best->avg) best->avg = res->avg;
+    if (res->p99 < best->p99) best->p99 = res->p99;
+    if (res->p999 < best->p999) best->p999 = res->p999;
+    if (res->max < best->max) best->max = res->max;
+}
+
+int main(int argc, char **argv)
+{
+    const Heap_t heaps[] =
+    {
+        { "heap_4",  h4_malloc, h4_free, h4_min_free_size, h4_free_blocks },
+        { "tlsf",    pvPortMalloc, vPortFree, xPortGetMinimumEverFreeHeapSize, NULL },
+    };
+
+    size_t count = 1000000;
+    unsigned max_live = 64;
+    unsigned seed = 1;
+    int repeat = 5;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:l:s:r:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n': count = strtoul(optarg, NULL, 0); break;
+        case 'l': max_live = (unsigned)strtoul(optarg, NULL, 0); break;
+        case 's': seed = (unsigned)strtoul(optarg, NULL, 0); break;
+        case 'r': repeat = atoi(optarg); break;
+        default:
+            fprintf(stderr, "usage: %s [-n ops] [-l blocks] [-s seed] [-r n] [trace.txt]\n", argv[0]);
+            return 1;
+        }
+    }
+    if ((repeat < 1) || (max_live < 1) || (max_live > MAX_IDS))
+    {
+        fprintf(stderr, "%s: -r needs 1 or more, -l 1..%u\n", argv[0], (unsigned)MAX_IDS);
+        return 1;
+    }
+    if (count > MAX_OPS)
+    {
+        count = MAX_OPS;
+    }
+
+    if (optind < argc)
+    {
+        if (heap_bench_load(argv[optind]) != 0)
+        {
+            return 1;
+        }
+    }
+    else
+    {
+        heap_bench_generate(count, max_live, seed);
+    }
+
+    const size_t heap_count = sizeof(heaps) / sizeof(heaps[0]);
+    Result_t best[sizeof(heaps) / sizeof(heaps[0])];
+    Result_t res;
+
+    heap_bench_calibrate();
+
+    /* Heaps take turns, so a slow phase of the host hits both alike */
+    for (int r = 0; r < repeat; r++)
+    {
+        for (size_t i = 0; i < heap_count; i++)
+        {
+            heap_bench_replay(&heaps[i], &res);
+            heap_bench_keep_best(&best[i], &res, r == 0);
+        }
+    }
+
+    printf("latency in TSC cycles per call, timer overhead %.0f taken off, best of %d\n",
+           timer_overhead, repeat);
+    for (size_t i = 0; i < heap_count; i++)
+    {
+        printf("%-8s ops %7zu  failed %5zu  min_free %6zu  avg %6.1f  p99 %6.1f  p99.9 %7.1f  max %9.1f",
+               heaps[i].name, best[i].ops, best[i].failed, heaps[i].min_free(), best[i].avg, best[i].p99,
+               best[i].p999, best[i].max);
+        if (heaps[i].free_blocks != NULL)
+        {
+            printf("  free list up to %zu", best[i].walk);
+        }
+        printf("\n");
+    }
+
+    /* Everything was freed, a TLSF that merges correctly is one block again */
+    HeapStats_t stats;
+
+    vPortGetHeapStats(&stats);
+    printf("\ntlsf after the run: %zu free blocks, largest %zu, available %zu bytes, %zu allocs, %zu frees\n",
+           stats.xNumberOfFreeBlocks, stats.xSizeOfLargestFreeBlockInBytes, stats.xAvailableHeapSpaceInBytes,
+           stats.xNumberOfSuccessfulAllocations, stats.xNumberOfSuccessfulFrees);
+    printf("free blocks per first level:");
+    for (uint32_t fl = 0; fl < HEAP_FL_COUNT; fl++)
+    {
+        printf(" %u", (unsigned)Heap_GetFreeBlocks(fl));
+    }
+    printf("\n");
+    return (stats.xNumberOfFreeBlocks == 1) ? 0 : 1;
+}
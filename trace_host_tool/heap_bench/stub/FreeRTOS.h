@@ -0,0 +1,51 @@
+/*
+ * Minimal FreeRTOS.h for building the heap implementations on a host.
+ * Single threaded, so the critical sections and scheduler locks are empty.
+ */
+#ifndef HEAP_BENCH_FREERTOS_H
+#define HEAP_BENCH_FREERTOS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <assert.h>
+
+/* Same values as Core/Inc/FreeRTOSConfig.h and the ARM_CM4F port */
+#define configTOTAL_HEAP_SIZE               ((size_t)15360)
+#define configSUPPORT_DYNAMIC_ALLOCATION    1
+#define configAPPLICATION_ALLOCATED_HEAP    0
+#define configUSE_MALLOC_FAILED_HOOK        0
+#define portBYTE_ALIGNMENT                  8
+#define portBYTE_ALIGNMENT_MASK             (0x0007)
+#define portPOINTER_SIZE_TYPE               size_t
+#define portMAX_DELAY                       ((size_t)-1)
+#define PRIVILEGED_FUNCTION
+
+#define configASSERT(x)                     assert(x)
+#define mtCOVERAGE_TEST_MARKER()
+#define traceMALLOC(pv, size)
+#define traceFREE(pv, size)
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+typedef long BaseType_t;
+
+typedef struct xHeapStats
+{
+    size_t xAvailableHeapSpaceInBytes;
+    size_t xSizeOfLargestFreeBlockInBytes;
+    size_t xSizeOfSmallestFreeBlockInBytes;
+    size_t xNumberOfFreeBlocks;
+    size_t xMinimumEverFreeBytesRemaining;
+    size_t xNumberOfSuccessfulAllocations;
+    size_t xNumberOfSuccessfulFrees;
+} HeapStats_t;
+
+/* From portable.h, Heap.c provides them */
+void *pvPortMalloc(size_t xWantedSize);
+void vPortFree(void *pv);
+size_t xPortGetFreeHeapSize(void);
+size_t xPortGetMinimumEverFreeHeapSize(void);
+void vPortInitialiseBlocks(void);
+void vPortGetHeapStats(HeapStats_t *pxHeapStats);
+
+#endif
@@ -0,0 +1,8 @@
+/* Minimal task.h for the host heap benchmark */
+#ifndef HEAP_BENCH_TASK_H
+#define HEAP_BENCH_TASK_H
+
+static inline void vTaskSuspendAll(void) {}
+static inline BaseType_t xTaskResumeAll(void) { return 0; }
+
+#endif
@@ -0,0 +1,116 @@
+/*
+ * Host build of the kernel latency suite in Application/Src/Bench.c on the
+ * FreeRTOS POSIX port (../freertos_posix).
+ *
+ * Bench.c is included unchanged after the stub App.h. Its cycle counts are host nanoseconds scaled
+ * to the 180 MHz core clock, so the BENCH/BHIST lines have the target
+ * format and units, but they measure the host (condition variable hand-off
+ * between threads), not the Cortex-M4. Use them to catch regressions of the
+ * suite and of the port in CI, compare numbers only run against run on the
+ * same machine.
+ *
+ * The suite runs once, then a low priority task ends the scheduler.
+ *
+ *     -t <ms>        run time before the scheduler is ended (default 5000,
+ *                    the suite takes about 2 s and repeats every 10 s)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "App.h"
+#include "Bench.c"
+
+HostCoreDebug_t host_core_debug;
+uint32_t SystemCoreClock = configCPU_CLOCK_HZ;
+
+static HostDwt_t host_dwt;
+static uint32_t bench_run_ms = 5000;
+
+HostDwt_t *Host_Dwt(void)
+{
+    host_dwt.CYCCNT = (uint32_t)((ullPortGetTimeNs() * (SystemCoreClock / 1000000U)) / 1000U);
+    return &host_dwt;
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type irq, uint32_t preempt, uint32_t sub)
+{
+    (void)irq;
+    (void)preempt;
+    (void)sub;
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type irq)
+{
+    (void)irq;
+}
+
+void NVIC_SetPendingIRQ(IRQn_Type irq)
+{
+    if (irq == SPDIF_RX_IRQn)
+    {
+        vPortPendInterrupt(SPDIF_RX_IRQHandler);
+    }
+}
+
+/* Provided by App.c on the target */
+void vApplicationMallocFailedHook(void)
+{
+    printf("Heap allocation failed!\r\n");
+}
+
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer,
+                                   uint32_t *pulIdleTaskStackSize)
+{
+    static StaticTask_t idle_tcb;
+    static StackType_t idle_stack[configMINIMAL_STACK_SIZE];
+
+    *ppxIdleTaskTCBBuffer = &idle_tcb;
+    *ppxIdleTaskStackBuffer = idle_stack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer,
+                                    uint32_t *pulTimerTaskStackSize)
+{
+    static StaticTask_t timer_tcb;
+    static StackType_t timer_stack[configTIMER_TASK_STACK_DEPTH];
+
+    *ppxTimerTaskTCBBuffer = &timer_tcb;
+    *ppxTimerTaskStackBuffer = timer_stack;
+    *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+
+static void bench_stop_task(void *params)
+{
+    (void)params;
+    vTaskDelay(pdMS_TO_TICKS(bench_run_ms));
+    vTaskEndScheduler();
+}
+
+int main(int argc, char **argv)
+{
+    int opt;
+
+    while ((opt = getopt(argc, argv, "t:")) != -1)
+    {
+        switch (opt)
+        {
+        case 't': bench_run_ms = (uint32_t)strtoul(optarg, NULL, 0); break;
+        default:
+            fprintf(stderr, "usage: %s [-t ms]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    if (xTaskCreate(bench_stop_task, "Stop", configMINIMAL_STACK_SIZE, NULL, 1, NULL) != pdPASS)
+    {
+        fprintf(stderr, "stop task creation failed\n");
+        return 1;
+    }
+
+    /* Creates the runner and echo tasks, returns once the scheduler ends */
+    Bench_Run();
+    return 0;
+}
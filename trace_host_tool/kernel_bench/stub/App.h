@@ -0,0 +1,58 @@
+/*
+ * App.h for the host build of Application/Src/Bench.c, same guard as the
+ * real one. Bench.c only needs the kernel, libc and the few Cortex-M names
+ * below: DWT->CYCCNT is read from the host clock, scaled to the 180 MHz
+ * core clock and 32 bits wide as on the target, and the software interrupt
+ * is pended on the port.
+ */
+#ifndef SRC_APP_H_
+#define SRC_APP_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+typedef struct
+{
+    uint32_t CYCCNT;
+    uint32_t CTRL;
+} HostDwt_t;
+
+typedef struct
+{
+    uint32_t DEMCR;
+} HostCoreDebug_t;
+
+/* CYCCNT is refreshed on every access */
+HostDwt_t *Host_Dwt(void);
+extern HostCoreDebug_t host_core_debug;
+
+#define DWT                         (Host_Dwt())
+#define CoreDebug                   (&host_core_debug)
+#define DWT_CTRL_CYCCNTENA_Msk      (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk  (1UL << 24)
+
+extern uint32_t SystemCoreClock;
+
+/* Stacks are plain arrays, no linker section */
+#define APP_STACK
+
+typedef enum
+{
+    SPDIF_RX_IRQn = 94,
+} IRQn_Type;
+
+void HAL_NVIC_SetPriority(IRQn_Type irq, uint32_t preempt, uint32_t sub);
+void HAL_NVIC_EnableIRQ(IRQn_Type irq);
+void NVIC_SetPendingIRQ(IRQn_Type irq);
+void SPDIF_RX_IRQHandler(void);
+
+#include "Bench.h"
+
+#endif /* SRC_APP_H_ */
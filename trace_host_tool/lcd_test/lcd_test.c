@@ -0,0 +1,230 @@
+/*
+ * Host test of the LCD shadow framebuffer in Application/Src/Lcd16x2.c.
+ *
+ * Lcd16x2.c and MemPool.c are built unchanged against stub headers. The
+ * I2C bus stub completes every transaction at once and feeds its bytes to a
+ * model of the PCF8574 + HD44780 (nibble latched on the falling edge of E,
+ * 4-bit mode after the init sequence, clear, DDRAM address and data writes).
+ * Each case renders one frame and checks the expander bytes it cost and
+ * that the modelled glass then shows the frame:
+ *   - an unchanged frame costs nothing,
+ *   - a single changed cell costs one cursor move and one character,
+ *   - a frame with every cell changed is a full redraw,
+ *   - after a failed transfer the next frame is a full redraw, even when
+ *     it matches the previous one.
+ * The exit code is non-zero if a case fails.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "App.h"
+#include "MemPool.c"
+
+MEMPOOL_DEFINE(xLcdFramePool, "LcdFrame", sizeof(LcdFrame_t), LCD_FRAME_COUNT);
+
+#include "Lcd16x2.c"
+
+#define LCD_BYTES_PER_CHAR  4       /* 2 nibbles, E high and E low each */
+#define LCD_DDRAM_LEN       0x80
+
+/* HD44780 model */
+static char glass_ddram[LCD_DDRAM_LEN];
+static uint8_t glass_addr;
+static int glass_four_bit;
+static int glass_have_high;
+static uint8_t glass_high;
+static uint8_t glass_last;
+
+/* I2C bus stub */
+static uint32_t bus_bytes;
+static uint32_t bus_fail_next;
+static int failures;
+
+static void glass_instruction(uint8_t rs, uint8_t value)
+{
+    if (rs)
+    {
+        glass_ddram[glass_addr] = (char)value;
+        glass_addr = (glass_addr + 1) % LCD_DDRAM_LEN;
+    }
+    else if (value == 0x01)
+    {
+        memset(glass_ddram, ' ', sizeof(glass_ddram));
+        glass_addr = 0;
+    }
+    else if (value & 0x80)
+    {
+        glass_addr = value & 0x7F;
+    }
+}
+
+static void glass_byte(uint8_t byte)
+{
+    /* Falling edge of E latches the nibble */
+    if ((glass_last & LCD_ENABLE) && !(byte & LCD_ENABLE))
+    {
+        uint8_t nibble = byte & 0xF0;
+        uint8_t rs = byte & REGISTER_SEL;
+
+        if (!glass_four_bit)
+        {
+            /* 8-bit interface, only the function set to 4-bit matters */
+            if (nibble == 0x20)
+            {
+                glass_four_bit = 1;
+                glass_have_high = 0;
+            }
+        }
+        else if (!glass_have_high)
+        {
+            glass_high = nibble;
+            glass_have_high = 1;
+        }
+        else
+        {
+            glass_have_high = 0;
+            glass_instruction(rs, glass_high | (nibble >> 4));
+        }
+    }
+    glass_last = byte;
+}
+
+static void bus_complete(I2cBusXfer_t *xfer)
+{
+    if (bus_fail_next > 0)
+    {
+        /* NACK on the first byte, nothing reaches the controller */
+        bus_fail_next--;
+        xfer->status = HAL_ERROR;
+        return;
+    }
+
+    for (uint16_t i = 0; i < xfer->length; i++)
+    {
+        glass_byte(xfer->data[i]);
+    }
+    bus_bytes += xfer->length;
+    xfer->status = HAL_OK;
+}
+
+bool I2cBus_Submit(I2cBusXfer_t *xfer, TickType_t wait)
+{
+    (void)wait;
+    bus_complete(xfer);
+    if (xfer->callback != NULL)
+    {
+        xfer->callback(xfer);
+    }
+    return true;
+}
+
+HAL_StatusTypeDef I2cBus_Transfer(I2cBusXfer_t *xfer)
+{
+    bus_complete(xfer);
+    return xfer->status;
+}
+
+HAL_StatusTypeDef I2cBus_Probe(uint16_t dev_addr, uint32_t timeout_ms)
+{
+    (void)timeout_ms;
+    return (dev_addr == LCD_ADDR) ? HAL_OK : HAL_ERROR;
+}
+
+void Health_Update(EventBits_t set, EventBits_t clear)
+{
+    (void)set;
+    (void)clear;
+}
+
+/* The LCD task loop is not run, the test renders its own frames */
+bool SampleRing_Attach(SampleReader_t *reader, bool notify)
+{
+    (void)reader;
+    (void)notify;
+    return false;
+}
+
+bool SampleRing_Wait(TickType_t timeout)
+{
+    (void)timeout;
+    return false;
+}
+
+bool SampleRing_Latest(SampleReader_t *reader, LM35_Sample_t *sample)
+{
+    (void)reader;
+    (void)sample;
+    return false;
+}
+
+static int glass_shows(const LcdMessage_t *msg)
+{
+    const char *lines[LCD_ROWS] = { msg->line1, msg->line2 };
+    static const uint8_t row_addr[LCD_ROWS] = { 0x00, 0x40 };
+
+    for (int row = 0; row < LCD_ROWS; row++)
+    {
+        size_t length = strlen(lines[row]);
+
+        for (int col = 0; col < LCD_COLS; col++)
+        {
+            char expected = (col < (int)length) ? lines[row][col] : ' ';
+            if (glass_ddram[row_addr[row] + col] != expected)
+            {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+/* delivered: the frame is expected on the glass afterwards */
+static void lcd_case(const char *name, const char *line1, const char *line2, uint32_t expected_bytes,
+                     int delivered)
+{
+    LcdMessage_t msg;
+
+    snprintf(msg.line1, sizeof(msg.line1), "%s", line1);
+    snprintf(msg.line2, sizeof(msg.line2), "%s", line2);
+
+    bus_bytes = 0;
+    LCD_Render(&msg);
+
+    int shown = glass_shows(&msg);
+    int pass = (shown == delivered) && (bus_bytes == expected_bytes) && (xLcdFramePool.in_use == 0);
+
+    printf("%-4s %-26s %4u bytes (expected %4u), glass %s\n", pass ? "PASS" : "FAIL", name,
+           (unsigned)bus_bytes, (unsigned)expected_bytes, shown ? "shows the frame" : "stale");
+    if (!pass)
+    {
+        failures++;
+    }
+}
+
+int main(void)
+{
+    const uint32_t one_cell = 2 * LCD_BYTES_PER_CHAR;                       /* Cursor move + character */
+    const uint32_t full = (LCD_ROWS * LCD_COLS + LCD_ROWS) * LCD_BYTES_PER_CHAR;  /* Every cell, a move per row */
+
+    MemPool_Init(&xLcdFramePool);
+    memset(glass_ddram, '?', sizeof(glass_ddram));
+
+    LCD_Init();
+    LCD_Clear();
+
+    lcd_case("first frame", "Temp: 25.0 C", "Sample: 1", (12 + 9 + 1) * LCD_BYTES_PER_CHAR, 1);
+    lcd_case("unchanged frame", "Temp: 25.0 C", "Sample: 1", 0, 1);
+    lcd_case("single cell", "Temp: 25.1 C", "Sample: 1", one_cell, 1);
+    lcd_case("full redraw", "ABCDEFGHIJKLMNOP", "abcdefghijklmnop", full, 1);
+    lcd_case("unchanged after redraw", "ABCDEFGHIJKLMNOP", "abcdefghijklmnop", 0, 1);
+
+    /* The single cell update is lost on the bus, the glass keeps the old frame */
+    bus_fail_next = 1;
+    lcd_case("failed transfer", "ABCDEFGHIJKLMNOx", "abcdefghijklmnop", 0, 0);
+    lcd_case("redraw after failure", "ABCDEFGHIJKLMNOx", "abcdefghijklmnop", full, 1);
+    lcd_case("unchanged after recovery", "ABCDEFGHIJKLMNOx", "abcdefghijklmnop", 0, 1);
+
+    printf("%s\n", failures ? "FAILED" : "all passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,31 @@
+/*
+ * Host replacement for Application/Inc/App.h (same include guard), only what
+ * Lcd16x2.c and MemPool.c need. The I2C bus, health and sample ring
+ * functions are provided by lcd_test.c.
+ */
+#ifndef SRC_APP_H_
+#define SRC_APP_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "I2cBus.h"
+#include "MemPool.h"
+#include "Lm35.h"
+#include "Lcd16x2.h"
+#include "SampleRing.h"
+
+#define HEALTH_COMMS_LOSS           (1UL << 3)
+
+void Health_Update(EventBits_t set, EventBits_t clear);
+
+#define TRACE(fmt, ...)     do { } while (0)
+
+#endif
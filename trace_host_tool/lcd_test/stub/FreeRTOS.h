@@ -0,0 +1,24 @@
+/*
+ * Minimal FreeRTOS.h for building Lcd16x2.c and MemPool.c on a host.
+ * Single threaded, the test calls the render functions directly.
+ */
+#ifndef LCD_TEST_FREERTOS_H
+#define LCD_TEST_FREERTOS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <assert.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint32_t EventBits_t;
+
+#define pdFALSE                 ((BaseType_t)0)
+#define pdTRUE                  ((BaseType_t)1)
+#define pdPASS                  pdTRUE
+#define portMAX_DELAY           ((TickType_t)0xFFFFFFFFUL)
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(ms))
+#define configASSERT(x)         assert(x)
+
+#endif
@@ -0,0 +1,13 @@
+/* Minimal HAL types for the host LCD test */
+#ifndef LCD_TEST_STM32F4XX_HAL_H
+#define LCD_TEST_STM32F4XX_HAL_H
+
+typedef enum
+{
+    HAL_OK = 0x00U,
+    HAL_ERROR = 0x01U,
+    HAL_BUSY = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+#endif
@@ -0,0 +1,18 @@
+/* Minimal task.h for the host LCD test, delays return at once */
+#ifndef LCD_TEST_TASK_H
+#define LCD_TEST_TASK_H
+
+#include "FreeRTOS.h"
+
+typedef void *TaskHandle_t;
+
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+#define taskENTER_CRITICAL_FROM_ISR()   0
+#define taskEXIT_CRITICAL_FROM_ISR(x)   ((void)(x))
+
+static inline TickType_t xTaskGetTickCount(void) { return 0; }
+static inline void vTaskDelay(TickType_t ticks) { (void)ticks; }
+static inline void vTaskDelayUntil(TickType_t *previous, TickType_t increment) { *previous += increment; }
+
+#endif
@@ -0,0 +1,150 @@
+"""Send runtime commands to the board over USART1 (HC-05 Bluetooth).
+
+Requests and responses use the telemetry framing (COBS, CRC-16), layout in
+Application/Inc/Rpc.h. Sample frames arriving in between are skipped. Every
+reply shows the status, the decoded result, the dispatch time measured on
+the board and the round trip seen from the host.
+
+    python rpc_client.py --port /dev/rfcomm0 ping
+    python rpc_client.py --port /dev/rfcomm0 set-period 500
+    python rpc_client.py --port /dev/rfcomm0 set-filter 5 7
+    python rpc_client.py --port /dev/rfcomm0 ping --repeat 100
+"""
+import argparse
+import struct
+import sys
+import time
+
+from telemetry_decoder import SCHEMA_VERSION, crc16_ccitt
+from trace_decoder import cobs_decode
+
+TYPE_RPC_REQUEST = 2
+TYPE_RPC_RESPONSE = 3
+RESPONSE = struct.Struct("<BBBBBH")     # version, type, tag, command, status, dispatch us
+STATUS = {0: "ok", 1: "unknown command", 2: "bad length", 3: "bad value"}
+
+# name: (command id, argument format, result format, result field names)
+COMMANDS = {
+    "ping": (0x01, "", "<I", ("uptime_ms",)),
+    "get-config": (0x02, "", "<HHHBBiiHHB",
+                   ("period_ms", "disconnect_adc", "overtemp_adc", "median_k",
+                    "decim_log2", "gain_q15", "offset_cdeg", "led_speed",
+                    "alert_window_s", "alert_channel")),
+    "set-period": (0x10, "<H", "", ()),
+    "set-thresholds": (0x11, "<HH", "", ()),
+    "set-filter": (0x12, "<BB", "", ()),
+    "set-cal": (0x13, "<ii", "", ()),
+    "set-led-speed": (0x14, "<H", "", ()),
+    "set-alert": (0x15, "<HB", "", ()),
+    "stats": (0x20, "", "<IIIIHH",
+              ("requests", "errors", "corrupt", "dropped", "avg_us", "max_us")),
+}
+
+
+def cobs_encode(data):
+    out = bytearray([0])
+    code_at = 0
+    for byte in data:
+        if byte:
+            out.append(byte)
+        if not byte or len(out) - code_at == 0xFF:
+            out[code_at] = len(out) - code_at
+            code_at = len(out)
+            out.append(0)
+    out[code_at] = len(out) - code_at
+    return bytes(out)
+
+
+def request_frame(tag, command, args):
+    payload = struct.pack("<BBBB", SCHEMA_VERSION, TYPE_RPC_REQUEST, tag, command) + args
+    payload += struct.pack("<H", crc16_ccitt(payload))
+    return b"\x00" + cobs_encode(payload) + b"\x00"
+
+
+class RpcClient:
+    def __init__(self, port, timeout):
+        self.port = port
+        self.timeout = timeout
+        self.pending = bytearray()
+        self.tag = 0
+
+    def call(self, command, args):
+        self.tag = (self.tag + 1) & 0xFF
+        started = time.monotonic()
+        self.port.write(request_frame(self.tag, command, args))
+        while time.monotonic() - started < self.timeout:
+            for byte in self.port.read(64):
+                if byte:
+                    self.pending.append(byte)
+                    continue
+                payload = cobs_decode(bytes(self.pending)) if self.pending else None
+                self.pending.clear()
+                reply = self.match(payload)
+                if reply is not None:
+                    return reply + ((time.monotonic() - started) * 1e6,)
+        return None
+
+    def match(self, payload):
+        # Sample frames and replies to earlier (timed out) requests are skipped
+        if payload is None or len(payload) < RESPONSE.size + 2:
+            return None
+        if crc16_ccitt(payload[:-2]) != struct.unpack_from("<H", payload, len(payload) - 2)[0]:
+            return None
+        version, ftype, tag, _, status, dispatch_us = RESPONSE.unpack_from(payload, 0)
+        if version != SCHEMA_VERSION or ftype != TYPE_RPC_RESPONSE or tag != self.tag:
+            return None
+        return status, dispatch_us, payload[RESPONSE.size:-2]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Runtime commands over the HC-05 link")
+    parser.add_argument("--port", required=True, help="serial port of the HC-05 link, e.g. /dev/rfcomm0")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--timeout", type=float, default=1.0, help="seconds to wait for each reply")
+    parser.add_argument("--repeat", type=int, default=1, help="send the command n times, print latency stats")
+    parser.add_argument("command", choices=sorted(COMMANDS))
+    parser.add_argument("values", nargs="*", type=lambda v: int(v, 0))
+    args = parser.parse_args()
+
+    command, arg_format, result_format, fields = COMMANDS[args.command]
+    arg_count = len(arg_format) - 1 if arg_format else 0
+    if len(args.values) != arg_count:
+        parser.error("%s takes %u value(s)" % (args.command, arg_count))
+    packed = struct.pack(arg_format, *args.values) if arg_format else b""
+
+    import serial   # pyserial
+    client = RpcClient(serial.Serial(args.port, args.baud, timeout=0.05), args.timeout)
+
+    dispatch, round_trip, lost = [], [], 0
+    for _ in range(args.repeat):
+        reply = client.call(command, packed)
+        if reply is None:
+            lost += 1
+            continue
+        status, dispatch_us, result, host_us = reply
+        dispatch.append(dispatch_us)
+        round_trip.append(host_us)
+        if args.repeat == 1:
+            print("status     %s" % STATUS.get(status, status))
+            if status == 0 and result_format:
+                for name, value in zip(fields, struct.unpack(result_format, result)):
+                    print("%-14s %d" % (name, value))
+            print("dispatch   %u us on the board, %.1f ms round trip" % (dispatch_us, host_us / 1000.0))
+        elif status != 0:
+            print("status     %s" % STATUS.get(status, status))
+
+    if args.repeat > 1 and dispatch:
+        round_trip.sort()
+        print("%u replies, %u lost" % (len(dispatch), lost))
+        print("dispatch   avg %.1f us, max %u us" % (sum(dispatch) / len(dispatch), max(dispatch)))
+        print("round trip avg %.1f ms, p99 %.1f ms, max %.1f ms" %
+              (sum(round_trip) / len(round_trip) / 1000.0,
+               round_trip[min(len(round_trip) - 1, int(len(round_trip) * 0.99))] / 1000.0,
+               round_trip[-1] / 1000.0))
+    if lost and args.repeat == 1:
+        print("no reply within %.1f s" % args.timeout, file=sys.stderr)
+    return 1 if lost else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,72 @@
+"""Plot the SysMon report (SYS/TSK lines) captured from the console.
+
+    python trace_decoder.py firmware.elf --port /dev/ttyACM0 | tee log.txt
+    python sysmon_plot.py log.txt
+
+Lines may carry a prefix (e.g. a timestamp), everything before "SYS," or
+"TSK," is ignored. Needs matplotlib.
+"""
+import argparse
+import collections
+import sys
+
+
+def parse(lines):
+    cpu = collections.defaultdict(list)     # task -> [(t_s, cpu_%)]
+    stack = collections.defaultdict(list)   # task -> [(t_s, hwm_words)]
+    heap = []                               # [(t_s, free, min_free)]
+
+    for line in lines:
+        for tag in ("SYS,", "TSK,"):
+            pos = line.find(tag)
+            if pos >= 0:
+                fields = line[pos:].strip().split(",")
+                break
+        else:
+            continue
+
+        try:
+            t_s = int(fields[1]) / 1000.0
+            if fields[0] == "SYS":
+                heap.append((t_s, int(fields[3]), int(fields[4])))
+            else:
+                cpu[fields[2]].append((t_s, int(fields[3]) / 10.0))
+                stack[fields[2]].append((t_s, int(fields[4])))
+        except (IndexError, ValueError):
+            continue
+
+    return cpu, stack, heap
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Plot SysMon CPU/stack/heap report")
+    parser.add_argument("log", nargs="?", help="captured console text (default: stdin)")
+    args = parser.parse_args()
+
+    with (open(args.log) if args.log else sys.stdin) as f:
+        cpu, stack, heap = parse(f)
+
+    import matplotlib.pyplot as plt
+
+    fig, (ax_cpu, ax_stack, ax_heap) = plt.subplots(3, 1, sharex=True)
+    for task, points in sorted(cpu.items()):
+        ax_cpu.plot(*zip(*points), label=task)
+    for task, points in sorted(stack.items()):
+        ax_stack.plot(*zip(*points), label=task)
+    if heap:
+        t_s, free, min_free = zip(*heap)
+        ax_heap.plot(t_s, free, label="free")
+        ax_heap.plot(t_s, min_free, label="min ever free")
+
+    ax_cpu.set_ylabel("CPU %")
+    ax_stack.set_ylabel("stack HWM (words)")
+    ax_heap.set_ylabel("heap (bytes)")
+    ax_heap.set_xlabel("time (s)")
+    for ax in (ax_cpu, ax_stack, ax_heap):
+        ax.legend(loc="upper right", fontsize="small")
+        ax.grid(True)
+    plt.show()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,175 @@
+"""Decode the binary LM35 telemetry streamed on USART1 (HC-05 Bluetooth).
+
+Frames are COBS encoded between 0x00 delimiters, the payload layout is
+documented in Application/Inc/Telemetry.h (schema version 1). Every frame is
+CRC checked, frame sequence gaps are counted as lost frames and sample
+sequence gaps as lost samples. A summary with loss and throughput is printed
+at the end (end of capture or Ctrl-C).
+
+    python telemetry_decoder.py --port /dev/rfcomm0
+    python telemetry_decoder.py --input capture.bin --csv samples.csv
+"""
+import argparse
+import struct
+import sys
+import time
+
+from trace_decoder import cobs_decode, open_source
+
+SCHEMA_VERSION = 1
+TYPE_SAMPLES = 1
+TYPE_RPC_RESPONSE = 3                   # Replies to rpc_client.py, not telemetry
+HEADER = struct.Struct("<BBHIIHB")      # version, type, frame seq, first sample seq, tick, skipped, n
+RECORD = struct.Struct("<HHhB")         # tick offset, adc_q4, cdeg, flags
+CRC_LEN = 2
+FLAG_ADC_TIMEOUT = 0x01
+FLAG_DISCONNECTED = 0x02
+
+
+def crc16_ccitt(data, crc=0xFFFF):
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+        crc &= 0xFFFF
+    return crc
+
+
+class TelemetryDecoder:
+    def __init__(self, csv=None, quiet=False, live=False):
+        self.csv = csv
+        self.quiet = quiet
+        self.live = live
+        self.pending = bytearray()
+        self.wire_bytes = 0
+        self.frames = 0
+        self.crc_errors = 0
+        self.malformed = 0
+        self.other_version = 0
+        self.rpc_replies = 0
+        self.frames_lost = 0
+        self.resets = 0
+        self.samples = 0
+        self.samples_lost = 0
+        self.next_frame_seq = None
+        self.next_sample_seq = None
+        self.last_tick = None
+        self.span_ms = 0
+        self.started = time.monotonic()
+
+    def feed(self, data):
+        self.wire_bytes += len(data)
+        for byte in data:
+            if byte:
+                self.pending.append(byte)
+            elif self.pending:
+                self.frame(bytes(self.pending))
+                self.pending.clear()
+
+    def frame(self, chunk):
+        payload = cobs_decode(chunk)
+        if payload is None or len(payload) < 2 + CRC_LEN:
+            self.malformed += 1
+            return
+        if crc16_ccitt(payload[:-CRC_LEN]) != struct.unpack_from("<H", payload, len(payload) - CRC_LEN)[0]:
+            self.crc_errors += 1
+            return
+
+        version, ftype = payload[0], payload[1]
+        if version == SCHEMA_VERSION and ftype == TYPE_RPC_RESPONSE:
+            self.rpc_replies += 1
+            return
+        if version != SCHEMA_VERSION or ftype != TYPE_SAMPLES:
+            self.other_version += 1
+            return
+        _, _, seq, sample_seq, tick, skipped, count = HEADER.unpack_from(payload, 0)
+        if len(payload) != HEADER.size + count * RECORD.size + CRC_LEN:
+            self.malformed += 1
+            return
+
+        # skipped covers samples the firmware never framed, the sample
+        # sequence gap also catches those that went out in a lost frame
+        gap = (sample_seq - self.next_sample_seq) & 0xFFFFFFFF if self.next_sample_seq is not None else None
+        if gap is None or gap >= 0x80000000:
+            # First frame, or the sequence went backwards: the board restarted
+            self.resets += gap is not None
+            self.samples_lost += skipped
+        else:
+            self.frames_lost += (seq - self.next_frame_seq) & 0xFFFF
+            self.samples_lost += gap
+        self.next_frame_seq = (seq + 1) & 0xFFFF
+        self.next_sample_seq = (sample_seq + count) & 0xFFFFFFFF
+
+        self.frames += 1
+        for index in range(count):
+            offset, adc_q4, cdeg, flags = RECORD.unpack_from(payload, HEADER.size + index * RECORD.size)
+            self.sample(sample_seq + index, tick + offset, adc_q4, cdeg, flags)
+
+        if not self.quiet:
+            print("frame %5u: %2u samples from #%u at %.3f s%s" %
+                  (seq, count, sample_seq, tick / 1000.0,
+                   ", %u skipped" % skipped if skipped else ""), flush=True)
+
+    def sample(self, seq, tick_ms, adc_q4, cdeg, flags):
+        self.samples += 1
+        # Device time covered, restarts (tick going backwards) add nothing
+        if self.last_tick is not None and tick_ms >= self.last_tick:
+            self.span_ms += tick_ms - self.last_tick
+        self.last_tick = tick_ms
+        if self.csv:
+            self.csv.write("%u,%u,%.4f,%.2f,%u,%u\n" %
+                           (tick_ms, seq, adc_q4 / 16.0, cdeg / 100.0,
+                            1 if flags & FLAG_ADC_TIMEOUT else 0,
+                            1 if flags & FLAG_DISCONNECTED else 0))
+
+    def summary(self):
+        span = self.span_ms / 1000.0
+        wall = time.monotonic() - self.started
+        sent = self.frames + self.frames_lost
+        lines = [
+            "frames     %u ok, %u lost (%.2f %%), %u CRC errors, %u malformed, %u other schema, %u resets, %u RPC replies" %
+            (self.frames, self.frames_lost, 100.0 * self.frames_lost / sent if sent else 0.0,
+             self.crc_errors, self.malformed, self.other_version, self.resets, self.rpc_replies),
+            "samples    %u received, %u lost, %.1f per frame" %
+            (self.samples, self.samples_lost, self.samples / self.frames if self.frames else 0.0),
+            "wire       %u bytes, %.1f bytes per sample" %
+            (self.wire_bytes, self.wire_bytes / self.samples if self.samples else 0.0),
+        ]
+        if span > 0:
+            lines.append("throughput %.2f samples/s, %.1f bytes/s over %.1f s of device time" %
+                         (self.samples / span, self.wire_bytes / span, span))
+        if self.live and wall > 0:
+            lines.append("host       %.1f bytes/s over %.1f s of capture" % (self.wire_bytes / wall, wall))
+        return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode LM35 telemetry frames")
+    parser.add_argument("--port", help="serial port of the HC-05 link, e.g. /dev/rfcomm0")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--input", help="raw capture file (default: stdin)")
+    parser.add_argument("--csv", help="write every sample to this CSV file")
+    parser.add_argument("--quiet", action="store_true", help="summary only")
+    args = parser.parse_args()
+
+    csv = open(args.csv, "w") if args.csv else None
+    if csv:
+        csv.write("tick_ms,sequence,adc_code,temp_c,adc_timeout,disconnected\n")
+    decoder = TelemetryDecoder(csv, args.quiet, live=bool(args.port))
+    read = open_source(args)
+
+    try:
+        while True:
+            data = read()
+            if data is None:
+                break
+            decoder.feed(data)
+    except KeyboardInterrupt:
+        pass
+
+    print(decoder.summary(), file=sys.stderr)
+    return 1 if decoder.crc_errors or decoder.malformed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
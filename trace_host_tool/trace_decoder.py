@@ -0,0 +1,195 @@
+"""Decode the binary TRACE() records sent by the firmware on USART2.
+
+The firmware only sends the ID of the format string (its offset in the
+.trace_fmt section of the ELF) plus the raw 32-bit arguments. This tool
+reads the format strings back from the ELF and rebuilds the text.
+
+Records are COBS encoded between 0x00 delimiters and share the console with
+ordinary printf text, which is passed through unchanged.
+
+    python trace_decoder.py firmware.elf --port /dev/ttyACM0
+    python trace_decoder.py firmware.elf --input capture.bin
+"""
+import argparse
+import re
+import struct
+import sys
+
+TRACE_SECTION = ".trace_fmt"
+TRACE_HEADER_LEN = 6        # id:u16 + tick:u32
+TRACE_CHECK_XOR = 0xA5
+TICK_RATE_HZ = 1000         # configTICK_RATE_HZ
+
+# printf conversions the firmware allows: integers only
+FMT_RE = re.compile(r"%(%|[-+ #0]*\d*(?:\.\d+)?(?:hh|h|ll|l|z|j|t)?([diuxXcp]))")
+
+
+def load_format_strings(elf_path):
+    """Return (section_addr, section_bytes) of .trace_fmt from a 32-bit LE ELF."""
+    with open(elf_path, "rb") as f:
+        elf = f.read()
+
+    if elf[:4] != b"\x7fELF" or elf[4] != 1 or elf[5] != 1:
+        raise ValueError("%s is not a 32-bit little endian ELF" % elf_path)
+
+    e_shoff = struct.unpack_from("<I", elf, 0x20)[0]
+    e_shentsize, e_shnum, e_shstrndx = struct.unpack_from("<HHH", elf, 0x2E)
+
+    def section(index):
+        # name, type, flags, addr, offset, size
+        return struct.unpack_from("<IIIIII", elf, e_shoff + index * e_shentsize)
+
+    shstr = section(e_shstrndx)
+    names = elf[shstr[4]:shstr[4] + shstr[5]]
+
+    for index in range(e_shnum):
+        name_off, _, _, addr, offset, size = section(index)
+        name = names[name_off:names.index(b"\0", name_off)].decode()
+        if name == TRACE_SECTION:
+            return addr, elf[offset:offset + size]
+
+    raise ValueError("%s has no %s section" % (elf_path, TRACE_SECTION))
+
+
+def cobs_decode(data):
+    out = bytearray()
+    index = 0
+    while index < len(data):
+        code = data[index]
+        index += 1
+        if code == 0 or index + code - 1 > len(data):
+            return None
+        out += data[index:index + code - 1]
+        index += code - 1
+        if code != 0xFF and index < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def format_record(fmt, args):
+    values = iter(args)
+
+    def convert(match):
+        if match.group(1) == "%":
+            return "%"
+        try:
+            value = next(values)
+        except StopIteration:
+            return "<missing>"
+        spec = match.group(0)
+        conv = match.group(2)
+        spec = re.sub(r"(hh|h|ll|l|z|j|t)(?=[diuxXcp]$)", "", spec)
+        if conv in "di":
+            value = value - (1 << 32) if value & 0x80000000 else value
+            spec = spec[:-1] + "d"
+        elif conv == "u":
+            spec = spec[:-1] + "d"
+        elif conv == "p":
+            return "0x%08x" % value
+        return spec % value
+
+    return FMT_RE.sub(convert, fmt)
+
+
+class TraceDecoder:
+    def __init__(self, fmt_addr, fmt_table):
+        self.fmt_addr = fmt_addr
+        self.fmt_table = fmt_table
+        self.in_frame = False
+        self.pending = bytearray()
+
+    def lookup(self, fmt_id):
+        start = fmt_id - self.fmt_addr
+        if start < 0 or start >= len(self.fmt_table):
+            return None
+        end = self.fmt_table.find(b"\0", start)
+        return self.fmt_table[start:end].decode("ascii", "replace")
+
+    def decode_frame(self, chunk):
+        payload = cobs_decode(chunk)
+        if payload is None or len(payload) < TRACE_HEADER_LEN + 1:
+            return None
+        if (len(payload) - TRACE_HEADER_LEN - 1) % 4:
+            return None
+
+        check = TRACE_CHECK_XOR
+        for byte in payload[:-1]:
+            check ^= byte
+        if check != payload[-1]:
+            return None
+
+        fmt_id, tick = struct.unpack_from("<HI", payload, 0)
+        nargs = (len(payload) - TRACE_HEADER_LEN - 1) // 4
+        args = struct.unpack_from("<%dI" % nargs, payload, TRACE_HEADER_LEN)
+        fmt = self.lookup(fmt_id)
+        if fmt is None:
+            text = "<unknown id 0x%04x> %s" % (fmt_id, " ".join("0x%x" % a for a in args))
+        else:
+            text = format_record(fmt, args)
+        return "[%10.3f] %s" % (tick / TICK_RATE_HZ, text)
+
+    def feed(self, data):
+        """Consume raw bytes, return the list of complete output lines."""
+        lines = []
+        for byte in data:
+            if byte != 0:
+                self.pending.append(byte)
+                if not self.in_frame and byte == 0x0A:
+                    lines.append(self.pending.decode("ascii", "replace").rstrip("\r\n"))
+                    self.pending.clear()
+                continue
+
+            if self.in_frame:
+                if not self.pending:
+                    # Back to back delimiters, this one opens the next record
+                    continue
+                line = self.decode_frame(bytes(self.pending))
+                if line is None:
+                    # Out of phase (capture started mid record), treat as text
+                    lines.append(self.pending.decode("ascii", "replace").rstrip("\r\n"))
+                    self.in_frame = True
+                    self.pending.clear()
+                    continue
+                lines.append(line)
+            elif self.pending:
+                lines.append(self.pending.decode("ascii", "replace").rstrip("\r\n"))
+
+            self.pending.clear()
+            self.in_frame = not self.in_frame
+        return lines
+
+
+def open_source(args):
+    if args.port:
+        import serial   # pyserial, only needed for live capture
+        port = serial.Serial(args.port, args.baud, timeout=0.1)
+        return lambda: port.read(256)
+    stream = open(args.input, "rb") if args.input else sys.stdin.buffer
+    return lambda: stream.read(256) or None
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode firmware TRACE() records")
+    parser.add_argument("elf", help="firmware ELF with the .trace_fmt section")
+    parser.add_argument("--port", help="serial port, e.g. /dev/ttyACM0")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--input", help="raw capture file (default: stdin)")
+    args = parser.parse_args()
+
+    fmt_addr, fmt_table = load_format_strings(args.elf)
+    decoder = TraceDecoder(fmt_addr, fmt_table)
+    read = open_source(args)
+
+    try:
+        while True:
+            data = read()
+            if data is None:
+                break
+            for line in decoder.feed(data):
+                print(line, flush=True)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,19 @@
+/*
+ * Minimal FreeRTOS.h for building UartRx.c on a host.
+ * Single threaded, the simulation calls the "ISR" and the reader in turn.
+ */
+#ifndef UART_RX_SIM_FREERTOS_H
+#define UART_RX_SIM_FREERTOS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef long BaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE                 ((BaseType_t)0)
+#define pdTRUE                  ((BaseType_t)1)
+#define portMAX_DELAY           ((TickType_t)0xFFFFFFFFUL)
+#define portYIELD_FROM_ISR(x)   ((void)(x))
+
+#endif
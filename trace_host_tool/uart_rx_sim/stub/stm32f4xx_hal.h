@@ -0,0 +1,35 @@
+/*
+ * Host stand-in for the parts of the STM32F4 HAL that UartRx.c touches.
+ * HAL_UARTEx_ReceiveToIdle_DMA is implemented by the simulation.
+ */
+#ifndef UART_RX_SIM_STM32F4XX_HAL_H
+#define UART_RX_SIM_STM32F4XX_HAL_H
+
+#include <stdint.h>
+
+typedef enum
+{
+    HAL_OK = 0,
+    HAL_ERROR,
+    HAL_BUSY,
+    HAL_TIMEOUT
+} HAL_StatusTypeDef;
+
+typedef struct
+{
+    uint32_t ndtr;              /* Bytes left before the circular DMA wraps */
+} DMA_HandleTypeDef;
+
+typedef struct
+{
+    DMA_HandleTypeDef *hdmarx;
+    uint8_t *pRxBuffPtr;
+    uint16_t RxXferSize;
+} UART_HandleTypeDef;
+
+#define __HAL_DMA_GET_COUNTER(hdma)     ((hdma)->ndtr)
+
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *pData,
+                                               uint16_t Size);
+
+#endif
@@ -0,0 +1,72 @@
+/*
+ * Host stand-in for the FreeRTOS stream buffer: a byte ring with the same
+ * capacity rules (xBufferSizeBytes usable, storage of size + 1). Receive
+ * never blocks, the simulation only reads when it decides the task runs.
+ */
+#ifndef UART_RX_SIM_STREAM_BUFFER_H
+#define UART_RX_SIM_STREAM_BUFFER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct
+{
+    uint8_t *storage;
+    size_t length;              /* Storage size, one more than the capacity */
+    size_t head;
+    size_t tail;
+} StaticStreamBuffer_t;
+
+typedef StaticStreamBuffer_t *StreamBufferHandle_t;
+
+static inline StreamBufferHandle_t xStreamBufferCreateStatic(size_t size, size_t trigger,
+                                                             uint8_t *storage,
+                                                             StaticStreamBuffer_t *buffer)
+{
+    (void)trigger;
+    buffer->storage = storage;
+    buffer->length = size + 1;
+    buffer->head = 0;
+    buffer->tail = 0;
+    return buffer;
+}
+
+static inline size_t xStreamBufferBytesAvailable(StreamBufferHandle_t sb)
+{
+    return (sb->head + sb->length - sb->tail) % sb->length;
+}
+
+static inline size_t xStreamBufferSendFromISR(StreamBufferHandle_t sb, const void *data,
+                                              size_t length, BaseType_t *woken)
+{
+    size_t space = sb->length - 1 - xStreamBufferBytesAvailable(sb);
+    size_t n = (length < space) ? length : space;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        sb->storage[sb->head] = ((const uint8_t *)data)[i];
+        sb->head = (sb->head + 1) % sb->length;
+    }
+    if ((n > 0) && (woken != NULL))
+    {
+        *woken = pdTRUE;
+    }
+    return n;
+}
+
+static inline size_t xStreamBufferReceive(StreamBufferHandle_t sb, void *data, size_t length,
+                                          TickType_t timeout)
+{
+    size_t available = xStreamBufferBytesAvailable(sb);
+    size_t n = (length < available) ? length : available;
+
+    (void)timeout;
+    for (size_t i = 0; i < n; i++)
+    {
+        ((uint8_t *)data)[i] = sb->storage[sb->tail];
+        sb->tail = (sb->tail + 1) % sb->length;
+    }
+    return n;
+}
+
+#endif
@@ -0,0 +1,26 @@
+/* Minimal task.h for the host UART receive simulation */
+#ifndef UART_RX_SIM_TASK_H
+#define UART_RX_SIM_TASK_H
+
+#include "FreeRTOS.h"
+
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+/* No reader asks for a notification here, UartRx_SetNotify is never called */
+typedef void *TaskHandle_t;
+
+typedef enum
+{
+    eNoAction = 0,
+    eSetBits
+} eNotifyAction;
+
+static inline BaseType_t xTaskNotifyFromISR(TaskHandle_t task, uint32_t value, eNotifyAction action,
+                                            BaseType_t *woken)
+{
+    (void)task; (void)value; (void)action; (void)woken;
+    return pdTRUE;
+}
+
+#endif
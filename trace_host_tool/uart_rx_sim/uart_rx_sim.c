@@ -0,0 +1,290 @@
+/*
+ * Host loopback simulation of Application/Src/UartRx.c.
+ *
+ * Both ports are fed at the same time, byte by byte at the UART line rate,
+ * through a model of the circular DMA: the half transfer, transfer complete
+ * and IDLE line events call UartRx_Event_FromISR() exactly as the HAL does.
+ * A reader "task" drains each stream buffer every -p ms and checks the bytes
+ * against what was sent. Reported per port: delivered/dropped bytes, DMA
+ * events and bytes per event, the worst stream buffer fill and the delivered
+ * throughput against the line rate.
+ *
+ *     -m line|burst  continuous traffic, or bursts with idle gaps (default line)
+ *     -t <s>         simulated time (default 10)
+ *     -p <ms>        reader period, i.e. worst case reader latency (default 10)
+ *     -b <baud>      line rate, 8N1 (default 115200)
+ *     -s <seed>      burst length/gap seed (default 1)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "UartRx.c"
+
+#define NS_PER_S            1000000000ULL
+#define NEVER               UINT64_MAX
+#define BURST_MAX_BYTES     600
+#define GAP_MAX_MS          20
+
+typedef struct
+{
+    UART_HandleTypeDef *huart;
+    DMA_HandleTypeDef dma;
+    uint64_t next_byte;         /* Arrival of the next byte, NEVER in a gap */
+    uint64_t idle_at;           /* IDLE flag after the last byte of a burst */
+    uint32_t burst_left;
+    uint32_t tx_state;
+    uint32_t rx_state;
+    uint64_t sent;
+    uint64_t received;
+    uint64_t mismatch_at;       /* First byte that did not match, 0 = none */
+} SimPort_t;
+
+UART_HandleTypeDef huart1;
+UART_HandleTypeDef huart3;
+
+static SimPort_t sim_ports[UART_RX_PORT_COUNT];
+static uint64_t byte_ns;
+static int burst_mode;
+
+static uint32_t sim_next(uint32_t *state)
+{
+    /* xorshift32, same sequence on the sending and the checking side */
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *pData,
+                                               uint16_t Size)
+{
+    huart->pRxBuffPtr = pData;
+    huart->RxXferSize = Size;
+    huart->hdmarx->ndtr = Size;
+    return HAL_OK;
+}
+
+static void sim_schedule_burst(SimPort_t *port, uint64_t after)
+{
+    if (!burst_mode)
+    {
+        port->burst_left = UINT32_MAX;
+        port->next_byte = after;
+        return;
+    }
+
+    uint64_t gap = 2 * byte_ns + (uint64_t)(rand() % (GAP_MAX_MS * 1000)) * 1000ULL;
+    port->burst_left = 1 + (uint32_t)(rand() % BURST_MAX_BYTES);
+    port->next_byte = after + gap;
+}
+
+/* One byte arrives: the DMA stores it, HT/TC fire at the half/end of the ring */
+static void sim_byte(SimPort_t *port, uint64_t now)
+{
+    UART_HandleTypeDef *huart = port->huart;
+    uint16_t position = (uint16_t)(huart->RxXferSize - port->dma.ndtr);
+
+    huart->pRxBuffPtr[position] = (uint8_t)sim_next(&port->tx_state);
+    port->sent++;
+    port->dma.ndtr--;
+    position++;
+
+    if (position == huart->RxXferSize / 2)
+    {
+        UartRx_Event_FromISR(huart, position);
+    }
+    else if (port->dma.ndtr == 0)
+    {
+        port->dma.ndtr = huart->RxXferSize;
+        UartRx_Event_FromISR(huart, huart->RxXferSize);
+    }
+
+    if (--port->burst_left == 0)
+    {
+        port->idle_at = now + byte_ns;
+        sim_schedule_burst(port, now + byte_ns);
+    }
+    else
+    {
+        port->next_byte = now + byte_ns;
+    }
+}
+
+/* Line idle for one frame: the HAL reports the position unless the ring is
+   exactly at its start (nothing new since transfer complete) */
+static void sim_idle(SimPort_t *port)
+{
+    UART_HandleTypeDef *huart = port->huart;
+
+    port->idle_at = NEVER;
+    if ((port->dma.ndtr > 0) && (port->dma.ndtr < huart->RxXferSize))
+    {
+        UartRx_Event_FromISR(huart, (uint16_t)(huart->RxXferSize - port->dma.ndtr));
+    }
+}
+
+static void sim_reader(UartRxPort_t index)
+{
+    SimPort_t *port = &sim_ports[index];
+    uint8_t buffer[256];
+    size_t n;
+
+    while ((n = UartRx_Read(index, buffer, sizeof(buffer), 0)) > 0)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            port->received++;
+            if ((port->mismatch_at == 0) && (buffer[i] != (uint8_t)sim_next(&port->rx_state)))
+            {
+                port->mismatch_at = port->received;
+            }
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    double seconds = 10.0;
+    double period_ms = 10.0;
+    unsigned long baud = 115200;
+    unsigned seed = 1;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "m:t:p:b:s:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'm': burst_mode = (strcmp(optarg, "burst") == 0); break;
+        case 't': seconds = atof(optarg); break;
+        case 'p': period_ms = atof(optarg); break;
+        case 'b': baud = strtoul(optarg, NULL, 0); break;
+        case 's': seed = (unsigned)strtoul(optarg, NULL, 0); break;
+        default:
+            fprintf(stderr, "usage: %s [-m line|burst] [-t s] [-p ms] [-b baud] [-s seed]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    srand(seed);
+    byte_ns = (10ULL * NS_PER_S) / baud;
+
+    huart1.hdmarx = &sim_ports[UART_RX_BT].dma;
+    huart3.hdmarx = &sim_ports[UART_RX_GSM].dma;
+    sim_ports[UART_RX_BT].huart = &huart1;
+    sim_ports[UART_RX_GSM].huart = &huart3;
+
+    if (!UartRx_Init())
+    {
+        fprintf(stderr, "UartRx_Init failed\n");
+        return 1;
+    }
+
+    for (int i = 0; i < UART_RX_PORT_COUNT; i++)
+    {
+        SimPort_t *port = &sim_ports[i];
+
+        port->tx_state = port->rx_state = 0x12345678u + (uint32_t)i;
+        port->idle_at = NEVER;
+        /* Second port half a frame later so the two never line up exactly */
+        sim_schedule_burst(port, (uint64_t)i * byte_ns / 2);
+    }
+
+    uint64_t period_ns = (uint64_t)(period_ms * 1e6);
+    uint64_t end = (uint64_t)(seconds * (double)NS_PER_S);
+    uint64_t reader_at = period_ns;
+
+    for (;;)
+    {
+        uint64_t now = reader_at;
+
+        for (int i = 0; i < UART_RX_PORT_COUNT; i++)
+        {
+            if (sim_ports[i].next_byte < now) now = sim_ports[i].next_byte;
+            if (sim_ports[i].idle_at < now) now = sim_ports[i].idle_at;
+        }
+        if (now >= end)
+        {
+            break;
+        }
+
+        for (int i = 0; i < UART_RX_PORT_COUNT; i++)
+        {
+            SimPort_t *port = &sim_ports[i];
+
+            if (port->idle_at == now)
+            {
+                sim_idle(port);
+            }
+            if (port->next_byte == now)
+            {
+                port->idle_at = NEVER;
+                sim_byte(port, now);
+            }
+        }
+
+        if (reader_at == now)
+        {
+            for (int i = 0; i < UART_RX_PORT_COUNT; i++)
+            {
+                sim_reader((UartRxPort_t)i);
+            }
+            reader_at += period_ns;
+        }
+    }
+
+    /* Final drain so bytes still in flight are not counted as lost */
+    for (int i = 0; i < UART_RX_PORT_COUNT; i++)
+    {
+        sim_idle(&sim_ports[i]);
+        sim_reader((UartRxPort_t)i);
+    }
+
+    printf("%s traffic, %lu baud, reader every %.1f ms, %.1f s, DMA ring %u, stream buffer %u\n",
+           burst_mode ? "burst" : "line rate", baud, period_ms, seconds,
+           (unsigned)UART_RX_DMA_LEN, (unsigned)UART_RX_STREAM_LEN);
+    printf("%-4s %10s %10s %8s %8s %10s %10s %11s %11s  %s\n", "port", "sent", "delivered",
+           "dropped", "events", "bytes/evt", "peak_fill", "B/s", "line B/s", "check");
+
+    int failed = 0;
+
+    for (int i = 0; i < UART_RX_PORT_COUNT; i++)
+    {
+        SimPort_t *port = &sim_ports[i];
+        UartRxStats_t stats;
+        char check[48];
+
+        UartRx_GetStats((UartRxPort_t)i, &stats);
+        if (port->mismatch_at != 0)
+        {
+            snprintf(check, sizeof(check), "mismatch at byte %llu", (unsigned long long)port->mismatch_at);
+            failed = 1;
+        }
+        else if (port->received != port->sent)
+        {
+            snprintf(check, sizeof(check), "%llu bytes missing",
+                     (unsigned long long)(port->sent - port->received));
+            failed = 1;
+        }
+        else
+        {
+            snprintf(check, sizeof(check), "ok");
+        }
+
+        printf("%-4s %10llu %10llu %8lu %8lu %10.1f %5lu/%-4u %11.0f %11.0f  %s\n",
+               UartRx_Name((UartRxPort_t)i), (unsigned long long)port->sent,
+               (unsigned long long)port->received, (unsigned long)stats.dropped,
+               (unsigned long)stats.events,
+               stats.events ? (double)stats.bytes / stats.events : 0.0,
+               (unsigned long)stats.peak_fill, (unsigned)UART_RX_STREAM_LEN,
+               (double)port->received / seconds, (double)baud / 10.0, check);
+    }
+
+    printf("reader may lag up to %.1f ms at line rate before bytes drop\n",
+           (double)UART_RX_STREAM_LEN * 1000.0 / ((double)baud / 10.0));
+
+    return failed;
+}